@@ -1,14 +1,25 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "runtime/cascade.h"
+#include "runtime/cpu_topology.h"
+#include "runtime/result_cache.h"
+#include "runtime/tensor_types.h"
+
 namespace cochl_api {
 namespace runtime {
+class BatchScheduler;
 class RuntimeManager;
-enum class TensorLayout;
+class TensorBinding;
+class ThreadPool;
 }
 }  // namespace cochl_api
 
@@ -21,20 +32,157 @@ enum class TensorLayout;
 namespace external_api {
 class CochlApi {
  public:
+  // completion callback of runInferenceAsync, invoked on the executor thread
+  using InferenceCallback = std::function<void(bool success)>;
+
   // load_model
   static std::unique_ptr<CochlApi> create(const std::string& model_path);
 
+  // load_model on the fastest backend and thread count for this host
+  // sibling exports of the model (model.tflite / model.pt / model.so) are benchmarked too;
+  // the decision is cached per host and model, so only the first call pays for it
+  static std::unique_ptr<CochlApi> createAutoTuned(const std::string& model_path);
+
+  // load a cascade of models, cheapest first: each sample is answered by the first stage whose
+  // top-1 confidence reaches that stage's threshold, the last stage answers the rest;
+  // all stages must share input and output sizes. runInference then runs the cascade,
+  // everything else (shapes, swapModel, ...) addresses the first stage
+  static std::unique_ptr<CochlApi> createCascade(
+      const std::vector<cochl_api::runtime::CascadeStage>& stages,
+      cochl_api::runtime::ConfidenceMode mode = cochl_api::runtime::ConfidenceMode::SOFTMAX);
+
   // Destructor must be declared here and defined in .cpp (for unique_ptr with forward declaration)
   ~CochlApi();
 
   bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                     float* output) const;
 
+  // run batch_size samples in one backend call (sample_shape has a leading 1)
+  bool runBatch(const float* inputs, size_t batch_size, const std::vector<int64_t>& sample_shape,
+                float* outputs) const;
+
+  // queue inference on the instance executor and return immediately
+  // input is copied before returning; output must stay valid until on_done is called
+  // pending requests run in submission order and are drained by the destructor
+  bool runInferenceAsync(const float* input, const std::vector<int64_t>& input_shape,
+                         float* output, InferenceCallback on_done) const;
+
+  // coalesce concurrent single-sample runInference calls into batched backend calls
+  // max_batch_size <= 1 turns batching off; queued requests finish first
+  bool enableBatching(size_t max_batch_size, std::chrono::microseconds max_delay);
+  bool isBatchingEnabled() const;
+
+  // run a model with several inputs and/or outputs (e.g. event logits plus embeddings)
+  // inputs and outputs are in model order, see getInputIndex()/getOutputIndex();
+  // output i must hold N * getOutputSize(i) values for a batch of N
+  bool runMulti(const std::vector<const float*>& inputs,
+                const std::vector<std::vector<int64_t>>& input_shapes,
+                const std::vector<float*>& outputs) const;
+
+  // run on typed data (e.g. uint8 pixels, int16 PCM) so quantized models take it without
+  // an fp32 round trip; data of the model's own type is passed as-is, other types are
+  // converted by value (see getInputDataType()/getOutputDataType())
+  bool runTyped(const std::vector<cochl_api::runtime::InputTensor>& inputs,
+                const std::vector<cochl_api::runtime::OutputTensor>& outputs) const;
+
+  // bind caller-owned buffers once as the model's input and output storage; runBound then
+  // reads their current contents and writes the outputs with no copies at the API boundary
+  // where the backend allows it (model dtypes, images in getPreferredLayout(), buffers
+  // aligned to kTensorAlignment), and with copies otherwise; buffers must outlive the binding
+  bool bindBuffers(const std::vector<cochl_api::runtime::InputTensor>& inputs,
+                   const std::vector<cochl_api::runtime::OutputTensor>& outputs);
+  bool runBound() const;
+  void unbindBuffers();
+  // true if the bound buffers are used in place
+  bool isZeroCopyBound() const;
+
+  // run the cascade on NCHW input; last_stage receives the deepest stage that ran
+  // (0 when the first stage answered every sample); false if this is not a cascade
+  bool runCascade(const float* input, const std::vector<int64_t>& input_shape, float* output,
+                  size_t* last_stage = nullptr) const;
+  // number of stages, 1 for a single model
+  size_t getNumStages() const;
+  // per-stage samples seen, samples answered (hit rate) and time, empty if not a cascade
+  std::vector<cochl_api::runtime::CascadeStageStats> getCascadeStats() const;
+
+  // replace the served model without interrupting inference (sizes must match)
+  // warmup_shape runs one inference on the new model before the swap, empty to skip
+  bool swapModel(const std::string& model_path, const std::vector<int64_t>& warmup_shape);
+
+  // limit the runtime instances serving concurrent calls (0 follows the thread budget)
+  bool setMaxInstances(size_t max_instances);
+
+  // confine this model to a partition of the cpus, so a burst on another model hosted in the
+  // process does not raise its latency (AffinityPolicy::NONE removes the partition);
+  // LibTorch intra-op and TVM workers are process-wide: only calling threads are confined
+  bool setCpuPartition(const cochl_api::runtime::ThreadAffinity& affinity);
+  // confine to share index of count disjoint slices of the cpus (cores and clusters kept whole)
+  bool setCpuShare(size_t index, size_t count);
+  // cpus of the partition, empty if unconfined
+  std::vector<int> getCpuPartition() const;
+
+  // return the stored output when runInference sees an input it has seen before (same shape,
+  // byte-identical data), keeping at most max_bytes of inputs and outputs; 0 turns it off.
+  // Only for deterministic models; emptied by swapModel. Calls coalesced by batching,
+  // inputs in another layout and cascades run the model as usual
+  bool setResultCache(size_t max_bytes);
+  // hits, misses and memory of the result cache, zeros if it is off
+  cochl_api::runtime::ResultCacheStats getResultCacheStats() const;
+
+  // latency of the first and of steady-state inference, measured by the load-time warmup
+  // false if the model was loaded with warmup off
+  bool getWarmupLatency(double& cold_ms, double& warm_ms) const;
+
+  // prepare a new input shape (e.g. a clip of another length) and return the number of
+  // output values runInference writes for it, 0 if the model cannot take that shape
+  size_t prepareShape(const std::vector<int64_t>& input_shape) const;
+
   size_t getInputSize() const;
   size_t getOutputSize() const;
 
+  // model inputs and outputs by index; the first ones are those runInference uses
+  size_t getNumInputs() const;
+  size_t getNumOutputs() const;
+  // index of a named tensor, -1 if the model has none by that name
+  int getInputIndex(const std::string& name) const;
+  int getOutputIndex(const std::string& name) const;
+  std::string getInputName(size_t index) const;
+  std::string getOutputName(size_t index) const;
+  // per-sample shape (leading 1) and size, empty/0 if index is out of range
+  std::vector<int64_t> getInputShape(size_t index) const;
+  size_t getOutputSize(size_t index) const;
+  // element type the model computes with, FLOAT32 if index is out of range
+  cochl_api::runtime::DataType getInputDataType(size_t index) const;
+  cochl_api::runtime::DataType getOutputDataType(size_t index) const;
+
+  // layout the backend computes images in (NHWC for TFLite, NCHW for LibTorch);
+  // preprocessing that writes it directly (utils::LoadAndPreprocessImage) and declares it
+  // with setInputLayout saves a full-tensor transpose per inference
+  cochl_api::runtime::TensorLayout getPreferredLayout() const;
+
+  // layout of the 4D inputs passed to runInference/runBatch/runMulti (NCHW by default);
+  // runTyped takes the layout of each tensor instead
+  void setInputLayout(cochl_api::runtime::TensorLayout layout);
+  cochl_api::runtime::TensorLayout getInputLayout() const;
+
  private:
   CochlApi();
   std::unique_ptr<cochl_api::runtime::RuntimeManager> runtime_manager_;
+
+  // later stages when created with createCascade; runs runtime_manager_ first
+  std::unique_ptr<cochl_api::runtime::ModelCascade> cascade_;
+
+  // set while batching is on; read without locks by concurrent callers
+  std::shared_ptr<cochl_api::runtime::BatchScheduler> batch_scheduler_;
+
+  // set while buffers are bound; replaced or cleared by bindBuffers/unbindBuffers
+  std::shared_ptr<cochl_api::runtime::TensorBinding> binding_;
+
+  std::atomic<cochl_api::runtime::TensorLayout> input_layout_{
+      cochl_api::runtime::TensorLayout::NCHW};
+
+  // created on first async call; declared last so it drains before the runtime is destroyed
+  mutable std::mutex executor_mutex_;
+  mutable std::unique_ptr<cochl_api::runtime::ThreadPool> executor_;
 };
 }  // namespace external_api
\ No newline at end of file
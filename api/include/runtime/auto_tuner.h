@@ -0,0 +1,98 @@
+// On-host selection of backend and thread count.
+// Micro-benchmarks every candidate runtime across thread counts and caches
+// the fastest configuration per host and model in the user cache directory.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "i_runtime.h"
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief What to benchmark
+ */
+struct TuningOptions {
+  std::vector<size_t> thread_counts;  // empty: 1, 2, 4, ... up to the ComputePool thread budget
+  size_t warmup_runs = 2;             // untimed runs before each measurement
+  size_t timed_runs = 5;              // median of these is the latency
+  bool use_cache = true;              // reuse and store the decision in the tuning cache
+};
+
+/**
+ * @brief Fastest configuration found
+ */
+struct TuningResult {
+  size_t candidate = 0;     // index into the candidate list
+  size_t num_threads = 0;   // 0 if the backend does not expose a thread count
+  double latency_ms = 0.0;  // median single-sample latency
+  bool cached = false;      // taken from the tuning cache without benchmarking
+};
+
+/**
+ * @brief Picks the fastest backend and thread count for a model on this host
+ *
+ * Each candidate is one model file together with the runtime that loads it,
+ * e.g. the same network exported as .tflite, .pt and TVM .so. Candidates are
+ * loaded one at a time and released before the next, so tuning never holds
+ * more than one extra copy of the model in memory.
+ */
+class AutoTuner {
+ public:
+  struct Candidate {
+    std::string name;        // backend name, stored in the cache
+    std::string model_path;  // model file for this backend
+    std::function<std::unique_ptr<IRuntime>()> create;
+  };
+
+  explicit AutoTuner(const TuningOptions& options = TuningOptions());
+
+  /**
+   * @brief Benchmark the candidates, or look the decision up in the cache
+   * @param candidates Backends able to run the model, in order of preference on ties
+   * @param result Fastest configuration
+   * @return false if no candidate could be loaded and run
+   */
+  bool tune(const std::vector<Candidate>& candidates, TuningResult& result) const;
+
+  /**
+   * @brief Median latency of one inference on a synthetic input
+   * @param runtime Loaded runtime reporting its input shape
+   * @return Latency in milliseconds, negative if the runtime cannot run
+   */
+  double benchmark(IRuntime& runtime) const;
+
+  /**
+   * @brief Identifies the cpu model and count the decision was measured on
+   */
+  static std::string hostKey();
+
+  /**
+   * @brief Tuning cache file ($XDG_CACHE_HOME or ~/.cache, under cochl/)
+   */
+  static std::string cachePath();
+
+ private:
+  std::vector<size_t> threadCounts() const;
+
+  /**
+   * @brief Cache key: host, plus content hash of every candidate model and its backend
+   */
+  static std::string cacheKey(const std::vector<Candidate>& candidates);
+
+  static bool loadCached(const std::string& key, const std::vector<Candidate>& candidates,
+                         TuningResult& result);
+  static void storeCached(const std::string& key, const std::vector<Candidate>& candidates,
+                          const TuningResult& result);
+
+  TuningOptions options_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,125 @@
+// Dynamic request batching in front of a runtime.
+// Coalesces single-sample requests from concurrent callers into one batched
+// backend call, bounded by a maximum batch size and a maximum queueing delay.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Batching window
+ */
+struct BatchOptions {
+  size_t max_batch_size = 8;                  // dispatch as soon as this many requests wait
+  std::chrono::microseconds max_delay{2000};  // longest time the oldest request may wait
+  size_t max_in_flight = 1;  // batches executing at once (the instances that can run them)
+};
+
+/**
+ * @brief Counters of a BatchScheduler
+ */
+struct BatchStats {
+  uint64_t requests = 0;  // requests completed
+  uint64_t batches = 0;   // backend calls made
+  size_t max_batch = 0;   // largest batch dispatched
+};
+
+/**
+ * @brief Coalesces concurrent single-sample requests into batched backend calls
+ *
+ * Callers block in run() until their batch has been executed and the result
+ * scattered back to their output buffer, so existing synchronous call sites
+ * keep working unchanged. Only requests of the same sample shape share a batch.
+ * One dispatcher at a time collects the next batch while up to max_in_flight
+ * formed batches execute on the others.
+ */
+class BatchScheduler {
+ public:
+  /**
+   * @brief Batched backend call (same contract as IRuntime::runBatch)
+   */
+  using BatchFunction = std::function<bool(const float* inputs, size_t batch_size,
+                                           const std::vector<int64_t>& sample_shape,
+                                           float* outputs)>;
+
+  /**
+   * @param run_batch Backend call, executed on up to max_in_flight dispatcher threads at once
+   * @param output_size Number of output values per sample
+   * @param options Batching window
+   */
+  BatchScheduler(BatchFunction run_batch, size_t output_size, const BatchOptions& options);
+
+  /**
+   * @brief Stops the dispatchers after completing every queued request
+   */
+  ~BatchScheduler();
+
+  /**
+   * @brief Queue one sample and wait for its result
+   * @param input Input data of one sample
+   * @param input_shape Shape with a leading batch dimension of 1
+   * @param output Output buffer of getOutputSize() values
+   * @return true if the batch containing this sample succeeded
+   */
+  bool run(const float* input, const std::vector<int64_t>& input_shape, float* output);
+
+  /**
+   * @brief Change the number of batches executing at once (e.g. after the instance limit changed)
+   */
+  void setMaxInFlight(size_t max_in_flight);
+
+  BatchOptions getOptions() const;
+
+  BatchStats getStats() const;
+
+  BatchScheduler(const BatchScheduler&) = delete;
+  BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+ private:
+  struct Request {
+    const float* input;
+    const std::vector<int64_t>* shape;
+    size_t input_size;
+    float* output;
+    std::chrono::steady_clock::time_point enqueued;
+    std::promise<bool> done;
+  };
+
+  void dispatchLoop();
+
+  /**
+   * @param batch_inputs, batch_outputs Staging buffers of the calling dispatcher
+   */
+  void execute(std::vector<Request*>& batch, std::vector<float>& batch_inputs,
+               std::vector<float>& batch_outputs);
+
+  BatchFunction run_batch_;
+  size_t output_size_;
+  BatchOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<Request*> queue_;
+  BatchStats stats_;
+  bool stop_;
+  bool collecting_;    // a dispatcher holds the batching window open
+  size_t in_flight_;   // batches executing
+
+  // Grows to options_.max_in_flight; the ones above a lowered limit stay idle
+  std::vector<std::thread> dispatchers_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,122 @@
+// Cascade of models of increasing cost over the same input.
+// A cheap model answers the inputs it is confident about; only the rest are
+// escalated to larger models, so the average cost follows input difficulty.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief How the top-1 confidence is read from a model output (values match CochlConfidence)
+ */
+enum class ConfidenceMode {
+  SOFTMAX = 0,     // logits of exclusive classes
+  SIGMOID = 1,     // logits of independent labels (multi-label sound events)
+  PROBABILITY = 2  // outputs already are probabilities
+};
+
+/**
+ * @brief One model of the cascade
+ */
+struct CascadeStage {
+  std::string model_path;
+  float threshold = 0.5f;  // top-1 confidence at which this stage's answer is final
+                           // (the last stage always answers)
+};
+
+/**
+ * @brief Counters of one stage
+ */
+struct CascadeStageStats {
+  uint64_t runs = 0;      // inputs that reached this stage
+  uint64_t answered = 0;  // inputs this stage answered without escalating
+  double total_ms = 0.0;  // time spent running this stage
+
+  double hitRate() const { return runs ? static_cast<double>(answered) / runs : 0.0; }
+  double meanLatencyMs() const { return runs ? total_ms / runs : 0.0; }
+};
+
+/**
+ * @brief Largest class confidence of one sample's output
+ * @param output count values of one sample
+ */
+float topConfidence(const float* output, size_t count, ConfidenceMode mode);
+
+class RuntimeManager;
+
+/**
+ * @brief Models run in order of cost until one is confident about each sample
+ *
+ * Every sample of a batch goes through the first stage; the samples whose
+ * top-1 confidence stays below that stage's threshold are gathered and run
+ * through the next stage, and so on. The last stage answers whatever reaches
+ * it. All stages take the same input and write outputs of the same size, so
+ * the caller cannot tell which stage answered except through the stats.
+ */
+class ModelCascade {
+ public:
+  /**
+   * @param first Manager of the first stage, owned by the caller and outliving the cascade
+   * @param first_threshold Confidence at which the first stage answers
+   * @param next Managers of the later stages, cheapest first
+   * @param next_thresholds Confidence at which each later stage answers
+   */
+  ModelCascade(const RuntimeManager& first, float first_threshold,
+               std::vector<std::unique_ptr<RuntimeManager>> next,
+               const std::vector<float>& next_thresholds, ConfidenceMode mode);
+  ~ModelCascade();
+
+  /**
+   * @brief Load the later stages of a cascade whose first stage is already loaded
+   * @param stages Every stage, the first one included (its model is not loaded again)
+   * @return nullptr if a stage fails to load or its input/output size differs from the first
+   */
+  static std::unique_ptr<ModelCascade> create(const RuntimeManager& first,
+                                              const std::vector<CascadeStage>& stages,
+                                              ConfidenceMode mode);
+
+  /**
+   * @brief Run input through as many stages as its samples need
+   * @param input_shape Shape of the whole input, leading batch dimension N
+   * @param output N * getOutputSize() values of the first stage, each sample overwritten by
+   *               the stage that answered it
+   * @param last_stage Deepest stage that ran, may be null
+   */
+  bool run(const float* input, const std::vector<int64_t>& input_shape, float* output,
+           size_t* last_stage = nullptr) const;
+
+  size_t getNumStages() const { return stages_.size(); }
+
+  /**
+   * @brief Counters of each stage since creation or the last resetStats()
+   */
+  std::vector<CascadeStageStats> getStats() const;
+  void resetStats();
+
+  ModelCascade(const ModelCascade&) = delete;
+  ModelCascade& operator=(const ModelCascade&) = delete;
+
+ private:
+  struct Stage {
+    const RuntimeManager* manager;
+    float threshold;
+  };
+
+  std::vector<Stage> stages_;
+  std::vector<std::unique_ptr<RuntimeManager>> owned_;
+  ConfidenceMode mode_;
+
+  mutable std::mutex stats_mutex_;
+  mutable std::vector<CascadeStageStats> stats_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
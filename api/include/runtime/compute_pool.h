@@ -0,0 +1,111 @@
+// Process-wide compute budget shared by every runtime instance.
+// Owns the single ThreadPool used by the custom backend and sizes the
+// internal pools of TFLite and LibTorch from the same thread budget.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "cpu_topology.h"
+#include "thread_pool.h"
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Process-wide compute pool and thread budget
+ *
+ * Every CochlApi instance shares one ThreadPool instead of creating its own,
+ * so hosting several models in one process does not oversubscribe the cores.
+ * The budget is split evenly across every consumer: the shared pool once it
+ * exists, and each backend-owned pool (a TFLite model, the LibTorch and TVM
+ * worker pools). A budget or affinity change hands every consumer its new
+ * share. When a consumer comes or goes, the others are only told if their
+ * share changes by half or more: backends rebuild their workers on a new share,
+ * and a small correction is not worth that. Shares may then add up to more
+ * than the budget until the next explicit change.
+ */
+class ComputePool {
+ public:
+  /**
+   * @brief Receives a backend pool's share of the budget, on acquisition and when it changes
+   * @note Called with the pool lock held: it must not call back into ComputePool
+   */
+  using ShareListener = std::function<void(size_t num_threads)>;
+
+  /**
+   * @brief Process-wide instance
+   */
+  static ComputePool& instance();
+
+  /**
+   * @brief Shared thread pool, created lazily with the current budget and affinity
+   * @note Callers hold the returned pointer for the duration of a parallel region
+   */
+  std::shared_ptr<ThreadPool> getThreadPool();
+
+  /**
+   * @brief Total number of compute threads allowed in the process
+   */
+  size_t getThreadBudget() const;
+
+  /**
+   * @brief Change the thread budget
+   * @param num_threads Number of threads, 0 to size from the cpus allowed by the affinity
+   * @note The shared pool is resized in place by parking or activating workers, and every
+   *       backend pool is told its new share
+   */
+  void setThreadBudget(size_t num_threads);
+
+  /**
+   * @brief Change worker placement of the shared pool
+   */
+  void setThreadAffinity(const ThreadAffinity& affinity);
+
+  /**
+   * @brief Reserve a share of the budget for a backend-owned pool
+   * @param listener Called with the pool's share now and whenever the shares change
+   * @return Reservation id for releaseBackendThreads()
+   */
+  uint64_t acquireBackendThreads(ShareListener listener);
+
+  /**
+   * @brief Release a reservation made by acquireBackendThreads(); the others grow to fill it
+   */
+  void releaseBackendThreads(uint64_t reservation);
+
+  ComputePool(const ComputePool&) = delete;
+  ComputePool& operator=(const ComputePool&) = delete;
+
+ private:
+  ComputePool();
+
+  size_t defaultBudget() const;
+
+  struct BackendPool {
+    ShareListener listener;
+    size_t share;  // last share handed to the listener
+  };
+
+  /**
+   * @brief Split the budget across the current consumers and hand out the shares
+   *        (caller holds mutex_)
+   * @param budget_changed Hand every backend pool its share, not only those far from it
+   */
+  void rebalanceLocked(bool budget_changed);
+
+  mutable std::mutex mutex_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+  ThreadAffinity affinity_;
+  size_t thread_budget_;
+  std::map<uint64_t, BackendPool> backend_pools_;
+  uint64_t next_reservation_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -3,96 +3,23 @@
 
 #pragma once
 
-#include <condition_variable>
-#include <functional>
-#include <future>
 #include <memory>
-#include <mutex>
-#include <queue>
 #include <string>
-#include <thread>
-#include <utility>
 #include <vector>
 
+#include "compute_pool.h"
 #include "i_runtime.h"
 
 namespace cochl_api {
 namespace runtime {
 
-/**
- * @brief Thread pool for parallel task execution
- * TODO: job queue in worker, reserve thread_max_num
- */
-class ThreadPool {
- public:
-  explicit ThreadPool(size_t num_threads);
-  ~ThreadPool();
-
-  template <typename F, typename... Args>
-  auto Submit(F&& f, Args&&... args)
-      -> std::future<typename std::result_of<F(Args...)>::type> {
-    using return_type = typename std::result_of<F(Args...)>::type;
-
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-
-    std::future<return_type> res = task->get_future();
-    {
-      std::unique_lock<std::mutex> lock(queue_mutex_);
-      if (stop_) throw std::runtime_error("Submit on stopped ThreadPool");
-
-      tasks_.emplace([task]() { (*task)(); });
-    }
-    condition_.notify_one();
-    return res;
-  }
-
-  // ParallelFor: Distribute work across threads
-  // Callback will be called for each range: callback(start_idx, end_idx)
-  template <typename F>
-  void ParallelFor(size_t start, size_t end, F&& callback) {
-    if (start >= end) return;
-
-    size_t total_work = end - start;
-    size_t num_threads = workers_.size();
-    size_t chunk_size = (total_work + num_threads - 1) / num_threads;
-
-    std::vector<std::future<void>> futures;
-
-    for (size_t t = 0; t < num_threads; ++t) {
-      size_t chunk_start = start + t * chunk_size;
-      size_t chunk_end = std::min(chunk_start + chunk_size, end);
-
-      if (chunk_start >= end) break;
-
-      auto future = Submit([callback, chunk_start, chunk_end]() {
-        callback(chunk_start, chunk_end);
-    });
-
-      futures.push_back(std::move(future));
-    }
-
-    // Wait for all tasks to complete
-    for (auto& future : futures) { future.get(); }
-  }
-
-  ThreadPool(const ThreadPool&) = delete;
-  ThreadPool& operator=(const ThreadPool&) = delete;
-
- private:
-  std::vector<std::thread> workers_;
-  std::queue<std::function<void()>> tasks_;
-
-  std::mutex queue_mutex_;
-  std::condition_variable condition_;
-  bool stop_;
-};
-
 /**
  * @brief Custom runtime backend with thread pool
  *
  * Mock implementation for testing parallel inference execution.
  * Compatible with ResNet50 input/output dimensions.
+ * Runs on the process-wide ComputePool instead of owning a pool, unless
+ * confined to a cpu partition.
  */
 class CustomRuntime : public IRuntime {
  public:
@@ -102,22 +29,47 @@ class CustomRuntime : public IRuntime {
   bool loadModel(const char* model_path) override;
   bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                     float* output) override;
+  bool runBatch(const float* inputs, size_t batch_size,
+                const std::vector<int64_t>& sample_shape, float* outputs) override;
+  std::unique_ptr<IRuntime> clone() const override;
   size_t getInputSize() const override;
   size_t getOutputSize() const override;
+  std::vector<int64_t> getInputShape() const override;
+  size_t prepareShape(const std::vector<int64_t>& input_shape) override;
   const char* getRuntimeType() const override;
 
   /**
-   * @brief Set number of threads for thread pool
-   * @param num_threads Number of threads to use
+   * @brief Limit the workers this instance's parallel loops run on
+   * @param num_threads Most workers of its pool to use, 0 for all of them
+   * @note The pool itself (and the ComputePool budget) is unchanged; clones inherit the limit
    */
-  void setNumThreads(size_t num_threads);
+  bool setNumThreads(size_t num_threads) override;
+
+  /**
+   * @brief Set worker placement for thread pool
+   * @param affinity Placement policy (performance cores, physical cores or explicit cpus)
+   * @note Applies to the process-wide ComputePool
+   */
+  void setThreadAffinity(const ThreadAffinity& affinity);
+
+  /**
+   * @brief Run on a pool of one worker per cpu, pinned to cpus, instead of the ComputePool
+   * @note The pool is shared with clones made afterwards
+   */
+  bool setCpuSet(const std::vector<int>& cpus) override;
 
  private:
-  std::unique_ptr<ThreadPool> thread_pool_;
+  /**
+   * @brief Partition pool if one is set, the shared ComputePool pool otherwise
+   */
+  std::shared_ptr<ThreadPool> threadPool() const;
+
+  std::shared_ptr<ThreadPool> partition_pool_;
+  size_t num_threads_;  // ParallelOptions::max_threads of every loop
   std::string model_path_;
   size_t input_size_;
   size_t output_size_;
-  size_t num_threads_;
+  bool initialized_;
 };
 
 }  // namespace runtime
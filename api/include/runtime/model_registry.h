@@ -0,0 +1,82 @@
+// Process-wide registry of loaded models.
+// Repeated loads of the same file with the same settings share one
+// RuntimeInstancePool (and with it the weights, flatbuffer or compiled module)
+// instead of loading it again.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "instance_pool.h"
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Refcounted cache of loaded models keyed by canonical path, content hash and load settings
+ *
+ * Entries hold weak references: a model is unloaded when the last handle
+ * using it goes away. Keying on the file content means a model rewritten in
+ * place is loaded fresh, while symlinks and relative paths to the same file
+ * share one entry.
+ */
+class ModelRegistry {
+ public:
+  using Loader = std::function<std::shared_ptr<RuntimeInstancePool>()>;
+
+  /**
+   * @brief Process-wide instance
+   */
+  static ModelRegistry& instance();
+
+  /**
+   * @brief Return the loaded model for model_path, running loader only if it is not loaded yet
+   * @param model_path Path to model file
+   * @param settings Load settings the pool depends on (backend, thread count); a load with
+   *        other settings gets its own pool instead of sharing one configured differently
+   * @param loader Loads the model; called at most once per key even under concurrent requests
+   * @param key Receives the registry key of the model (file key and settings), may be nullptr
+   * @return Shared instance pool, nullptr if the file cannot be read or loader failed
+   */
+  std::shared_ptr<RuntimeInstancePool> acquire(const std::string& model_path,
+                                               const std::string& settings, const Loader& loader,
+                                               std::string* key = nullptr);
+
+  /**
+   * @brief Number of models currently loaded
+   */
+  size_t getNumModels() const;
+
+  /**
+   * @brief Registry key of a model file: canonical path and content hash
+   * @return Empty string if the file cannot be resolved or read
+   */
+  static std::string makeKey(const std::string& model_path);
+
+  ModelRegistry(const ModelRegistry&) = delete;
+  ModelRegistry& operator=(const ModelRegistry&) = delete;
+
+ private:
+  ModelRegistry() = default;
+
+  struct Entry {
+    std::weak_ptr<RuntimeInstancePool> pool;
+    // Valid while the first caller is loading; later callers wait on it
+    std::shared_future<std::shared_ptr<RuntimeInstancePool>> loading;
+  };
+
+  void pruneLocked();
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Entry> entries_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,138 @@
+// Process-wide memory budget for loaded models.
+// Devices that host many models but use a few at a time keep only the
+// recently used ones loaded; the others are released and reloaded from their
+// file when they are called again.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Memory accounting of the models loaded in the process
+ */
+struct ResidencyStats {
+  size_t budget_bytes = 0;    // 0 if unlimited
+  size_t resident_bytes = 0;  // loaded models, each counted once however many managers share it
+  size_t resident_models = 0;
+  size_t evicted_models = 0;  // released, reloaded on their next call
+  uint64_t evictions = 0;
+  uint64_t reloads = 0;
+};
+
+/**
+ * @brief Least-recently-used eviction of loaded models above a memory budget
+ *
+ * Every RuntimeManager holds a Ticket for the model it serves. Tickets of the
+ * same model (same ModelRegistry key) share its memory, and are evicted
+ * together since the model is only unloaded once none of them holds it. A
+ * model's size is its file size, which the weights dominate. With no budget
+ * set nothing is evicted; only the accounting runs.
+ */
+class ModelResidency {
+ public:
+  /**
+   * @brief Releases a manager's model; called with the residency lock held, so it must not
+   *        call back into ModelResidency
+   */
+  using Evictor = std::function<void()>;
+
+  /**
+   * @brief Registration of one manager's model, removed on destruction
+   */
+  class Ticket {
+   public:
+    ~Ticket();
+
+    /**
+     * @brief Mark the model used now (lock-free, once per call)
+     */
+    void touch();
+
+    const std::string& getKey() const { return key_; }
+
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+
+   private:
+    friend class ModelResidency;
+    Ticket(ModelResidency& owner, std::string key, size_t bytes, Evictor evict);
+
+    ModelResidency& owner_;
+    std::string key_;
+    size_t bytes_;
+    Evictor evict_;
+    std::atomic<uint64_t> last_used_;
+    bool resident_;  // guarded by the owner's mutex
+  };
+
+  /**
+   * @brief Process-wide instance
+   */
+  static ModelResidency& instance();
+
+  /**
+   * @brief Set the memory budget of all loaded models
+   * @param max_bytes Budget, 0 for unlimited; models over a lower budget are evicted now
+   */
+  void setBudget(size_t max_bytes);
+  size_t getBudget() const;
+
+  /**
+   * @brief Register a loaded model, evicting least recently used others to make room
+   * @param key ModelRegistry key of the model
+   * @param bytes Memory the model takes (see modelBytes())
+   * @param evict Releases this manager's model
+   */
+  std::unique_ptr<Ticket> admit(const std::string& key, size_t bytes, Evictor evict);
+
+  /**
+   * @brief Mark an evicted model loaded again, evicting others to make room
+   */
+  void readmit(Ticket& ticket);
+
+  ResidencyStats getStats() const;
+
+  /**
+   * @brief Memory accounted for a model file: its size, 0 if it cannot be read
+   */
+  static size_t modelBytes(const std::string& model_path);
+
+  ModelResidency(const ModelResidency&) = delete;
+  ModelResidency& operator=(const ModelResidency&) = delete;
+
+ private:
+  ModelResidency();
+
+  /**
+   * @brief Evict least recently used models until the budget holds (caller holds mutex_)
+   * @param keep Key of the model being admitted, never evicted
+   */
+  void enforceLocked(const std::string& keep);
+
+  /**
+   * @brief Memory of the resident models (caller holds mutex_)
+   */
+  size_t residentBytesLocked() const;
+
+  void remove(Ticket* ticket);
+
+  mutable std::mutex mutex_;
+  std::vector<Ticket*> tickets_;
+  size_t budget_;
+  uint64_t evictions_;
+  uint64_t reloads_;
+  std::atomic<uint64_t> clock_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,104 @@
+// Shape-keyed cache of prepared execution plans.
+// Backends keep one plan (resized interpreter, preallocated tensors, known
+// output size) per input shape, so alternating between shapes seen before
+// costs a lookup instead of a reallocation.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Cache key of a set of input shapes
+ * @note A single input is keyed by its shape; several are concatenated, each prefixed by
+ *       its negated rank so that no two sets share a key
+ */
+inline std::vector<int64_t> makePlanKey(const std::vector<std::vector<int64_t>>& input_shapes) {
+  if (input_shapes.size() == 1) {
+    return input_shapes[0];
+  }
+
+  std::vector<int64_t> key;
+  for (const auto& shape : input_shapes) {
+    key.push_back(-static_cast<int64_t>(shape.size()));
+    key.insert(key.end(), shape.begin(), shape.end());
+  }
+  return key;
+}
+
+/**
+ * @brief Bounded LRU map from input shape to a backend-specific plan
+ *
+ * Not synchronized: each runtime instance owns its cache and is used by one
+ * caller at a time (see RuntimeInstancePool).
+ */
+template <typename Plan>
+class PlanCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 4;
+
+  explicit PlanCache(size_t capacity = kDefaultCapacity)
+      : capacity_(capacity > 0 ? capacity : 1), tick_(0), hits_(0), misses_(0) {}
+
+  /**
+   * @brief Plan prepared for shape, nullptr if there is none
+   */
+  Plan* find(const std::vector<int64_t>& shape) {
+    auto it = plans_.find(shape);
+    if (it == plans_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    ++hits_;
+    it->second.last_used = ++tick_;
+    return &it->second.plan;
+  }
+
+  /**
+   * @brief Store the plan for shape, evicting the least recently used one if full
+   * @return The stored plan (valid until it is evicted or the cache is cleared)
+   */
+  Plan& insert(const std::vector<int64_t>& shape, Plan plan) {
+    auto it = plans_.find(shape);
+    if (it == plans_.end() && plans_.size() >= capacity_) {
+      auto oldest = plans_.begin();
+      for (auto entry = plans_.begin(); entry != plans_.end(); ++entry) {
+        if (entry->second.last_used < oldest->second.last_used) oldest = entry;
+      }
+      plans_.erase(oldest);
+    }
+
+    Entry& entry = plans_[shape];
+    entry.plan = std::move(plan);
+    entry.last_used = ++tick_;
+    return entry.plan;
+  }
+
+  void clear() { plans_.clear(); }
+
+  size_t size() const { return plans_.size(); }
+  size_t capacity() const { return capacity_; }
+  uint64_t getHits() const { return hits_; }
+  uint64_t getMisses() const { return misses_; }
+
+ private:
+  struct Entry {
+    Plan plan;
+    uint64_t last_used = 0;
+  };
+
+  std::map<std::vector<int64_t>, Entry> plans_;
+  size_t capacity_;
+  uint64_t tick_;
+  uint64_t hits_;
+  uint64_t misses_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
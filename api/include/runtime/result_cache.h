@@ -0,0 +1,100 @@
+// Content-addressed cache of inference results.
+// Fixed cameras and silent audio feed the model byte-identical inputs over and
+// over; a hit returns the stored output instead of running the model again.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Counters of a ResultCache
+ */
+struct ResultCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;  // entries dropped to stay within the byte budget
+  size_t entries = 0;
+  size_t bytes = 0;        // input and output bytes held now
+  size_t max_bytes = 0;
+
+  double hitRate() const {
+    return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0;
+  }
+};
+
+/**
+ * @brief Bounded LRU map from input content to the output the model produced for it
+ *
+ * Entries are keyed by utils::Hash64 of the shape and the input bytes, and keep
+ * a copy of the input so that a hash collision is a miss rather than a wrong
+ * answer. Synchronized: concurrent callers share one cache.
+ */
+class ResultCache {
+ public:
+  /**
+   * @param max_bytes Budget for the inputs and outputs held; larger results are not cached
+   */
+  explicit ResultCache(size_t max_bytes);
+
+  /**
+   * @brief Copy the output stored for this input into output
+   * @param epoch Receives the epoch to pass to insert() on a miss
+   * @return true on a hit
+   */
+  bool find(const float* input, const std::vector<int64_t>& input_shape, float* output,
+            uint64_t& epoch);
+
+  /**
+   * @brief Store the output computed for this input
+   * @param epoch Value find() returned; results computed before the last clear() are dropped
+   */
+  void insert(const float* input, const std::vector<int64_t>& input_shape, const float* output,
+              size_t output_size, uint64_t epoch);
+
+  /**
+   * @brief Drop every entry, e.g. because the model changed
+   */
+  void clear();
+
+  ResultCacheStats getStats() const;
+
+  ResultCache(const ResultCache&) = delete;
+  ResultCache& operator=(const ResultCache&) = delete;
+
+ private:
+  struct Entry {
+    uint64_t key;
+    std::vector<int64_t> shape;
+    std::vector<float> input;
+    std::vector<float> output;
+
+    size_t bytes() const { return (input.size() + output.size()) * sizeof(float); }
+  };
+
+  static uint64_t makeKey(const float* input, size_t input_size,
+                          const std::vector<int64_t>& input_shape);
+
+  // Entry matching key and content, end() if none; requires mutex_
+  std::list<Entry>::iterator lookup(uint64_t key, const float* input, size_t input_size,
+                                    const std::vector<int64_t>& input_shape);
+
+  void erase(std::list<Entry>::iterator entry);
+
+  size_t max_bytes_;
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;  // most recently used first
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  uint64_t epoch_;
+  ResultCacheStats stats_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,55 @@
+// Backend plugins: each heavy runtime (TFLite, LibTorch, TVM) can be built as
+// its own shared library and is only dlopen'ed when a model needs it.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "i_runtime.h"
+
+/**
+ * @brief Bumped whenever IRuntime changes layout; plugins built against another version are rejected
+ */
+#define COCHL_RUNTIME_PLUGIN_ABI_VERSION 7
+
+/**
+ * @brief Export the plugin entry points for a backend class (one per plugin library)
+ */
+#define COCHL_DEFINE_RUNTIME_PLUGIN(RuntimeClass)                                         \
+  extern "C" __attribute__((visibility("default"))) int CochlRuntime_AbiVersion() {      \
+    return COCHL_RUNTIME_PLUGIN_ABI_VERSION;                                             \
+  }                                                                                      \
+  extern "C" __attribute__((visibility("default"))) cochl_api::runtime::IRuntime*       \
+  CochlRuntime_Create() {                                                                \
+    return new RuntimeClass();                                                           \
+  }
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Loader of backend plugin libraries (libcochl_runtime_<name>.so)
+ *
+ * Search order: $COCHL_RUNTIME_PLUGIN_PATH, the directory of libcochl_api.so and
+ * its runtime/ subdirectory, then the default dynamic loader path. A plugin is
+ * opened once per process and never closed: backends keep threads and static
+ * state alive that must not be unmapped.
+ */
+class RuntimePlugin {
+ public:
+  /**
+   * @brief Instantiate a backend from its plugin, loading the library on first use
+   * @param name Plugin name (e.g., "tflite", "torch", "tvm")
+   * @return New runtime, nullptr if the plugin is missing or incompatible
+   */
+  static std::unique_ptr<IRuntime> createRuntime(const std::string& name);
+
+  /**
+   * @brief true if the plugin library has already been loaded in this process
+   */
+  static bool isLoaded(const std::string& name);
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
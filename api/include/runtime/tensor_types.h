@@ -0,0 +1,112 @@
+// Element types and layouts of model inputs and outputs.
+// Lets callers hand quantized models their native data (e.g. uint8 pixels,
+// int16 PCM) instead of expanding everything to fp32 on the host, and write
+// images in the layout the backend computes in instead of transposing twice.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Tensor element type (values match CochlDataType in the C API)
+ */
+enum class DataType {
+  FLOAT32 = 0,
+  FLOAT16 = 1,
+  INT8 = 2,
+  UINT8 = 3,
+  INT16 = 4
+};
+
+/**
+ * @brief Alignment of caller buffers bound as model storage (see IRuntime::bindBuffers())
+ * @note Matches the TFLite arena and DLPack/TVM tensor alignment
+ */
+constexpr size_t kTensorAlignment = 64;
+
+/**
+ * @brief Memory order of 4D image tensors (values match CochlTensorLayout in the C API)
+ */
+enum class TensorLayout {
+  NCHW = 0,  // channel planes (PyTorch, the API default)
+  NHWC = 1   // interleaved channels (TFLite, image decoders)
+};
+
+/**
+ * @brief Typed input of runTyped(): caller-owned data with its own element type
+ */
+struct InputTensor {
+  const void* data = nullptr;
+  DataType dtype = DataType::FLOAT32;
+  std::vector<int64_t> shape;                 // in layout order for 4D inputs
+  TensorLayout layout = TensorLayout::NCHW;  // ignored for other ranks
+};
+
+/**
+ * @brief Typed output of runTyped(): caller-owned buffer and the element type to write
+ */
+struct OutputTensor {
+  void* data = nullptr;
+  DataType dtype = DataType::FLOAT32;
+};
+
+/**
+ * @brief Bytes per element
+ */
+size_t dataTypeSize(DataType dtype);
+
+/**
+ * @brief Lowercase type name for logs ("float32", "uint8", ...)
+ */
+const char* dataTypeName(DataType dtype);
+
+/**
+ * @brief Lowercase layout name for logs ("nchw", "nhwc")
+ */
+const char* tensorLayoutName(TensorLayout layout);
+
+/**
+ * @brief Shape of a 4D tensor in the other layout ({N, C, H, W} <-> {N, H, W, C})
+ * @note Other ranks are returned unchanged
+ */
+std::vector<int64_t> convertShape(const std::vector<int64_t>& shape, TensorLayout from,
+                                  TensorLayout to);
+
+/**
+ * @brief Transpose a 4D tensor between layouts
+ * @param shape Shape of src in layout from
+ * @param element_size Bytes per element (1, 2 or 4)
+ * @note src and dst must not overlap; other ranks and from == to are plain copies
+ */
+void convertLayout(const void* src, void* dst, size_t element_size,
+                   const std::vector<int64_t>& shape, TensorLayout from, TensorLayout to);
+
+/**
+ * @brief IEEE 754 half precision conversions (round to nearest even)
+ */
+float halfToFloat(uint16_t half);
+uint16_t floatToHalf(float value);
+
+/**
+ * @brief Convert count elements to float
+ * @param scale Quantization scale of src, 0 for plain values
+ * @param zero_point Quantization zero point of src (used when scale > 0)
+ */
+void convertToFloat(const void* src, DataType dtype, size_t count, float* dst,
+                    float scale = 0.0f, int32_t zero_point = 0);
+
+/**
+ * @brief Convert count floats to dtype, rounding and saturating integer types
+ * @param scale Quantization scale of dst, 0 for plain values
+ * @param zero_point Quantization zero point of dst (used when scale > 0)
+ */
+void convertFromFloat(const float* src, size_t count, DataType dtype, void* dst,
+                      float scale = 0.0f, int32_t zero_point = 0);
+
+}  // namespace runtime
+}  // namespace cochl_api
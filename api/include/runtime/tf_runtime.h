@@ -2,9 +2,13 @@
 #define TF_RUNTIME_H
 
 #include "i_runtime.h"
+#include "plan_cache.h"
 
 #ifdef USE_TFLITE
+#include <atomic>
+#include <future>
 #include <memory>
+#include <set>
 #include <vector>
 
 // TensorFlow Lite includes
@@ -25,18 +29,148 @@ public:
   bool loadModel(const char* model_path) override;
   bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                     float* output) override;
+  bool runBatch(const float* inputs, size_t batch_size,
+                const std::vector<int64_t>& sample_shape, float* outputs) override;
+  bool runMulti(const std::vector<const float*>& inputs,
+                const std::vector<std::vector<int64_t>>& input_shapes,
+                const std::vector<float*>& outputs) override;
+
+  /**
+   * @brief Write typed inputs straight into the interpreter tensors (e.g. uint8 into a
+   *        quantized model) and read outputs in their native or a converted type
+   */
+  bool runTyped(const std::vector<InputTensor>& inputs,
+                const std::vector<OutputTensor>& outputs) override;
+
+  /**
+   * @brief Hand the buffers to a dedicated interpreter as TFLite custom allocations, so
+   *        runBound() reads inputs and writes outputs in place
+   * @note Requires the model's dtypes and NHWC images
+   */
+  bool bindBuffers(const std::vector<InputTensor>& inputs,
+                   const std::vector<OutputTensor>& outputs) override;
+  bool runBound() override;
+  void unbindBuffers() override;
+  std::unique_ptr<IRuntime> clone() const override;
   const char* getRuntimeType() const override { return "TensorFlow Lite"; }
   size_t getInputSize() const override;
   size_t getOutputSize() const override;
+  std::vector<int64_t> getInputShape() const override;
+  TensorLayout getInputLayout() const override { return TensorLayout::NHWC; }
+  std::vector<TensorInfo> getInputInfo() const override { return input_info_; }
+  std::vector<TensorInfo> getOutputInfo() const override { return output_info_; }
+
+  /**
+   * @brief Resize the interpreter to input_shape, allowing its outputs to differ from
+   *        N * getOutputSize()
+   */
+  size_t prepareShape(const std::vector<int64_t>& input_shape) override;
+
+  /**
+   * @brief Rebuild the interpreter with a fixed thread count (0 returns to the budget share)
+   */
+  bool setNumThreads(size_t num_threads) override;
+
+  /**
+   * @brief Size the interpreter to cpus (empty returns to the budget share)
+   * @note Interpreter workers inherit the affinity of the thread that creates them; callers
+   *       rebuild and run it confined to cpus (see RuntimeManager::setCpuPartition())
+   */
+  bool setCpuSet(const std::vector<int>& cpus) override;
 
 private:
-  std::unique_ptr<tflite::FlatBufferModel> model_;
-  std::unique_ptr<tflite::Interpreter> interpreter_;
+  // Read-only after load, shared by every interpreter cloned from this runtime
+  std::shared_ptr<const tflite::FlatBufferModel> model_;
   bool initialized_;
 
-  // Cached shape information
+  // The instance's one interpreter, resized in place when the input shapes change; a
+  // separate interpreter per shape would hold a tensor arena (and XNNPACK packed weights) each
+  std::unique_ptr<tflite::Interpreter> interpreter_;
+  std::vector<int64_t> interpreter_key_;  // makePlanKey() of the shapes it is allocated for
+
+  // Keys of the shapes passed to prepareShape(); other shapes must produce
+  // N * getOutputInfo()[i].size values per output, which is what callers size buffers for
+  std::set<std::vector<int64_t>> prepared_shapes_;
+
+  // Interpreter whose tensors live in the buffers of bindBuffers(), null if none are bound
+  std::unique_ptr<tflite::Interpreter> bound_interpreter_;
+
+  /**
+   * @brief The model's share of the ComputePool budget, reserved by the loaded runtime and
+   *        shared by its clones: more instances of a model do not move every other share
+   */
+  struct ThreadShare {
+    ThreadShare();
+    ~ThreadShare();
+
+    uint64_t reservation;
+    std::atomic<size_t> threads;  // latest share
+  };
+
+  // Interpreter threads; a share of the process-wide ComputePool budget unless set explicitly
+  size_t num_threads_;
+  std::shared_ptr<ThreadShare> share_;  // null if num_threads_ is explicit
+
+  // Interpreter being built for a new share, swapped in by the first call after it is ready
+  std::future<std::unique_ptr<tflite::Interpreter>> rebuilt_;
+  size_t rebuilt_threads_;
+
+  // Shapes the model was exported with, in the caller's layout (NCHW for 4D inputs)
+  std::vector<std::vector<int64_t>> native_shapes_;
+
+  // Names and per-sample shapes of every input (NCHW for 4D) and output (as written, NHWC for 4D)
+  std::vector<TensorInfo> input_info_;
+  std::vector<TensorInfo> output_info_;
+
+  // Cached shape information of the first input and output (per sample, native shape)
   size_t input_size_;
   size_t output_size_;
+
+  // Conversion buffers for data not in the model's own type, reused across calls
+  std::vector<float> scratch_values_;
+  std::vector<uint8_t> scratch_bytes_;
+
+  /**
+   * @brief Reserve threads if needed and build the interpreter for the native shape; the
+   *        first build also reads the model's inputs and outputs
+   */
+  bool initInterpreter();
+
+  /**
+   * @brief Read the shapes, names and sizes of the inputs and outputs from interpreter_
+   */
+  bool readTensorInfo();
+
+  /**
+   * @brief Follow a new ComputePool share: start building an interpreter for it in the
+   *        background, and swap it in once built; calls keep the current one meanwhile
+   */
+  void applyThreadShare();
+
+  /**
+   * @brief Build an interpreter over model_ with num_threads threads
+   */
+  std::unique_ptr<tflite::Interpreter> buildInterpreter(size_t num_threads) const;
+
+  /**
+   * @brief Resize and allocate interpreter_ for input_shapes unless it already is
+   * @return false if the model cannot take these shapes (interpreter_ returns to the
+   *         exported shapes)
+   */
+  bool resizeInterpreter(const std::vector<std::vector<int64_t>>& input_shapes);
+
+  /**
+   * @brief Resize the inputs of interpreter to input_shapes (NCHW for 4D inputs) and
+   *        allocate its tensors
+   */
+  bool resizeInputs(tflite::Interpreter& interpreter,
+                    const std::vector<std::vector<int64_t>>& input_shapes) const;
+
+  /**
+   * @brief Shared path of runInference/runBatch/runTyped: NCHW inputs (4D) or as-is (other ranks)
+   * @param outputs Buffers for the first outputs.size() model outputs
+   */
+  bool invoke(const std::vector<InputTensor>& inputs, const std::vector<OutputTensor>& outputs);
 };
 
 }  // namespace runtime
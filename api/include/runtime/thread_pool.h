@@ -0,0 +1,364 @@
+// Thread pool for parallel task execution.
+// Shared by the custom backend and the process-wide compute pool.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cpu_topology.h"
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Iteration scheduling for ThreadPool::ParallelFor
+ */
+enum class Schedule {
+  STATIC,   // one equal chunk per worker
+  DYNAMIC,  // workers claim fixed grain-sized chunks on demand
+  GUIDED    // workers claim shrinking chunks (remaining / 2*threads), never below grain
+};
+
+/**
+ * @brief Task priority class
+ *
+ * Workers always drain HIGH before NORMAL before BACKGROUND. BACKGROUND work
+ * never occupies the last free worker, so a live request always finds one.
+ * The exception is a pool of a single active worker: capping background work
+ * at zero workers would never run it (and deadlock callers waiting on it), so
+ * there it may take the worker. A request submitted meanwhile waits for the
+ * running background task only, which should check ShouldYield() between
+ * chunks to keep that wait short.
+ */
+enum class TaskPriority {
+  HIGH = 0,        // latency-critical inference
+  NORMAL = 1,      // default
+  BACKGROUND = 2   // prepacking, warmup, calibration
+};
+
+/**
+ * @brief ParallelFor options
+ */
+struct ParallelOptions {
+  Schedule schedule = Schedule::STATIC;
+  size_t grain_size = 1;  // minimum iterations per chunk
+  TaskPriority priority = TaskPriority::NORMAL;
+  size_t max_threads = 0;  // most workers (caller included) the loop runs on, 0 for all active
+};
+
+/**
+ * @brief Thread pool for parallel task execution
+ *
+ * Can be resized in place: shrinking parks surplus workers after their
+ * current task, growing wakes parked workers before spawning new ones.
+ * Tasks are queued per TaskPriority lane.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param num_threads Number of worker threads
+   * @param affinity Worker placement; workers are pinned round-robin to the resolved cpus
+   */
+  explicit ThreadPool(size_t num_threads,
+                      const ThreadAffinity& affinity = getDefaultThreadAffinity());
+  ~ThreadPool();
+
+  template <typename F, typename... Args>
+  auto Submit(F&& f, Args&&... args)
+      -> std::future<typename std::result_of<F(Args...)>::type> {
+    return Submit(TaskPriority::NORMAL, std::forward<F>(f), std::forward<Args>(args)...);
+  }
+
+  template <typename F, typename... Args>
+  auto Submit(TaskPriority priority, F&& f, Args&&... args)
+      -> std::future<typename std::result_of<F(Args...)>::type> {
+    using return_type = typename std::result_of<F(Args...)>::type;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+
+    std::future<return_type> res = task->get_future();
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      if (stop_) throw std::runtime_error("Submit on stopped ThreadPool");
+
+      size_t lane = static_cast<size_t>(priority);
+      tasks_[lane].emplace([task]() { (*task)(); });
+      pending_[lane].fetch_add(1, std::memory_order_relaxed);
+    }
+    condition_.notify_one();
+    return res;
+  }
+
+  /**
+   * @brief Check at a task boundary whether work of a higher priority is waiting
+   * @param priority Priority of the running task
+   * @return true if the caller should finish its current chunk and give the worker up
+   */
+  bool ShouldYield(TaskPriority priority) const {
+    size_t lane = static_cast<size_t>(priority);
+    for (size_t higher = 0; higher < lane; ++higher) {
+      if (pending_[higher].load(std::memory_order_relaxed) > 0) return true;
+    }
+    return false;
+  }
+
+  // ParallelFor: Distribute work across threads
+  // Callback will be called for each range: callback(start_idx, end_idx)
+  template <typename F>
+  void ParallelFor(size_t start, size_t end, F&& callback) {
+    ParallelFor(start, end, ParallelOptions(), std::forward<F>(callback));
+  }
+
+  // ParallelFor with explicit scheduling. DYNAMIC/GUIDED chunks are claimed on
+  // demand from a shared cursor, and the calling thread works alongside the pool,
+  // so a slow or preempted worker only delays the chunk it is holding.
+  template <typename F>
+  void ParallelFor(size_t start, size_t end, const ParallelOptions& options, F&& callback) {
+    if (start >= end) return;
+
+    size_t total_work = end - start;
+    size_t num_threads = GetNumThreads();
+    if (options.max_threads > 0) {
+      num_threads = std::min(num_threads, options.max_threads);
+    }
+    size_t grain_size = std::max<size_t>(1, options.grain_size);
+
+    if (options.schedule == Schedule::STATIC) {
+      size_t chunk_size = std::max(grain_size, (total_work + num_threads - 1) / num_threads);
+
+      std::vector<std::future<void>> futures;
+
+      for (size_t chunk_start = start; chunk_start < end; chunk_start += chunk_size) {
+        size_t chunk_end = std::min(chunk_start + chunk_size, end);
+
+        auto future = Submit(options.priority, [&callback, chunk_start, chunk_end]() {
+          callback(chunk_start, chunk_end);
+        });
+
+        futures.push_back(std::move(future));
+      }
+
+      // Wait for all tasks to complete
+      for (auto& future : futures) { future.get(); }
+      return;
+    }
+
+    auto loop = std::make_shared<ParallelLoop<typename std::decay<F>::type>>();
+    loop->pool = this;
+    loop->body = &callback;
+    loop->next = start;
+    loop->end = end;
+    loop->grain_size = grain_size;
+    loop->num_threads = num_threads;
+    loop->schedule = options.schedule;
+    loop->priority = options.priority;
+
+    // Helpers beyond the number of chunks would only find an exhausted range
+    size_t num_chunks = (total_work + grain_size - 1) / grain_size;
+    size_t num_helpers = std::min(num_threads, num_chunks) - 1;
+    for (size_t t = 0; t < num_helpers; ++t) {
+      Submit(options.priority, [loop]() { loop->Run(true); });
+    }
+
+    // The caller is not a pool worker, so it never yields
+    loop->Run(false);
+
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->done.wait(lock, [&loop]() { return loop->running.load() == 0; });
+    if (loop->error) std::rethrow_exception(loop->error);
+  }
+
+  // ParallelFor2D: tile a rows x cols iteration space (e.g., output rows x channels)
+  // Callback is called per tile: callback(row_begin, row_end, col_begin, col_end)
+  template <typename F>
+  void ParallelFor2D(size_t rows, size_t cols, size_t tile_rows, size_t tile_cols,
+                     F&& callback) {
+    ParallelFor2D(rows, cols, tile_rows, tile_cols, ParallelOptions{Schedule::DYNAMIC, 1},
+                  std::forward<F>(callback));
+  }
+
+  // ParallelFor2D with explicit scheduling over tiles
+  template <typename F>
+  void ParallelFor2D(size_t rows, size_t cols, size_t tile_rows, size_t tile_cols,
+                     const ParallelOptions& options, F&& callback) {
+    tile_rows = std::max<size_t>(1, tile_rows);
+    tile_cols = std::max<size_t>(1, tile_cols);
+    size_t row_tiles = (rows + tile_rows - 1) / tile_rows;
+    size_t col_tiles = (cols + tile_cols - 1) / tile_cols;
+
+    ParallelFor(0, row_tiles * col_tiles, options,
+                [&](size_t tile_start, size_t tile_end) {
+                  for (size_t tile = tile_start; tile < tile_end; ++tile) {
+                    size_t row = (tile / col_tiles) * tile_rows;
+                    size_t col = (tile % col_tiles) * tile_cols;
+                    callback(row, std::min(row + tile_rows, rows),
+                             col, std::min(col + tile_cols, cols));
+                  }
+                });
+  }
+
+  // ParallelFor3D: tile a d0 x d1 x d2 iteration space (e.g., batch x rows x channels)
+  // Callback is called per tile: callback(i_begin, i_end, j_begin, j_end, k_begin, k_end)
+  template <typename F>
+  void ParallelFor3D(size_t d0, size_t d1, size_t d2, size_t tile0, size_t tile1, size_t tile2,
+                     F&& callback) {
+    ParallelFor3D(d0, d1, d2, tile0, tile1, tile2, ParallelOptions{Schedule::DYNAMIC, 1},
+                  std::forward<F>(callback));
+  }
+
+  // ParallelFor3D with explicit scheduling over tiles
+  template <typename F>
+  void ParallelFor3D(size_t d0, size_t d1, size_t d2, size_t tile0, size_t tile1, size_t tile2,
+                     const ParallelOptions& options, F&& callback) {
+    tile0 = std::max<size_t>(1, tile0);
+    tile1 = std::max<size_t>(1, tile1);
+    tile2 = std::max<size_t>(1, tile2);
+    size_t tiles0 = (d0 + tile0 - 1) / tile0;
+    size_t tiles1 = (d1 + tile1 - 1) / tile1;
+    size_t tiles2 = (d2 + tile2 - 1) / tile2;
+
+    ParallelFor(0, tiles0 * tiles1 * tiles2, options,
+                [&](size_t tile_start, size_t tile_end) {
+                  for (size_t tile = tile_start; tile < tile_end; ++tile) {
+                    size_t i = (tile / (tiles1 * tiles2)) * tile0;
+                    size_t j = ((tile / tiles2) % tiles1) * tile1;
+                    size_t k = (tile % tiles2) * tile2;
+                    callback(i, std::min(i + tile0, d0), j, std::min(j + tile1, d1),
+                             k, std::min(k + tile2, d2));
+                  }
+                });
+  }
+
+  /**
+   * @brief Grow or shrink the number of active workers without tearing the pool down
+   * @param num_threads New number of active workers (at least 1)
+   * @note Safe during ParallelFor: queued chunks are drained by the remaining active workers
+   */
+  void Resize(size_t num_threads);
+
+  /**
+   * @brief Number of active (non-parked) workers
+   */
+  size_t GetNumThreads() const { return active_threads_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief cpus the workers are pinned to (empty if placement is left to the OS)
+   */
+  const std::vector<int>& GetPinnedCpus() const { return pinned_cpus_; }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+ private:
+  static constexpr size_t kNumPriorities = 3;
+
+  // State of one DYNAMIC/GUIDED ParallelFor, shared between the caller and helper
+  // tasks. Helpers that start after the range is exhausted only touch this state,
+  // never the caller's callback.
+  template <typename F>
+  struct ParallelLoop : std::enable_shared_from_this<ParallelLoop<F>> {
+    ThreadPool* pool;
+    F* body;
+    std::atomic<size_t> next;
+    std::atomic<size_t> running{0};
+    size_t end;
+    size_t grain_size;
+    size_t num_threads;
+    Schedule schedule;
+    TaskPriority priority;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    bool Claim(size_t& chunk_start, size_t& chunk_end) {
+      if (schedule == Schedule::DYNAMIC) {
+        chunk_start = next.fetch_add(grain_size);
+        if (chunk_start >= end) return false;
+        chunk_end = std::min(chunk_start + grain_size, end);
+        return true;
+      }
+
+      // GUIDED: chunk shrinks with the remaining work
+      size_t current = next.load();
+      while (current < end) {
+        size_t chunk = std::max(grain_size, (end - current) / (2 * num_threads));
+        size_t claimed_end = std::min(current + chunk, end);
+        if (next.compare_exchange_weak(current, claimed_end)) {
+          chunk_start = current;
+          chunk_end = claimed_end;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // may_yield: running on a pool worker, so hand the worker to higher-priority
+    // work at chunk boundaries by requeueing the rest of this helper
+    void Run(bool may_yield) {
+      running.fetch_add(1);
+      try {
+        size_t chunk_start = 0;
+        size_t chunk_end = 0;
+        while (Claim(chunk_start, chunk_end)) {
+          (*body)(chunk_start, chunk_end);
+
+          if (may_yield && next.load() < end && pool->ShouldYield(priority)) {
+            auto self = this->shared_from_this();
+            pool->Submit(priority, [self]() { self->Run(true); });
+            break;
+          }
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+        next.store(end);
+      }
+      if (running.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.notify_all();
+      }
+    }
+  };
+
+  // Start worker `index` (caller holds workers_mutex_)
+  void SpawnWorker(size_t index);
+
+  // Worker main loop; parks while index >= active_threads_
+  void WorkerLoop(size_t index);
+
+  // Highest-priority lane a worker may take from, or kNumPriorities if none
+  // (caller holds queue_mutex_)
+  size_t NextRunnableLane() const;
+
+  // true if every lane is empty (caller holds queue_mutex_)
+  bool AllQueuesEmpty() const;
+
+  std::vector<std::thread> workers_;
+  std::vector<int> pinned_cpus_;
+  std::queue<std::function<void()>> tasks_[kNumPriorities];
+  std::atomic<size_t> pending_[kNumPriorities];  // lock-free view of queue sizes for ShouldYield
+  size_t running_background_;
+
+  std::mutex workers_mutex_;  // guards workers_ growth against Resize/destruction
+  std::mutex queue_mutex_;
+  std::condition_variable condition_;
+  std::condition_variable park_condition_;
+  std::atomic<size_t> active_threads_;
+  bool stop_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -2,6 +2,7 @@
 #define TVM_RUNTIME_H
 
 #include "i_runtime.h"
+#include "plan_cache.h"
 
 #ifdef USE_TVM
 #include <memory>
@@ -32,9 +33,47 @@ public:
   bool loadModel(const char* model_path) override;
   bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                     float* output) override;
+  bool runBatch(const float* inputs, size_t batch_size,
+                const std::vector<int64_t>& sample_shape, float* outputs) override;
+  bool runMulti(const std::vector<const float*>& inputs,
+                const std::vector<std::vector<int64_t>>& input_shapes,
+                const std::vector<float*>& outputs) override;
+
+  /**
+   * @brief Wrap the input buffers as DLPack tensors the entry function reads in place
+   * @note float32 only, images in getInputLayout(); the VM allocates its results, so each
+   *       output is still copied once
+   */
+  bool bindBuffers(const std::vector<InputTensor>& inputs,
+                   const std::vector<OutputTensor>& outputs) override;
+  bool runBound() override;
+  void unbindBuffers() override;
+  std::unique_ptr<IRuntime> clone() const override;
   const char* getRuntimeType() const override { return "TVM"; }
   size_t getInputSize() const override;
   size_t getOutputSize() const override;
+  std::vector<int64_t> getInputShape() const override;
+
+  /**
+   * @brief Layout the library was compiled for, read off its default input shape
+   * @note Compiled libraries record no layout: a 4D input whose last dimension looks like
+   *       channels (1, 3 or 4) and whose second does not is taken as NHWC
+   */
+  TensorLayout getInputLayout() const override;
+  std::vector<TensorInfo> getInputInfo() const override { return input_info_; }
+  std::vector<TensorInfo> getOutputInfo() const override { return output_info_; }
+
+  /**
+   * @brief Allocate the input tensor for input_shape and learn its output size with one call
+   */
+  size_t prepareShape(const std::vector<int64_t>& input_shape) override;
+
+  /**
+   * @brief Set the worker count of this instance (0 returns to the TVM ComputePool share)
+   * @note TVM keeps one worker pool per calling thread; it is resized before each call of an
+   *       instance whose count differs from the pool's
+   */
+  bool setNumThreads(size_t num_threads) override;
 
 private:
   // TVM module loaded from compiled model
@@ -46,20 +85,86 @@ private:
   // Main inference function
   tvm::ffi::Optional<tvm::ffi::Function> inference_func_;
 
-  // Input and output tensor metadata
-  std::vector<int64_t> input_shape_;
-  std::vector<int64_t> output_shape_;
+  // Default input shapes: recorded by the exporter in <model>.shape, else probed at load.
+  // Compiled libraries carry no tensor names, so inputs and outputs are input_<i>/output_<i>
+  std::vector<TensorInfo> input_info_;
+  std::vector<TensorInfo> output_info_;
 
-  // Cached sizes
+  // Cached sizes of the first input and output (per sample, default shape)
   size_t input_size_;
   size_t output_size_;
 
+  /**
+   * @brief Preallocated input tensors and known output sizes for one set of input shapes
+   */
+  struct Plan {
+    std::vector<tvm::runtime::Tensor> inputs;
+    std::vector<size_t> output_sizes;  // values of each output for the whole input, empty until
+                                       // the first call
+  };
+  PlanCache<Plan> plans_;
+
+  // Plan over the caller buffers of bindBuffers(), and where its outputs go
+  std::unique_ptr<Plan> bound_plan_;
+  std::vector<float*> bound_outputs_;
+
   // Device context (CPU by default)
   DLDevice device_;
 
   // Initialization flag
   bool initialized_;
 
+  // Cleared once a batched call is rejected by a model compiled with a static batch
+  bool supports_dynamic_batch_;
+
+  // Worker count set by setNumThreads(), 0 to follow the ComputePool share
+  size_t num_threads_;
+
+  /**
+   * @brief Create the executor (Relax VM or entry function) over the loaded module_
+   * @note Each call on a VM module instantiates a separate VirtualMachine with its own registers
+   */
+  bool initExecutor();
+
+  /**
+   * @brief Cached plan for input_shapes, allocating its input tensors on first use
+   */
+  Plan& getPlan(const std::vector<std::vector<int64_t>>& input_shapes);
+
+  /**
+   * @brief Output sizes for input_shapes, learned with one call on zeros the first time
+   * @return Empty if the model cannot take these shapes
+   */
+  std::vector<size_t> prepareShapes(const std::vector<std::vector<int64_t>>& input_shapes);
+
+  /**
+   * @brief Call the entry function on the plan's inputs
+   * @return Output tensors: one, or the fields of a returned tuple
+   */
+  std::vector<tvm::runtime::Tensor> call(const Plan& plan) const;
+
+  /**
+   * @brief Size the calling thread's TVM worker pool to num_threads, or to the TVM share of
+   *        the ComputePool budget (following rebalances) if 0; called before every call()
+   */
+  static void configureThreads(size_t num_threads);
+
+  /**
+   * @brief Find the default input shapes: <model>.shape (one line per input),
+   *        then common image shapes
+   */
+  bool inferShapes(const std::string& model_path);
+
+  /**
+   * @brief Shared path of runInference/runBatch/runMulti
+   * @param outputs Buffers for the first outputs.size() model outputs
+   * @param rejected Set to true if the model refused the call (e.g. its input shapes), as
+   *                 opposed to returning unexpected outputs; may be nullptr
+   */
+  bool execute(const std::vector<const float*>& inputs,
+               const std::vector<std::vector<int64_t>>& input_shapes,
+               const std::vector<float*>& outputs, bool* rejected = nullptr);
+
   /**
    * @brief Calculate total size from shape vector
    */
@@ -209,6 +209,10 @@ def build_resnet18_with_metaschedule(
         # Export the module
         ex.export_library(output_path)
 
+        # Input shape for TVMRuntime (the library itself carries no input metadata)
+        with open(output_path + ".shape", "w") as f:
+            f.write(" ".join(str(d) for d in input_info[0][0]) + "\n")
+
         print(f"[5/5] Model successfully exported to: {output_path}")
         print(f"[5/5] Library size: {os.path.getsize(output_path) / (1024*1024):.2f} MB")
 
@@ -167,17 +167,22 @@ def run_inference(vm, input_data: np.ndarray, device):
     return output.numpy()
 
 
-def export_to_so(ex, output_path: str):
+def export_to_so(ex, output_path: str, input_shape=None):
     """컴파일된 모듈을 .so 파일로 내보내기
 
     Parameters
     ----------
     ex : Executable -> 컴파일된 실행 파일
     output_path : str -> 출력 .so 파일 경로
+    input_shape : tuple -> 입력 shape, <output_path>.shape 에 기록 (TVMRuntime 이 로드 시 사용)
     """
     ex.export_library(output_path)
     print(f"라이브러리 저장됨: {output_path}")
 
+    if input_shape is not None:
+        with open(output_path + ".shape", "w") as f:
+            f.write(" ".join(str(d) for d in input_shape) + "\n")
+
 
 def main():
     # 모델 경로 설정
@@ -235,7 +240,7 @@ def main():
         print("=" * 50)
         output_dir = os.path.join(project_root, "models")
         so_path = os.path.join(output_dir, "resnet50_tvm.so")
-        export_to_so(ex, so_path)
+        export_to_so(ex, so_path, input_shape)
 
     print("\n" + "=" * 50)
     print("Success!")
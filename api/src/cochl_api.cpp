@@ -6,10 +6,15 @@
 #include "cochl_api.h"
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 
+#include "runtime/batch_scheduler.h"
+#include "runtime/cascade.h"
 #include "runtime/runtime_manager.h"
+#include "runtime/tensor_binding.h"
+#include "runtime/thread_pool.h"
 #include "error/api_error.h"
 
 namespace external_api {
@@ -33,8 +38,57 @@ std::unique_ptr<CochlApi> CochlApi::create(const std::string& model_path) {
   return api;
 }
 
+std::unique_ptr<CochlApi> CochlApi::createAutoTuned(const std::string& model_path) {
+  LOG(INFO) << "[CochlApi] Auto-tuning model: " << model_path;
+
+  if (model_path.empty()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::EMPTY_PATH);
+    return nullptr;
+  }
+
+  auto api = std::unique_ptr<CochlApi>(new CochlApi());
+
+  api->runtime_manager_ = cochl_api::runtime::RuntimeManager::createAutoTuned(model_path);
+
+  if (!api->runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_CREATION_FAILED);
+    return nullptr;
+  }
+
+  return api;
+}
+
+std::unique_ptr<CochlApi> CochlApi::createCascade(
+    const std::vector<cochl_api::runtime::CascadeStage>& stages,
+    cochl_api::runtime::ConfidenceMode mode) {
+  if (stages.empty()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_PARAMETER,
+                                 "Cascade without stages");
+    return nullptr;
+  }
+
+  LOG(INFO) << "[CochlApi] Loading cascade of " << stages.size() << " models";
+
+  auto api = create(stages[0].model_path);
+  if (!api) {
+    return nullptr;
+  }
+
+  api->cascade_ = cochl_api::runtime::ModelCascade::create(*api->runtime_manager_, stages, mode);
+  if (!api->cascade_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_CREATION_FAILED);
+    return nullptr;
+  }
+
+  return api;
+}
+
 CochlApi::CochlApi() = default;
-CochlApi::~CochlApi() = default;
+
+CochlApi::~CochlApi() {
+  // Finish queued requests while the runtime is still alive
+  executor_.reset();
+}
 
 bool CochlApi::runInference(const float* input, const std::vector<int64_t>& input_shape,
                             float* output) const {
@@ -58,9 +112,444 @@ bool CochlApi::runInference(const float* input, const std::vector<int64_t>& inpu
     return false;
   }
 
+  if (cascade_) {
+    return cascade_->run(input, input_shape, output);
+  }
+
+  // Images in another layout go to the backend as they are; the batch scheduler
+  // concatenates NCHW samples only
+  cochl_api::runtime::TensorLayout layout = input_layout_.load();
+  if (layout != cochl_api::runtime::TensorLayout::NCHW && input_shape.size() == 4) {
+    return runtime_manager_->runTyped(
+        {{input, cochl_api::runtime::DataType::FLOAT32, input_shape, layout}},
+        {{output, cochl_api::runtime::DataType::FLOAT32}});
+  }
+
+  // Single samples of the default shape wait for a batch when batching is on;
+  // other shapes produce a different output size and run on their own
+  auto scheduler = std::atomic_load(&batch_scheduler_);
+  if (scheduler && input_shape[0] == 1) {
+    size_t sample_size = 1;
+    for (auto dim : input_shape) {
+      sample_size *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+    }
+    if (sample_size == runtime_manager_->getInputSize()) {
+      return scheduler->run(input, input_shape, output);
+    }
+  }
+
   return runtime_manager_->runInference(input, input_shape, output);
 }
 
+bool CochlApi::runMulti(const std::vector<const float*>& inputs,
+                        const std::vector<std::vector<int64_t>>& input_shapes,
+                        const std::vector<float*>& outputs) const {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (inputs.empty() || inputs.size() != input_shapes.size()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA,
+                                 "One shape per input required");
+    return false;
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!inputs[i]) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA);
+      return false;
+    }
+    if (input_shapes[i].empty() || input_shapes[i][0] != input_shapes[0][0]) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_SIZE,
+                                   "Inputs must share the batch dimension");
+      return false;
+    }
+  }
+
+  if (outputs.empty()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+  for (float* output : outputs) {
+    if (!output) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+      return false;
+    }
+  }
+
+  cochl_api::runtime::TensorLayout layout = input_layout_.load();
+  if (layout != cochl_api::runtime::TensorLayout::NCHW) {
+    std::vector<cochl_api::runtime::InputTensor> typed_inputs;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      typed_inputs.push_back(
+          {inputs[i], cochl_api::runtime::DataType::FLOAT32, input_shapes[i], layout});
+    }
+    std::vector<cochl_api::runtime::OutputTensor> typed_outputs;
+    for (float* output : outputs) {
+      typed_outputs.push_back({output, cochl_api::runtime::DataType::FLOAT32});
+    }
+    return runtime_manager_->runTyped(typed_inputs, typed_outputs);
+  }
+
+  return runtime_manager_->runMulti(inputs, input_shapes, outputs);
+}
+
+bool CochlApi::runTyped(const std::vector<cochl_api::runtime::InputTensor>& inputs,
+                        const std::vector<cochl_api::runtime::OutputTensor>& outputs) const {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (inputs.empty()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  for (const auto& input : inputs) {
+    if (!input.data) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA);
+      return false;
+    }
+    if (input.shape.empty() || input.shape[0] != inputs[0].shape[0]) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_SIZE,
+                                   "Inputs must share the batch dimension");
+      return false;
+    }
+  }
+
+  if (outputs.empty()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+  for (const auto& output : outputs) {
+    if (!output.data) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+      return false;
+    }
+  }
+
+  return runtime_manager_->runTyped(inputs, outputs);
+}
+
+bool CochlApi::bindBuffers(const std::vector<cochl_api::runtime::InputTensor>& inputs,
+                           const std::vector<cochl_api::runtime::OutputTensor>& outputs) {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (inputs.size() != getNumInputs()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA,
+                                 "One buffer per model input required");
+    return false;
+  }
+  for (const auto& input : inputs) {
+    if (!input.data || input.shape.empty() || input.shape[0] != inputs[0].shape[0]) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA);
+      return false;
+    }
+  }
+
+  if (outputs.size() != getNumOutputs()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA,
+                                 "One buffer per model output required");
+    return false;
+  }
+  for (const auto& output : outputs) {
+    if (!output.data) {
+      cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+      return false;
+    }
+  }
+
+  std::shared_ptr<cochl_api::runtime::TensorBinding> binding =
+      runtime_manager_->bindBuffers(inputs, outputs);
+  if (!binding) {
+    return false;
+  }
+  std::atomic_store(&binding_, binding);
+  return true;
+}
+
+bool CochlApi::runBound() const {
+  auto binding = std::atomic_load(&binding_);
+  if (!binding) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_PARAMETER, "No buffers bound");
+    return false;
+  }
+  return binding->run();
+}
+
+void CochlApi::unbindBuffers() {
+  std::atomic_store(&binding_, std::shared_ptr<cochl_api::runtime::TensorBinding>());
+}
+
+bool CochlApi::isZeroCopyBound() const {
+  auto binding = std::atomic_load(&binding_);
+  return binding && binding->isZeroCopy();
+}
+
+bool CochlApi::runInferenceAsync(const float* input, const std::vector<int64_t>& input_shape,
+                                 float* output, InferenceCallback on_done) const {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (!input) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!output) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (!on_done) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_PARAMETER, "NULL callback");
+    return false;
+  }
+
+  int64_t input_size = input_shape.empty() ? 0 : 1;
+  for (auto dim : input_shape) {
+    input_size = dim > 0 ? input_size * dim : 0;
+  }
+  if (input_size == 0) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_SIZE, "Invalid input shape");
+    return false;
+  }
+
+  // Copy so the caller can reuse its buffer for the next frame right away
+  auto frame = std::make_shared<std::vector<float>>(input, input + input_size);
+
+  std::lock_guard<std::mutex> lock(executor_mutex_);
+  if (!executor_) {
+    // One thread keeps requests in order; the parallel work runs on the compute pool
+    executor_ = std::make_unique<cochl_api::runtime::ThreadPool>(
+        1, cochl_api::runtime::ThreadAffinity());
+  }
+
+  executor_->Submit([this, frame, input_shape, output, on_done]() {
+    bool success = runInference(frame->data(), input_shape, output);
+    on_done(success);
+  });
+  return true;
+}
+
+bool CochlApi::runBatch(const float* inputs, size_t batch_size,
+                        const std::vector<int64_t>& sample_shape, float* outputs) const {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (!inputs) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!outputs) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (batch_size == 0) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_PARAMETER, "Batch size is 0");
+    return false;
+  }
+
+  if (sample_shape.empty()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_SIZE, "Empty input shape");
+    return false;
+  }
+
+  cochl_api::runtime::TensorLayout layout = input_layout_.load();
+  if (layout != cochl_api::runtime::TensorLayout::NCHW && sample_shape.size() == 4) {
+    std::vector<int64_t> batch_shape = sample_shape;
+    batch_shape[0] = static_cast<int64_t>(batch_size);
+    return runtime_manager_->runTyped(
+        {{inputs, cochl_api::runtime::DataType::FLOAT32, batch_shape, layout}},
+        {{outputs, cochl_api::runtime::DataType::FLOAT32}});
+  }
+
+  return runtime_manager_->runBatch(inputs, batch_size, sample_shape, outputs);
+}
+
+bool CochlApi::enableBatching(size_t max_batch_size, std::chrono::microseconds max_delay) {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (max_delay.count() < 0) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_PARAMETER, "Negative batching delay");
+    return false;
+  }
+
+  std::shared_ptr<cochl_api::runtime::BatchScheduler> scheduler;
+  if (max_batch_size > 1) {
+    cochl_api::runtime::BatchOptions options;
+    options.max_batch_size = max_batch_size;
+    options.max_delay = max_delay;
+    // As many batches in flight as instances can run them
+    options.max_in_flight = runtime_manager_->getMaxInstances();
+
+    auto* runtime_manager = runtime_manager_.get();
+    scheduler = std::make_shared<cochl_api::runtime::BatchScheduler>(
+        [runtime_manager](const float* inputs, size_t batch_size,
+                          const std::vector<int64_t>& sample_shape, float* outputs) {
+          return runtime_manager->runBatch(inputs, batch_size, sample_shape, outputs);
+        },
+        runtime_manager_->getOutputSize(), options);
+  }
+
+  // Callers already inside the old scheduler keep it alive until their batch completes
+  std::atomic_store(&batch_scheduler_, scheduler);
+  return true;
+}
+
+bool CochlApi::isBatchingEnabled() const {
+  return std::atomic_load(&batch_scheduler_) != nullptr;
+}
+
+bool CochlApi::runCascade(const float* input, const std::vector<int64_t>& input_shape,
+                          float* output, size_t* last_stage) const {
+  if (!cascade_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED,
+                                 "Not created as a cascade");
+    return false;
+  }
+
+  if (!input) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!output) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (input_shape.empty() || input_shape[0] <= 0) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_SIZE, "Invalid input shape");
+    return false;
+  }
+
+  return cascade_->run(input, input_shape, output, last_stage);
+}
+
+size_t CochlApi::getNumStages() const {
+  if (!runtime_manager_) {
+    return 0;
+  }
+  return cascade_ ? cascade_->getNumStages() : 1;
+}
+
+std::vector<cochl_api::runtime::CascadeStageStats> CochlApi::getCascadeStats() const {
+  if (!cascade_) {
+    return {};
+  }
+  return cascade_->getStats();
+}
+
+bool CochlApi::swapModel(const std::string& model_path,
+                         const std::vector<int64_t>& warmup_shape) {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  LOG(INFO) << "[CochlApi] Swapping model to: " << model_path;
+  return runtime_manager_->swapModel(model_path, warmup_shape);
+}
+
+bool CochlApi::setCpuPartition(const cochl_api::runtime::ThreadAffinity& affinity) {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  return runtime_manager_->setCpuPartition(affinity);
+}
+
+bool CochlApi::setCpuShare(size_t index, size_t count) {
+  if (index >= count) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_PARAMETER,
+                                 "CPU share index out of range");
+    return false;
+  }
+
+  cochl_api::runtime::ThreadAffinity affinity;
+  affinity.policy = cochl_api::runtime::AffinityPolicy::EXPLICIT;
+  affinity.cpus = cochl_api::runtime::CpuTopology::get().partition(index, count);
+  return setCpuPartition(affinity);
+}
+
+std::vector<int> CochlApi::getCpuPartition() const {
+  return runtime_manager_ ? runtime_manager_->getCpuPartition() : std::vector<int>();
+}
+
+bool CochlApi::setMaxInstances(size_t max_instances) {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  runtime_manager_->setMaxInstances(max_instances);
+  if (auto scheduler = std::atomic_load(&batch_scheduler_)) {
+    scheduler->setMaxInFlight(runtime_manager_->getMaxInstances());
+  }
+  return true;
+}
+
+bool CochlApi::setResultCache(size_t max_bytes) {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  runtime_manager_->setResultCache(max_bytes);
+  return true;
+}
+
+cochl_api::runtime::ResultCacheStats CochlApi::getResultCacheStats() const {
+  return runtime_manager_ ? runtime_manager_->getResultCacheStats()
+                          : cochl_api::runtime::ResultCacheStats();
+}
+
+bool CochlApi::getWarmupLatency(double& cold_ms, double& warm_ms) const {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  cochl_api::runtime::WarmupStats stats = runtime_manager_->getWarmupStats();
+  if (stats.runs == 0) {
+    return false;
+  }
+
+  cold_ms = stats.cold_ms;
+  warm_ms = stats.warm_ms;
+  return true;
+}
+
+size_t CochlApi::prepareShape(const std::vector<int64_t>& input_shape) const {
+  if (!runtime_manager_) {
+    cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return 0;
+  }
+
+  if (input_shape.empty()) {
+    cochl_api::error::printError(cochl_api::error::ApiError::INVALID_INPUT_SIZE, "Empty input shape");
+    return 0;
+  }
+
+  return runtime_manager_->prepareShape(input_shape);
+}
+
 size_t CochlApi::getInputSize() const {
   if (!runtime_manager_) {
     cochl_api::error::printError(cochl_api::error::ApiError::RUNTIME_NOT_INITIALIZED);
@@ -77,4 +566,85 @@ size_t CochlApi::getOutputSize() const {
   return runtime_manager_->getOutputSize();
 }
 
+size_t CochlApi::getNumInputs() const {
+  return runtime_manager_ ? runtime_manager_->getInputInfo().size() : 0;
+}
+
+size_t CochlApi::getNumOutputs() const {
+  return runtime_manager_ ? runtime_manager_->getOutputInfo().size() : 0;
+}
+
+namespace {
+
+int findTensor(const std::vector<cochl_api::runtime::TensorInfo>& tensors, const std::string& name) {
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (tensors[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+int CochlApi::getInputIndex(const std::string& name) const {
+  return runtime_manager_ ? findTensor(runtime_manager_->getInputInfo(), name) : -1;
+}
+
+int CochlApi::getOutputIndex(const std::string& name) const {
+  return runtime_manager_ ? findTensor(runtime_manager_->getOutputInfo(), name) : -1;
+}
+
+std::string CochlApi::getInputName(size_t index) const {
+  if (!runtime_manager_) return "";
+  auto tensors = runtime_manager_->getInputInfo();
+  return index < tensors.size() ? tensors[index].name : "";
+}
+
+std::string CochlApi::getOutputName(size_t index) const {
+  if (!runtime_manager_) return "";
+  auto tensors = runtime_manager_->getOutputInfo();
+  return index < tensors.size() ? tensors[index].name : "";
+}
+
+std::vector<int64_t> CochlApi::getInputShape(size_t index) const {
+  if (!runtime_manager_) return {};
+  auto tensors = runtime_manager_->getInputInfo();
+  return index < tensors.size() ? tensors[index].shape : std::vector<int64_t>();
+}
+
+size_t CochlApi::getOutputSize(size_t index) const {
+  if (!runtime_manager_) return 0;
+  auto tensors = runtime_manager_->getOutputInfo();
+  return index < tensors.size() ? tensors[index].size : 0;
+}
+
+cochl_api::runtime::DataType CochlApi::getInputDataType(size_t index) const {
+  if (!runtime_manager_) return cochl_api::runtime::DataType::FLOAT32;
+  auto tensors = runtime_manager_->getInputInfo();
+  return index < tensors.size() ? tensors[index].dtype : cochl_api::runtime::DataType::FLOAT32;
+}
+
+cochl_api::runtime::DataType CochlApi::getOutputDataType(size_t index) const {
+  if (!runtime_manager_) return cochl_api::runtime::DataType::FLOAT32;
+  auto tensors = runtime_manager_->getOutputInfo();
+  return index < tensors.size() ? tensors[index].dtype : cochl_api::runtime::DataType::FLOAT32;
+}
+
+cochl_api::runtime::TensorLayout CochlApi::getPreferredLayout() const {
+  if (!runtime_manager_) return cochl_api::runtime::TensorLayout::NCHW;
+  return runtime_manager_->getInputLayout();
+}
+
+void CochlApi::setInputLayout(cochl_api::runtime::TensorLayout layout) {
+  LOG(INFO) << "[CochlApi] Input layout: " << cochl_api::runtime::tensorLayoutName(layout)
+            << " (backend computes in "
+            << cochl_api::runtime::tensorLayoutName(getPreferredLayout()) << ")";
+  input_layout_.store(layout);
+}
+
+cochl_api::runtime::TensorLayout CochlApi::getInputLayout() const {
+  return input_layout_.load();
+}
+
 }  // namespace external_api
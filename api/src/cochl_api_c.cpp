@@ -1,12 +1,16 @@
 #include "cochl_api_c.h"
 
 #include "cochl_api.h"
+#include "runtime/compute_pool.h"
+#include "runtime/cpu_topology.h"
+#include "runtime/model_residency.h"
 #include "runtime/runtime_manager.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "utils/util_img.h"
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -27,6 +31,58 @@ void* CochlApi_Create(const char* model_path) {
   return api.release();
 }
 
+void* CochlApi_CreateAutoTuned(const char* model_path) {
+  if (!model_path) {
+    LOG(ERROR) << "[CochlApi_CreateAutoTuned] NULL model path";
+    return nullptr;
+  }
+
+  auto api = external_api::CochlApi::createAutoTuned(std::string(model_path));
+  if (!api) {
+    return nullptr;
+  }
+
+  return api.release();
+}
+
+static_assert(
+    static_cast<int>(cochl_api::runtime::ConfidenceMode::SOFTMAX) == COCHL_CONFIDENCE_SOFTMAX &&
+        static_cast<int>(cochl_api::runtime::ConfidenceMode::SIGMOID) == COCHL_CONFIDENCE_SIGMOID &&
+        static_cast<int>(cochl_api::runtime::ConfidenceMode::PROBABILITY) ==
+            COCHL_CONFIDENCE_PROBABILITY,
+    "CochlConfidenceMode must match cochl_api::runtime::ConfidenceMode");
+
+void* CochlApi_CreateCascade(const char* const* model_paths, const float* thresholds,
+                             size_t num_stages, int confidence) {
+  if (!model_paths || !thresholds || num_stages == 0) {
+    LOG(ERROR) << "[CochlApi_CreateCascade] Invalid stages";
+    return nullptr;
+  }
+
+  if (confidence < COCHL_CONFIDENCE_SOFTMAX || confidence > COCHL_CONFIDENCE_PROBABILITY) {
+    LOG(ERROR) << "[CochlApi_CreateCascade] Invalid confidence mode: " << confidence;
+    return nullptr;
+  }
+
+  std::vector<cochl_api::runtime::CascadeStage> stages(num_stages);
+  for (size_t i = 0; i < num_stages; ++i) {
+    if (!model_paths[i]) {
+      LOG(ERROR) << "[CochlApi_CreateCascade] NULL model path of stage " << i;
+      return nullptr;
+    }
+    stages[i].model_path = model_paths[i];
+    stages[i].threshold = thresholds[i];
+  }
+
+  auto api = external_api::CochlApi::createCascade(
+      stages, static_cast<cochl_api::runtime::ConfidenceMode>(confidence));
+  if (!api) {
+    return nullptr;
+  }
+
+  return api.release();
+}
+
 int CochlApi_RunInference(void* instance, const float* input,
                           const long long* input_shape, size_t shape_size,
                           float* output) {
@@ -47,6 +103,530 @@ int CochlApi_RunInference(void* instance, const float* input,
   return api->runInference(input, shape_vec, output) ? 1 : 0;
 }
 
+int CochlApi_RunInferenceAsync(void* instance, const float* input,
+                               const long long* input_shape, size_t shape_size,
+                               float* output, CochlInferenceCallback callback, void* user_data) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_RunInferenceAsync] NULL instance";
+    return 0;
+  }
+
+  if (!input_shape || shape_size == 0) {
+    LOG(ERROR) << "[CochlApi_RunInferenceAsync] Invalid input shape";
+    return 0;
+  }
+
+  if (!callback) {
+    LOG(ERROR) << "[CochlApi_RunInferenceAsync] NULL callback";
+    return 0;
+  }
+
+  std::vector<int64_t> shape_vec(input_shape, input_shape + shape_size);
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  bool queued = api->runInferenceAsync(input, shape_vec, output, [callback, user_data](bool success) {
+    callback(success ? 1 : 0, user_data);
+  });
+  return queued ? 1 : 0;
+}
+
+int CochlApi_RunBatch(void* instance, const float* inputs, size_t batch_size,
+                      const long long* sample_shape, size_t shape_size, float* outputs) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_RunBatch] NULL instance";
+    return 0;
+  }
+
+  if (!sample_shape || shape_size == 0) {
+    LOG(ERROR) << "[CochlApi_RunBatch] Invalid sample shape";
+    return 0;
+  }
+
+  std::vector<int64_t> shape_vec(sample_shape, sample_shape + shape_size);
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->runBatch(inputs, batch_size, shape_vec, outputs) ? 1 : 0;
+}
+
+int CochlApi_RunMulti(void* instance, const float* const* inputs,
+                      const long long* const* input_shapes, const size_t* shape_sizes,
+                      size_t num_inputs, float* const* outputs, size_t num_outputs) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_RunMulti] NULL instance";
+    return 0;
+  }
+
+  if (!inputs || !input_shapes || !shape_sizes || num_inputs == 0 || !outputs ||
+      num_outputs == 0) {
+    LOG(ERROR) << "[CochlApi_RunMulti] Invalid inputs or outputs";
+    return 0;
+  }
+
+  std::vector<std::vector<int64_t>> shape_vecs;
+  for (size_t i = 0; i < num_inputs; ++i) {
+    if (!input_shapes[i] || shape_sizes[i] == 0) {
+      LOG(ERROR) << "[CochlApi_RunMulti] Invalid shape of input " << i;
+      return 0;
+    }
+    shape_vecs.emplace_back(input_shapes[i], input_shapes[i] + shape_sizes[i]);
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->runMulti(std::vector<const float*>(inputs, inputs + num_inputs), shape_vecs,
+                       std::vector<float*>(outputs, outputs + num_outputs))
+             ? 1
+             : 0;
+}
+
+static_assert(static_cast<int>(cochl_api::runtime::DataType::FLOAT32) == COCHL_DTYPE_FLOAT32 &&
+                  static_cast<int>(cochl_api::runtime::DataType::FLOAT16) == COCHL_DTYPE_FLOAT16 &&
+                  static_cast<int>(cochl_api::runtime::DataType::INT8) == COCHL_DTYPE_INT8 &&
+                  static_cast<int>(cochl_api::runtime::DataType::UINT8) == COCHL_DTYPE_UINT8 &&
+                  static_cast<int>(cochl_api::runtime::DataType::INT16) == COCHL_DTYPE_INT16,
+              "CochlDataType must match cochl_api::runtime::DataType");
+
+static bool toDataType(int dtype, cochl_api::runtime::DataType& data_type) {
+  if (dtype < COCHL_DTYPE_FLOAT32 || dtype > COCHL_DTYPE_INT16) {
+    return false;
+  }
+  data_type = static_cast<cochl_api::runtime::DataType>(dtype);
+  return true;
+}
+
+static_assert(static_cast<int>(cochl_api::runtime::TensorLayout::NCHW) == COCHL_LAYOUT_NCHW &&
+                  static_cast<int>(cochl_api::runtime::TensorLayout::NHWC) == COCHL_LAYOUT_NHWC,
+              "CochlTensorLayout must match cochl_api::runtime::TensorLayout");
+
+static bool toTensorLayout(int layout, cochl_api::runtime::TensorLayout& tensor_layout) {
+  if (layout != COCHL_LAYOUT_NCHW && layout != COCHL_LAYOUT_NHWC) {
+    return false;
+  }
+  tensor_layout = static_cast<cochl_api::runtime::TensorLayout>(layout);
+  return true;
+}
+
+int CochlApi_RunInferenceTyped(void* instance, const void* input, int input_dtype,
+                               const long long* input_shape, size_t shape_size,
+                               void* output, int output_dtype) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_RunInferenceTyped] NULL instance";
+    return 0;
+  }
+
+  if (!input_shape || shape_size == 0) {
+    LOG(ERROR) << "[CochlApi_RunInferenceTyped] Invalid input shape";
+    return 0;
+  }
+
+  cochl_api::runtime::InputTensor typed_input;
+  cochl_api::runtime::OutputTensor typed_output;
+  if (!toDataType(input_dtype, typed_input.dtype) || !toDataType(output_dtype, typed_output.dtype)) {
+    LOG(ERROR) << "[CochlApi_RunInferenceTyped] Unknown data type";
+    return 0;
+  }
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  typed_input.data = input;
+  typed_input.shape.assign(input_shape, input_shape + shape_size);
+  typed_input.layout = api->getInputLayout();
+  typed_output.data = output;
+
+  return api->runTyped({typed_input}, {typed_output}) ? 1 : 0;
+}
+
+int CochlApi_RunMultiTyped(void* instance, const void* const* inputs, const int* input_dtypes,
+                           const long long* const* input_shapes, const size_t* shape_sizes,
+                           size_t num_inputs, void* const* outputs, const int* output_dtypes,
+                           size_t num_outputs) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_RunMultiTyped] NULL instance";
+    return 0;
+  }
+
+  if (!inputs || !input_dtypes || !input_shapes || !shape_sizes || num_inputs == 0 || !outputs ||
+      !output_dtypes || num_outputs == 0) {
+    LOG(ERROR) << "[CochlApi_RunMultiTyped] Invalid inputs or outputs";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  std::vector<cochl_api::runtime::InputTensor> typed_inputs(num_inputs);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    if (!input_shapes[i] || shape_sizes[i] == 0 ||
+        !toDataType(input_dtypes[i], typed_inputs[i].dtype)) {
+      LOG(ERROR) << "[CochlApi_RunMultiTyped] Invalid shape or type of input " << i;
+      return 0;
+    }
+    typed_inputs[i].data = inputs[i];
+    typed_inputs[i].shape.assign(input_shapes[i], input_shapes[i] + shape_sizes[i]);
+    typed_inputs[i].layout = api->getInputLayout();
+  }
+
+  std::vector<cochl_api::runtime::OutputTensor> typed_outputs(num_outputs);
+  for (size_t i = 0; i < num_outputs; ++i) {
+    if (!toDataType(output_dtypes[i], typed_outputs[i].dtype)) {
+      LOG(ERROR) << "[CochlApi_RunMultiTyped] Unknown type of output " << i;
+      return 0;
+    }
+    typed_outputs[i].data = outputs[i];
+  }
+
+  return api->runTyped(typed_inputs, typed_outputs) ? 1 : 0;
+}
+
+static_assert(COCHL_TENSOR_ALIGNMENT == cochl_api::runtime::kTensorAlignment,
+              "COCHL_TENSOR_ALIGNMENT must match cochl_api::runtime::kTensorAlignment");
+
+int CochlApi_BindBuffers(void* instance, const void* const* inputs, const int* input_dtypes,
+                         const long long* const* input_shapes, const size_t* shape_sizes,
+                         size_t num_inputs, void* const* outputs, const int* output_dtypes,
+                         size_t num_outputs) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_BindBuffers] NULL instance";
+    return 0;
+  }
+
+  if (!inputs || !input_dtypes || !input_shapes || !shape_sizes || num_inputs == 0 || !outputs ||
+      !output_dtypes || num_outputs == 0) {
+    LOG(ERROR) << "[CochlApi_BindBuffers] Invalid inputs or outputs";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  std::vector<cochl_api::runtime::InputTensor> bound_inputs(num_inputs);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    if (!input_shapes[i] || shape_sizes[i] == 0 ||
+        !toDataType(input_dtypes[i], bound_inputs[i].dtype)) {
+      LOG(ERROR) << "[CochlApi_BindBuffers] Invalid shape or type of input " << i;
+      return 0;
+    }
+    bound_inputs[i].data = inputs[i];
+    bound_inputs[i].shape.assign(input_shapes[i], input_shapes[i] + shape_sizes[i]);
+    bound_inputs[i].layout = api->getInputLayout();
+  }
+
+  std::vector<cochl_api::runtime::OutputTensor> bound_outputs(num_outputs);
+  for (size_t i = 0; i < num_outputs; ++i) {
+    if (!toDataType(output_dtypes[i], bound_outputs[i].dtype)) {
+      LOG(ERROR) << "[CochlApi_BindBuffers] Unknown type of output " << i;
+      return 0;
+    }
+    bound_outputs[i].data = outputs[i];
+  }
+
+  return api->bindBuffers(bound_inputs, bound_outputs) ? 1 : 0;
+}
+
+int CochlApi_RunBound(void* instance) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_RunBound] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->runBound() ? 1 : 0;
+}
+
+void CochlApi_UnbindBuffers(void* instance) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_UnbindBuffers] NULL instance";
+    return;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  api->unbindBuffers();
+}
+
+int CochlApi_IsZeroCopyBound(void* instance) {
+  if (!instance) {
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->isZeroCopyBound() ? 1 : 0;
+}
+
+int CochlApi_RunCascade(void* instance, const float* input, const long long* input_shape,
+                        size_t shape_size, float* output, size_t* stage) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_RunCascade] NULL instance";
+    return 0;
+  }
+
+  if (!input_shape || shape_size == 0) {
+    LOG(ERROR) << "[CochlApi_RunCascade] Invalid input shape";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  std::vector<int64_t> shape(input_shape, input_shape + shape_size);
+  return api->runCascade(input, shape, output, stage) ? 1 : 0;
+}
+
+size_t CochlApi_GetNumStages(void* instance) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetNumStages] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->getNumStages();
+}
+
+int CochlApi_GetCascadeStats(void* instance, size_t stage, unsigned long long* runs,
+                             unsigned long long* answered, double* mean_ms) {
+  if (!instance || !runs || !answered || !mean_ms) {
+    LOG(ERROR) << "[CochlApi_GetCascadeStats] Invalid parameters";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  std::vector<cochl_api::runtime::CascadeStageStats> stats = api->getCascadeStats();
+  if (stage >= stats.size()) {
+    return 0;
+  }
+
+  *runs = stats[stage].runs;
+  *answered = stats[stage].answered;
+  *mean_ms = stats[stage].meanLatencyMs();
+  return 1;
+}
+
+int CochlApi_GetInputDataType(void* instance, size_t index) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetInputDataType] NULL instance";
+    return -1;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  if (index >= api->getNumInputs()) {
+    return -1;
+  }
+  return static_cast<int>(api->getInputDataType(index));
+}
+
+int CochlApi_GetOutputDataType(void* instance, size_t index) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetOutputDataType] NULL instance";
+    return -1;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  if (index >= api->getNumOutputs()) {
+    return -1;
+  }
+  return static_cast<int>(api->getOutputDataType(index));
+}
+
+int CochlApi_GetPreferredLayout(void* instance) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetPreferredLayout] NULL instance";
+    return COCHL_LAYOUT_NCHW;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return static_cast<int>(api->getPreferredLayout());
+}
+
+int CochlApi_SetInputLayout(void* instance, int layout) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_SetInputLayout] NULL instance";
+    return 0;
+  }
+
+  cochl_api::runtime::TensorLayout tensor_layout;
+  if (!toTensorLayout(layout, tensor_layout)) {
+    LOG(ERROR) << "[CochlApi_SetInputLayout] Unknown layout: " << layout;
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  api->setInputLayout(tensor_layout);
+  return 1;
+}
+
+size_t CochlApi_GetNumInputs(void* instance) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetNumInputs] NULL instance";
+    return 0;
+  }
+
+  return static_cast<external_api::CochlApi*>(instance)->getNumInputs();
+}
+
+size_t CochlApi_GetNumOutputs(void* instance) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetNumOutputs] NULL instance";
+    return 0;
+  }
+
+  return static_cast<external_api::CochlApi*>(instance)->getNumOutputs();
+}
+
+int CochlApi_GetInputIndex(void* instance, const char* name) {
+  if (!instance || !name) {
+    LOG(ERROR) << "[CochlApi_GetInputIndex] NULL instance or name";
+    return -1;
+  }
+
+  return static_cast<external_api::CochlApi*>(instance)->getInputIndex(name);
+}
+
+int CochlApi_GetOutputIndex(void* instance, const char* name) {
+  if (!instance || !name) {
+    LOG(ERROR) << "[CochlApi_GetOutputIndex] NULL instance or name";
+    return -1;
+  }
+
+  return static_cast<external_api::CochlApi*>(instance)->getOutputIndex(name);
+}
+
+static size_t copyName(const std::string& tensor_name, char* name, size_t name_size) {
+  if (name && name_size > 0) {
+    size_t length = std::min(tensor_name.size(), name_size - 1);
+    tensor_name.copy(name, length);
+    name[length] = '\0';
+  }
+  return tensor_name.size();
+}
+
+size_t CochlApi_GetInputName(void* instance, size_t index, char* name, size_t name_size) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetInputName] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return copyName(api->getInputName(index), name, name_size);
+}
+
+size_t CochlApi_GetOutputName(void* instance, size_t index, char* name, size_t name_size) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetOutputName] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return copyName(api->getOutputName(index), name, name_size);
+}
+
+size_t CochlApi_GetInputShapeAt(void* instance, size_t index, long long* shape, size_t max_dims) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetInputShapeAt] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  std::vector<int64_t> input_shape = api->getInputShape(index);
+  for (size_t i = 0; shape && i < input_shape.size() && i < max_dims; ++i) {
+    shape[i] = input_shape[i];
+  }
+  return input_shape.size();
+}
+
+size_t CochlApi_GetOutputSizeAt(void* instance, size_t index) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetOutputSizeAt] NULL instance";
+    return 0;
+  }
+
+  return static_cast<external_api::CochlApi*>(instance)->getOutputSize(index);
+}
+
+int CochlApi_EnableBatching(void* instance, size_t max_batch_size, unsigned int max_delay_us) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_EnableBatching] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->enableBatching(max_batch_size, std::chrono::microseconds(max_delay_us)) ? 1 : 0;
+}
+
+int CochlApi_SwapModel(void* instance, const char* model_path,
+                       const long long* warmup_shape, size_t shape_size) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_SwapModel] NULL instance";
+    return 0;
+  }
+
+  if (!model_path) {
+    LOG(ERROR) << "[CochlApi_SwapModel] NULL model path";
+    return 0;
+  }
+
+  std::vector<int64_t> shape_vec;
+  if (warmup_shape && shape_size > 0) {
+    shape_vec.assign(warmup_shape, warmup_shape + shape_size);
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->swapModel(std::string(model_path), shape_vec) ? 1 : 0;
+}
+
+int CochlApi_SetMaxInstances(void* instance, size_t max_instances) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_SetMaxInstances] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->setMaxInstances(max_instances) ? 1 : 0;
+}
+
+int CochlApi_SetResultCache(void* instance, size_t max_bytes) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_SetResultCache] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->setResultCache(max_bytes) ? 1 : 0;
+}
+
+int CochlApi_GetResultCacheStats(void* instance, unsigned long long* hits,
+                                 unsigned long long* misses, size_t* bytes) {
+  if (!instance || !hits || !misses) {
+    LOG(ERROR) << "[CochlApi_GetResultCacheStats] Invalid parameters";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  cochl_api::runtime::ResultCacheStats stats = api->getResultCacheStats();
+  *hits = stats.hits;
+  *misses = stats.misses;
+  if (bytes) {
+    *bytes = stats.bytes;
+  }
+  return 1;
+}
+
+int CochlApi_GetWarmupLatency(void* instance, double* cold_ms, double* warm_ms) {
+  if (!instance || !cold_ms || !warm_ms) {
+    LOG(ERROR) << "[CochlApi_GetWarmupLatency] Invalid parameters";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->getWarmupLatency(*cold_ms, *warm_ms) ? 1 : 0;
+}
+
+size_t CochlApi_PrepareShape(void* instance, const long long* input_shape, size_t shape_size) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_PrepareShape] NULL instance";
+    return 0;
+  }
+
+  if (!input_shape || shape_size == 0) {
+    LOG(ERROR) << "[CochlApi_PrepareShape] Invalid input shape";
+    return 0;
+  }
+
+  std::vector<int64_t> shape_vec(input_shape, input_shape + shape_size);
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->prepareShape(shape_vec);
+}
+
 size_t CochlApi_GetInputSize(void* instance) {
   if (!instance) {
     return 0;
@@ -74,30 +654,147 @@ void CochlApi_Destroy(void* instance) {
   delete api;
 }
 
+static bool toThreadAffinity(int policy, const int* cpus, size_t num_cpus,
+                             cochl_api::runtime::ThreadAffinity& affinity) {
+  using cochl_api::runtime::AffinityPolicy;
+
+  switch (policy) {
+    case COCHL_AFFINITY_NONE:
+      affinity.policy = AffinityPolicy::NONE;
+      return true;
+    case COCHL_AFFINITY_PERFORMANCE_CORES:
+      affinity.policy = AffinityPolicy::PERFORMANCE_CORES;
+      return true;
+    case COCHL_AFFINITY_PHYSICAL_CORES:
+      affinity.policy = AffinityPolicy::PHYSICAL_CORES;
+      return true;
+    case COCHL_AFFINITY_EXPLICIT:
+      if (!cpus || num_cpus == 0) {
+        LOG(ERROR) << "[CochlApi] Explicit affinity policy requires a cpu list";
+        return false;
+      }
+      affinity.policy = AffinityPolicy::EXPLICIT;
+      affinity.cpus.assign(cpus, cpus + num_cpus);
+      return true;
+    default:
+      LOG(ERROR) << "[CochlApi] Unknown affinity policy: " << policy;
+      return false;
+  }
+}
+
+int CochlApi_SetThreadAffinity(int policy, const int* cpus, size_t num_cpus) {
+  cochl_api::runtime::ThreadAffinity affinity;
+  if (!toThreadAffinity(policy, cpus, num_cpus, affinity)) {
+    return 0;
+  }
+
+  cochl_api::runtime::ComputePool::instance().setThreadAffinity(affinity);
+  return 1;
+}
+
+int CochlApi_SetCpuPartition(void* instance, int policy, const int* cpus, size_t num_cpus) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_SetCpuPartition] NULL instance";
+    return 0;
+  }
+
+  cochl_api::runtime::ThreadAffinity affinity;
+  if (!toThreadAffinity(policy, cpus, num_cpus, affinity)) {
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->setCpuPartition(affinity) ? 1 : 0;
+}
+
+int CochlApi_SetCpuShare(void* instance, size_t index, size_t count) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_SetCpuShare] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  return api->setCpuShare(index, count) ? 1 : 0;
+}
+
+size_t CochlApi_GetCpuPartition(void* instance, int* cpus, size_t max_cpus) {
+  if (!instance) {
+    LOG(ERROR) << "[CochlApi_GetCpuPartition] NULL instance";
+    return 0;
+  }
+
+  auto* api = static_cast<external_api::CochlApi*>(instance);
+  std::vector<int> partition = api->getCpuPartition();
+  if (cpus) {
+    std::copy_n(partition.begin(), std::min(max_cpus, partition.size()), cpus);
+  }
+  return partition.size();
+}
+
+void CochlApi_SetThreadBudget(size_t num_threads) {
+  cochl_api::runtime::ComputePool::instance().setThreadBudget(num_threads);
+}
+
+size_t CochlApi_GetThreadBudget(void) {
+  return cochl_api::runtime::ComputePool::instance().getThreadBudget();
+}
+
+void CochlApi_SetMemoryBudget(size_t max_bytes) {
+  cochl_api::runtime::ModelResidency::instance().setBudget(max_bytes);
+}
+
+int CochlApi_GetResidencyStats(size_t* resident_bytes, size_t* resident_models,
+                               size_t* evicted_models, unsigned long long* evictions,
+                               unsigned long long* reloads) {
+  if (!resident_bytes || !resident_models || !evicted_models || !evictions || !reloads) {
+    LOG(ERROR) << "[CochlApi_GetResidencyStats] Invalid parameters";
+    return 0;
+  }
+
+  cochl_api::runtime::ResidencyStats stats =
+      cochl_api::runtime::ModelResidency::instance().getStats();
+  *resident_bytes = stats.resident_bytes;
+  *resident_models = stats.resident_models;
+  *evicted_models = stats.evicted_models;
+  *evictions = stats.evictions;
+  *reloads = stats.reloads;
+  return 1;
+}
+
+void CochlApi_SetWarmup(size_t max_runs, unsigned int budget_ms) {
+  cochl_api::runtime::WarmupOptions options = cochl_api::runtime::RuntimeManager::getWarmupOptions();
+  options.max_runs = max_runs;
+  options.budget = std::chrono::milliseconds(budget_ms);
+  cochl_api::runtime::RuntimeManager::setWarmupOptions(options);
+}
+
 int CochlApi_LoadImage(const char* image_path, float* output_data, size_t output_size) {
-  if (!image_path || !output_data || output_size == 0) {
+  return CochlApi_LoadImageLayout(image_path, COCHL_LAYOUT_NCHW, output_data, output_size);
+}
+
+int CochlApi_LoadImageLayout(const char* image_path, int layout, float* output_data,
+                             size_t output_size) {
+  cochl_api::runtime::TensorLayout tensor_layout;
+  if (!image_path || !output_data || output_size == 0 || !toTensorLayout(layout, tensor_layout)) {
     LOG(ERROR) << "[CochlApi_LoadImage] Invalid parameters";
     return 0;
   }
 
-  // Load and preprocess image
-  auto input_hwc = cochl_api::utils::LoadAndPreprocessImage(std::string(image_path));
-  if (input_hwc.empty()) {
+  // Load and preprocess straight into the requested layout
+  auto input = cochl_api::utils::LoadAndPreprocessImage(std::string(image_path), tensor_layout);
+  if (input.empty()) {
     LOG(ERROR) << "[CochlApi_LoadImage] Failed to load image: " << image_path;
     return 0;
   }
 
-  // Convert HWC to NCHW
-  auto input_nchw = cochl_api::utils::HWCToNCHW(input_hwc, 224, 224, 3);
-
-  if (input_nchw.size() != output_size) {
+  if (input.size() != output_size) {
     LOG(ERROR) << "[CochlApi_LoadImage] Size mismatch. Expected: " << output_size
-              << ", Got: " << input_nchw.size();
+              << ", Got: " << input.size();
     return 0;
   }
 
   // Copy to output buffer
-  std::copy(input_nchw.begin(), input_nchw.end(), output_data);
+  std::copy(input.begin(), input.end(), output_data);
   return 1;
 }
 
@@ -0,0 +1,301 @@
+#include "runtime/auto_tuner.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#include <glog/logging.h>
+
+#include "runtime/compute_pool.h"
+#include "runtime/model_registry.h"
+#include "utils/hash.h"
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+std::string toHex(uint64_t value) {
+  char hex[17];
+  std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(value));
+  return hex;
+}
+
+// First "model name" (x86) or "Hardware"/"CPU part" (ARM) line of /proc/cpuinfo
+std::string cpuModelName() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  std::string fallback;
+  while (std::getline(cpuinfo, line)) {
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) continue;
+    std::string field = line.substr(0, line.find_last_not_of(" \t", colon - 1) + 1);
+    std::string value = line.substr(std::min(colon + 2, line.size()));
+    if (field == "model name") {
+      return value;
+    }
+    if (fallback.empty() && (field == "Hardware" || field == "CPU part")) {
+      fallback = value;
+    }
+  }
+  return fallback;
+}
+
+}  // namespace
+
+AutoTuner::AutoTuner(const TuningOptions& options) : options_(options) {
+  options_.timed_runs = std::max<size_t>(1, options_.timed_runs);
+}
+
+std::vector<size_t> AutoTuner::threadCounts() const {
+  if (!options_.thread_counts.empty()) {
+    return options_.thread_counts;
+  }
+
+  // Powers of two up to the budget, and the budget itself
+  size_t budget = ComputePool::instance().getThreadBudget();
+  std::vector<size_t> counts;
+  for (size_t n = 1; n < budget; n *= 2) {
+    counts.push_back(n);
+  }
+  counts.push_back(budget);
+  return counts;
+}
+
+double AutoTuner::benchmark(IRuntime& runtime) const {
+  std::vector<int64_t> shape = runtime.getInputShape();
+  if (shape.empty()) {
+    return -1.0;
+  }
+
+  size_t input_size = 1;
+  for (auto dim : shape) {
+    input_size *= static_cast<size_t>(std::max<int64_t>(dim, 1));
+  }
+
+  // Non-constant input so backends cannot take shortcuts on zeros
+  std::vector<float> input(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    input[i] = static_cast<float>(i % 255) / 255.0f;
+  }
+  std::vector<float> output(runtime.getOutputSize() * static_cast<size_t>(std::max<int64_t>(shape[0], 1)));
+
+  for (size_t i = 0; i < options_.warmup_runs; ++i) {
+    if (!runtime.runInference(input.data(), shape, output.data())) {
+      return -1.0;
+    }
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(options_.timed_runs);
+  for (size_t i = 0; i < options_.timed_runs; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    if (!runtime.runInference(input.data(), shape, output.data())) {
+      return -1.0;
+    }
+    auto end = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+  }
+
+  // Median: robust against the odd preempted run
+  std::nth_element(latencies.begin(), latencies.begin() + latencies.size() / 2, latencies.end());
+  return latencies[latencies.size() / 2];
+}
+
+bool AutoTuner::tune(const std::vector<Candidate>& candidates, TuningResult& result) const {
+  if (candidates.empty()) {
+    return false;
+  }
+
+  std::string key;
+  if (options_.use_cache) {
+    key = cacheKey(candidates);
+    if (!key.empty() && loadCached(key, candidates, result)) {
+      LOG(INFO) << "[AutoTuner] Cached choice: " << candidates[result.candidate].name << " with "
+                << result.num_threads << " threads (" << result.latency_ms << " ms)";
+      return true;
+    }
+  }
+
+  // Thread counts are per instance, so the sweep leaves other runtimes alone
+  std::vector<size_t> counts = threadCounts();
+
+  bool found = false;
+  double best_ms = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const Candidate& candidate = candidates[i];
+    std::unique_ptr<IRuntime> runtime = candidate.create ? candidate.create() : nullptr;
+    if (!runtime || !runtime->loadModel(candidate.model_path.c_str())) {
+      LOG(WARNING) << "[AutoTuner] Skipping " << candidate.name << ": cannot load "
+                   << candidate.model_path;
+      continue;
+    }
+
+    for (size_t num_threads : counts) {
+      bool adjustable = runtime->setNumThreads(num_threads);
+      double ms = benchmark(*runtime);
+      if (!adjustable) {
+        num_threads = 0;
+      }
+
+      if (ms < 0) {
+        LOG(WARNING) << "[AutoTuner] " << candidate.name << " failed to run the benchmark";
+        break;
+      }
+
+      LOG(INFO) << "[AutoTuner] " << candidate.name << " threads=" << num_threads << ": " << ms
+                << " ms";
+      if (ms < best_ms) {
+        best_ms = ms;
+        result.candidate = i;
+        result.num_threads = num_threads;
+        result.latency_ms = ms;
+        result.cached = false;
+        found = true;
+      }
+
+      // One measurement is all there is for a backend with a fixed thread count
+      if (!adjustable) break;
+    }
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  LOG(INFO) << "[AutoTuner] Fastest: " << candidates[result.candidate].name << " with "
+            << result.num_threads << " threads (" << result.latency_ms << " ms)";
+
+  if (!key.empty()) {
+    storeCached(key, candidates, result);
+  }
+  return true;
+}
+
+std::string AutoTuner::hostKey() {
+  std::ostringstream host;
+  host << cpuModelName() << "/" << std::thread::hardware_concurrency();
+  for (const auto& core : CpuTopology::get().cores()) {
+    host << "/" << core.capacity;
+  }
+
+  std::string text = host.str();
+  return toHex(utils::Hash64(text.data(), text.size()));
+}
+
+std::string AutoTuner::cachePath() {
+  std::string base;
+  if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+    base = xdg;
+  }
+  if (base.empty()) {
+    const char* home = std::getenv("HOME");
+    if (!home || !*home) {
+      return "";
+    }
+    base = std::string(home) + "/.cache";
+  }
+  return base + "/cochl/autotune.tsv";
+}
+
+std::string AutoTuner::cacheKey(const std::vector<Candidate>& candidates) {
+  // A re-exported model or a different set of compiled backends invalidates the decision
+  uint64_t hash = 0;
+  for (const auto& candidate : candidates) {
+    std::string model_key = ModelRegistry::makeKey(candidate.model_path);
+    if (model_key.empty()) {
+      return "";
+    }
+    std::string entry = candidate.name + "=" + model_key;
+    hash = utils::Hash64(entry.data(), entry.size(), hash);
+  }
+  return hostKey() + "-" + toHex(hash);
+}
+
+bool AutoTuner::loadCached(const std::string& key, const std::vector<Candidate>& candidates,
+                           TuningResult& result) {
+  std::string path = cachePath();
+  if (path.empty()) {
+    return false;
+  }
+
+  // One decision per line: key, backend name, threads, latency
+  std::ifstream cache(path);
+  std::string line;
+  while (std::getline(cache, line)) {
+    std::istringstream fields(line);
+    std::string line_key, name;
+    size_t num_threads = 0;
+    double latency_ms = 0.0;
+    if (!(fields >> line_key >> name >> num_threads >> latency_ms) || line_key != key) {
+      continue;
+    }
+
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      if (candidates[i].name == name) {
+        result.candidate = i;
+        result.num_threads = num_threads;
+        result.latency_ms = latency_ms;
+        result.cached = true;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void AutoTuner::storeCached(const std::string& key, const std::vector<Candidate>& candidates,
+                            const TuningResult& result) {
+  std::string path = cachePath();
+  if (path.empty()) {
+    return;
+  }
+
+  // mkdir -p of the cache directory
+  for (size_t slash = path.find('/', 1); slash != std::string::npos;
+       slash = path.find('/', slash + 1)) {
+    mkdir(path.substr(0, slash).c_str(), 0755);
+  }
+
+  std::vector<std::string> lines;
+  {
+    std::ifstream cache(path);
+    std::string line;
+    while (std::getline(cache, line)) {
+      if (line.compare(0, key.size() + 1, key + "\t") != 0) {
+        lines.push_back(line);
+      }
+    }
+  }
+
+  // Write aside and rename, so concurrent processes never read a partial file
+  std::string tmp_path = path + "." + std::to_string(getpid());
+  {
+    std::ofstream cache(tmp_path, std::ios::trunc);
+    for (const auto& line : lines) {
+      cache << line << "\n";
+    }
+    cache << key << "\t" << candidates[result.candidate].name << "\t" << result.num_threads
+          << "\t" << result.latency_ms << "\n";
+    if (!cache) {
+      LOG(WARNING) << "[AutoTuner] Cannot write tuning cache: " << tmp_path;
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "[AutoTuner] Cannot update tuning cache: " << path;
+    std::remove(tmp_path.c_str());
+  }
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
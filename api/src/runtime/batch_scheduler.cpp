@@ -0,0 +1,181 @@
+#include "runtime/batch_scheduler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+
+#include <glog/logging.h>
+
+namespace cochl_api {
+namespace runtime {
+
+BatchScheduler::BatchScheduler(BatchFunction run_batch, size_t output_size,
+                               const BatchOptions& options)
+    : run_batch_(std::move(run_batch)),
+      output_size_(output_size),
+      options_(options),
+      stop_(false),
+      collecting_(false),
+      in_flight_(0) {
+  options_.max_batch_size = std::max<size_t>(1, options_.max_batch_size);
+  setMaxInFlight(options_.max_in_flight);
+
+  LOG(INFO) << "[BatchScheduler] Batching up to " << options_.max_batch_size << " requests within "
+            << options_.max_delay.count() << " us, " << options_.max_in_flight
+            << " batches at once";
+}
+
+BatchScheduler::~BatchScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (auto& dispatcher : dispatchers_) {
+    dispatcher.join();
+  }
+}
+
+void BatchScheduler::setMaxInFlight(size_t max_in_flight) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_.max_in_flight = std::max<size_t>(1, max_in_flight);
+    while (dispatchers_.size() < options_.max_in_flight) {
+      dispatchers_.emplace_back([this]() { dispatchLoop(); });
+    }
+  }
+  condition_.notify_all();
+}
+
+BatchOptions BatchScheduler::getOptions() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return options_;
+}
+
+bool BatchScheduler::run(const float* input, const std::vector<int64_t>& input_shape,
+                         float* output) {
+  if (!input || !output || input_shape.empty() || input_shape[0] != 1) {
+    LOG(ERROR) << "[BatchScheduler] Expected one sample with a leading batch dimension of 1";
+    return false;
+  }
+
+  size_t input_size = 1;
+  for (auto dim : input_shape) {
+    input_size *= static_cast<size_t>(dim);
+  }
+
+  Request request{input, &input_shape, input_size, output, std::chrono::steady_clock::now(), {}};
+  std::future<bool> done = request.done.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) {
+      return false;
+    }
+    queue_.push_back(&request);
+  }
+  // The collecting dispatcher and idle ones wait on the same condition
+  condition_.notify_all();
+
+  // The request lives on this stack frame until the dispatcher has scattered its result
+  return done.get();
+}
+
+BatchStats BatchScheduler::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void BatchScheduler::dispatchLoop() {
+  std::vector<float> batch_inputs;
+  std::vector<float> batch_outputs;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Collect only with a slot free to execute the batch, and one window at a time
+    condition_.wait(lock, [this]() {
+      return (stop_ && queue_.empty()) ||
+             (!queue_.empty() && !collecting_ && in_flight_ < options_.max_in_flight);
+    });
+    if (queue_.empty()) {
+      return;
+    }
+    collecting_ = true;
+
+    // Keep the window open until it fills or the oldest request runs out of slack
+    auto deadline = queue_.front()->enqueued + options_.max_delay;
+    condition_.wait_until(lock, deadline, [this]() {
+      return stop_ || queue_.size() >= options_.max_batch_size;
+    });
+
+    // Requests of another shape stay queued for the next batch
+    std::vector<Request*> batch;
+    const std::vector<int64_t>& shape = *queue_.front()->shape;
+    for (auto it = queue_.begin(); it != queue_.end() && batch.size() < options_.max_batch_size;) {
+      if (*(*it)->shape == shape) {
+        batch.push_back(*it);
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    // Another dispatcher opens the next window while this batch executes
+    collecting_ = false;
+    ++in_flight_;
+    lock.unlock();
+    condition_.notify_all();
+    execute(batch, batch_inputs, batch_outputs);
+    lock.lock();
+    --in_flight_;
+    condition_.notify_all();
+  }
+}
+
+void BatchScheduler::execute(std::vector<Request*>& batch, std::vector<float>& batch_inputs,
+                             std::vector<float>& batch_outputs) {
+  const size_t batch_size = batch.size();
+  const size_t input_size = batch.front()->input_size;
+  const std::vector<int64_t>& shape = *batch.front()->shape;
+
+  bool success = false;
+  try {
+    if (batch_size == 1) {
+      // Nothing to coalesce: run in place without staging copies
+      success = run_batch_(batch.front()->input, 1, shape, batch.front()->output);
+    } else {
+      batch_inputs.resize(batch_size * input_size);
+      batch_outputs.resize(batch_size * output_size_);
+      for (size_t n = 0; n < batch_size; ++n) {
+        std::memcpy(batch_inputs.data() + n * input_size, batch[n]->input,
+                    input_size * sizeof(float));
+      }
+
+      success = run_batch_(batch_inputs.data(), batch_size, shape, batch_outputs.data());
+
+      if (success) {
+        for (size_t n = 0; n < batch_size; ++n) {
+          std::memcpy(batch[n]->output, batch_outputs.data() + n * output_size_,
+                      output_size_ * sizeof(float));
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "[BatchScheduler] Batch failed: " << e.what();
+    success = false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.requests += batch_size;
+    stats_.batches += 1;
+    stats_.max_batch = std::max(stats_.max_batch, batch_size);
+  }
+
+  // Waking the callers ends the lifetime of their requests
+  for (Request* request : batch) {
+    request->done.set_value(success);
+  }
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
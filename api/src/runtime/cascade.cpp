@@ -0,0 +1,185 @@
+#include "runtime/cascade.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <glog/logging.h>
+
+#include "error/api_error.h"
+#include "runtime/runtime_manager.h"
+
+namespace cochl_api {
+namespace runtime {
+
+float topConfidence(const float* output, size_t count, ConfidenceMode mode) {
+  if (!output || count == 0) {
+    return 0.0f;
+  }
+
+  float top = *std::max_element(output, output + count);
+  switch (mode) {
+    case ConfidenceMode::SOFTMAX: {
+      // exp(top) / sum(exp(x)), shifted by top so nothing overflows
+      float sum = 0.0f;
+      for (size_t i = 0; i < count; ++i) {
+        sum += std::exp(output[i] - top);
+      }
+      return 1.0f / sum;
+    }
+    case ConfidenceMode::SIGMOID:
+      return 1.0f / (1.0f + std::exp(-top));
+    case ConfidenceMode::PROBABILITY:
+      return top;
+  }
+  return top;
+}
+
+ModelCascade::ModelCascade(const RuntimeManager& first, float first_threshold,
+                           std::vector<std::unique_ptr<RuntimeManager>> next,
+                           const std::vector<float>& next_thresholds, ConfidenceMode mode)
+    : owned_(std::move(next)), mode_(mode) {
+  stages_.push_back({&first, first_threshold});
+  for (size_t i = 0; i < owned_.size(); ++i) {
+    stages_.push_back({owned_[i].get(), i < next_thresholds.size() ? next_thresholds[i] : 0.0f});
+  }
+  stats_.resize(stages_.size());
+}
+
+ModelCascade::~ModelCascade() = default;
+
+std::unique_ptr<ModelCascade> ModelCascade::create(const RuntimeManager& first,
+                                                   const std::vector<CascadeStage>& stages,
+                                                   ConfidenceMode mode) {
+  if (stages.empty()) {
+    error::printError(error::ApiError::INVALID_PARAMETER, "Cascade without stages");
+    return nullptr;
+  }
+
+  std::vector<std::unique_ptr<RuntimeManager>> next;
+  std::vector<float> next_thresholds;
+  for (size_t i = 1; i < stages.size(); ++i) {
+    auto manager = RuntimeManager::create(stages[i].model_path);
+    if (!manager) {
+      error::printError(error::ApiError::MODEL_LOAD_FAILED, stages[i].model_path);
+      return nullptr;
+    }
+
+    // Every stage fills the same output buffer from the same input
+    if (manager->getInputSize() != first.getInputSize() ||
+        manager->getOutputSize() != first.getOutputSize()) {
+      error::printError(error::ApiError::INVALID_INPUT_SIZE,
+                        "Cascade stage " + stages[i].model_path +
+                            " does not match the first stage's input/output sizes");
+      return nullptr;
+    }
+    next.push_back(std::move(manager));
+    next_thresholds.push_back(stages[i].threshold);
+  }
+
+  LOG(INFO) << "[ModelCascade] " << stages.size() << " stages, first: " << stages[0].model_path;
+  return std::unique_ptr<ModelCascade>(
+      new ModelCascade(first, stages[0].threshold, std::move(next), next_thresholds, mode));
+}
+
+bool ModelCascade::run(const float* input, const std::vector<int64_t>& input_shape, float* output,
+                       size_t* last_stage) const {
+  if (input_shape.empty() || input_shape[0] <= 0) {
+    return false;
+  }
+
+  const size_t batch = static_cast<size_t>(input_shape[0]);
+  size_t input_count = 1;
+  for (auto dim : input_shape) {
+    input_count *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+  }
+  const size_t sample_in = input_count / batch;
+  const size_t sample_out = stages_[0].manager->getOutputSize();
+
+  // Samples still unanswered, as indices into the caller's batch
+  std::vector<size_t> pending(batch);
+  for (size_t i = 0; i < batch; ++i) {
+    pending[i] = i;
+  }
+
+  std::vector<float> gathered_in;
+  std::vector<float> gathered_out;
+  // runInference() writes one sample's output; every stage runs as a batch of single samples
+  std::vector<int64_t> sample_shape = input_shape;
+  sample_shape[0] = 1;
+  size_t stage = 0;
+  for (; stage < stages_.size(); ++stage) {
+    const Stage& current = stages_[stage];
+    const bool whole_batch = pending.size() == batch;
+
+    // The first stage reads the caller's buffers; later ones only the escalated samples
+    const float* stage_in = input;
+    float* stage_out = output;
+    if (!whole_batch) {
+      gathered_in.resize(pending.size() * sample_in);
+      gathered_out.resize(pending.size() * sample_out);
+      for (size_t i = 0; i < pending.size(); ++i) {
+        std::memcpy(gathered_in.data() + i * sample_in, input + pending[i] * sample_in,
+                    sample_in * sizeof(float));
+      }
+      stage_in = gathered_in.data();
+      stage_out = gathered_out.data();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!current.manager->runBatch(stage_in, pending.size(), sample_shape, stage_out)) {
+      return false;
+    }
+    double elapsed_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (!whole_batch) {
+      for (size_t i = 0; i < pending.size(); ++i) {
+        std::memcpy(output + pending[i] * sample_out, stage_out + i * sample_out,
+                    sample_out * sizeof(float));
+      }
+    }
+
+    // Keep the samples this stage is not confident about for the next one
+    const bool last = stage + 1 == stages_.size();
+    std::vector<size_t> escalated;
+    if (!last) {
+      for (size_t i = 0; i < pending.size(); ++i) {
+        if (topConfidence(stage_out + i * sample_out, sample_out, mode_) < current.threshold) {
+          escalated.push_back(pending[i]);
+        }
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      CascadeStageStats& stats = stats_[stage];
+      stats.runs += pending.size();
+      stats.answered += pending.size() - escalated.size();
+      stats.total_ms += elapsed_ms;
+    }
+
+    if (escalated.empty()) {
+      break;
+    }
+    pending.swap(escalated);
+  }
+
+  if (last_stage) {
+    *last_stage = stage;
+  }
+  return true;
+}
+
+std::vector<CascadeStageStats> ModelCascade::getStats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
+}
+
+void ModelCascade::resetStats() {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_.assign(stages_.size(), CascadeStageStats());
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,105 @@
+#include "runtime/compute_pool.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include <glog/logging.h>
+
+namespace cochl_api {
+namespace runtime {
+
+ComputePool& ComputePool::instance() {
+  static ComputePool pool;
+  return pool;
+}
+
+ComputePool::ComputePool()
+    : affinity_(getDefaultThreadAffinity()), thread_budget_(0), next_reservation_(1) {
+  thread_budget_ = defaultBudget();
+}
+
+size_t ComputePool::defaultBudget() const {
+  // Budget follows the cpus the workers may run on
+  size_t allowed = CpuTopology::get().resolve(affinity_).size();
+  if (allowed == 0) {
+    allowed = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return allowed;
+}
+
+std::shared_ptr<ThreadPool> ComputePool::getThreadPool() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!thread_pool_) {
+    thread_pool_ = std::make_shared<ThreadPool>(thread_budget_, affinity_);
+    rebalanceLocked(false);
+    LOG(INFO) << "[ComputePool] Shared thread pool created with "
+              << thread_pool_->GetNumThreads() << " of " << thread_budget_ << " threads";
+  }
+  return thread_pool_;
+}
+
+size_t ComputePool::getThreadBudget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return thread_budget_;
+}
+
+void ComputePool::setThreadBudget(size_t num_threads) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  thread_budget_ = num_threads > 0 ? num_threads : defaultBudget();
+
+  // Resize in place: in-flight ParallelFor calls keep running on the same pool
+  rebalanceLocked(true);
+  LOG(INFO) << "[ComputePool] Thread budget set to " << thread_budget_;
+}
+
+void ComputePool::setThreadAffinity(const ThreadAffinity& affinity) {
+  setDefaultThreadAffinity(affinity);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  affinity_ = affinity;
+  thread_budget_ = defaultBudget();
+
+  // Re-pinning needs fresh workers; in-flight users keep the old pool alive until they finish
+  thread_pool_.reset();
+  rebalanceLocked(true);
+}
+
+uint64_t ComputePool::acquireBackendThreads(ShareListener listener) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t reservation = next_reservation_++;
+  backend_pools_.emplace(reservation, BackendPool{std::move(listener), 0});
+  rebalanceLocked(false);
+  return reservation;
+}
+
+void ComputePool::releaseBackendThreads(uint64_t reservation) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (backend_pools_.erase(reservation) > 0) {
+    rebalanceLocked(false);
+  }
+}
+
+void ComputePool::rebalanceLocked(bool budget_changed) {
+  size_t consumers = backend_pools_.size() + (thread_pool_ ? 1 : 0);
+  if (consumers == 0) {
+    return;
+  }
+
+  // Parking workers of the shared pool is cheap, so it always follows its share
+  size_t share = std::max<size_t>(1, thread_budget_ / consumers);
+  if (thread_pool_) {
+    thread_pool_->Resize(share);
+  }
+  for (auto& backend_pool : backend_pools_) {
+    BackendPool& pool = backend_pool.second;
+    bool far = pool.share == 0 || share * 2 <= pool.share || share >= pool.share * 2;
+    if (budget_changed || far) {
+      pool.share = share;
+      pool.listener(share);
+    }
+  }
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,308 @@
+#include "runtime/cpu_topology.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+constexpr int kMaxCapacity = 1024;
+
+bool readInt(const std::string& path, long& value) {
+  std::ifstream file(path);
+  return static_cast<bool>(file >> value);
+}
+
+// Parse kernel cpu list format: "0-3,6,8-9"
+std::vector<int> parseCpuList(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+
+  while (std::getline(ss, range, ',')) {
+    if (range.empty()) continue;
+    size_t dash = range.find('-');
+    try {
+      if (dash == std::string::npos) {
+        cpus.push_back(std::stoi(range));
+      } else {
+        int first = std::stoi(range.substr(0, dash));
+        int last = std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+      }
+    } catch (...) {
+      // Skip malformed entry
+    }
+  }
+  return cpus;
+}
+
+std::vector<int> readCpuList(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  if (!std::getline(file, line)) return {};
+  return parseCpuList(line);
+}
+
+// Lowest cpu sharing the highest-level cache of `cpu_dir`
+int detectLlcId(const std::string& cpu_dir) {
+  long best_level = -1;
+  int llc_id = -1;
+
+  for (int index = 0; index < 8; ++index) {
+    std::string cache_dir = cpu_dir + "/cache/index" + std::to_string(index);
+    long level = 0;
+    if (!readInt(cache_dir + "/level", level)) break;
+    if (level < best_level) continue;
+
+    auto shared = readCpuList(cache_dir + "/shared_cpu_list");
+    if (shared.empty()) continue;
+
+    best_level = level;
+    llc_id = *std::min_element(shared.begin(), shared.end());
+  }
+  return llc_id;
+}
+
+std::mutex& defaultAffinityMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+ThreadAffinity& defaultAffinity() {
+  static ThreadAffinity affinity;
+  return affinity;
+}
+
+}  // namespace
+
+const CpuTopology& CpuTopology::get() {
+  static const CpuTopology topology = detect();
+  return topology;
+}
+
+CpuTopology CpuTopology::detect(const std::string& sysfs_root) {
+  CpuTopology topology;
+
+  std::vector<int> online = readCpuList(sysfs_root + "/online");
+  if (online.empty()) {
+    unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int cpu = 0; cpu < count; ++cpu) {
+      topology.cores_.push_back({static_cast<int>(cpu), static_cast<int>(cpu), 0, 0,
+                                 kMaxCapacity, -1});
+    }
+    return topology;
+  }
+
+  // Raw capacity: cpu_capacity (ARM, already 0..1024) or max frequency as fallback
+  std::vector<long> raw_capacity;
+  for (int cpu : online) {
+    std::string cpu_dir = sysfs_root + "/cpu" + std::to_string(cpu);
+
+    CpuCore core{cpu, cpu, 0, 0, kMaxCapacity, -1};
+    long value = 0;
+    if (readInt(cpu_dir + "/topology/core_id", value)) core.core_id = static_cast<int>(value);
+    if (readInt(cpu_dir + "/topology/physical_package_id", value)) {
+      core.package_id = static_cast<int>(value);
+    }
+    core.cluster_id = core.package_id;
+    if (readInt(cpu_dir + "/topology/cluster_id", value) && value >= 0) {
+      core.cluster_id = static_cast<int>(value);
+    }
+    core.llc_id = detectLlcId(cpu_dir);
+
+    long capacity = 0;
+    if (!readInt(cpu_dir + "/cpu_capacity", capacity)) {
+      readInt(cpu_dir + "/cpufreq/cpuinfo_max_freq", capacity);
+    }
+    raw_capacity.push_back(capacity);
+    topology.cores_.push_back(core);
+  }
+
+  long max_capacity = *std::max_element(raw_capacity.begin(), raw_capacity.end());
+  if (max_capacity > 0) {
+    for (size_t i = 0; i < topology.cores_.size(); ++i) {
+      topology.cores_[i].capacity =
+          static_cast<int>(raw_capacity[i] * kMaxCapacity / max_capacity);
+    }
+  }
+
+  return topology;
+}
+
+bool CpuTopology::isHeterogeneous() const {
+  for (const auto& core : cores_) {
+    if (core.capacity != cores_.front().capacity) return true;
+  }
+  return false;
+}
+
+std::vector<int> CpuTopology::performanceCpus() const {
+  int max_capacity = 0;
+  for (const auto& core : cores_) max_capacity = std::max(max_capacity, core.capacity);
+
+  std::vector<int> cpus;
+  for (const auto& core : cores_) {
+    if (core.capacity == max_capacity) cpus.push_back(core.cpu_id);
+  }
+  return cpus;
+}
+
+std::vector<int> CpuTopology::physicalCoreCpus() const {
+  std::vector<CpuCore> sorted = cores_;
+  std::stable_sort(sorted.begin(), sorted.end(), [](const CpuCore& a, const CpuCore& b) {
+    return a.capacity > b.capacity;
+  });
+
+  // Keep the first SMT sibling of each (package, core) pair
+  std::set<std::pair<int, int>> seen;
+  std::vector<int> cpus;
+  for (const auto& core : sorted) {
+    if (seen.insert({core.package_id, core.core_id}).second) cpus.push_back(core.cpu_id);
+  }
+  return cpus;
+}
+
+std::vector<int> CpuTopology::resolve(const ThreadAffinity& affinity) const {
+  switch (affinity.policy) {
+    case AffinityPolicy::PERFORMANCE_CORES:
+      return performanceCpus();
+    case AffinityPolicy::PHYSICAL_CORES:
+      return physicalCoreCpus();
+    case AffinityPolicy::EXPLICIT: {
+      std::vector<int> cpus;
+      for (int cpu : affinity.cpus) {
+        bool online = std::any_of(cores_.begin(), cores_.end(),
+                                  [cpu](const CpuCore& core) { return core.cpu_id == cpu; });
+        if (online) cpus.push_back(cpu);
+      }
+      if (cpus.empty() && !affinity.cpus.empty()) {
+        LOG(WARNING) << "[CpuTopology] None of the " << affinity.cpus.size()
+                     << " explicit cpus is online; threads stay unpinned";
+      }
+      return cpus;
+    }
+    case AffinityPolicy::NONE:
+    default:
+      return {};
+  }
+}
+
+std::vector<int> CpuTopology::partition(size_t index, size_t count) const {
+  if (count == 0 || index >= count || cores_.empty()) {
+    return {};
+  }
+
+  // Neighbouring cpus share clusters and caches: order by package, cluster and core
+  std::vector<CpuCore> sorted = cores_;
+  std::stable_sort(sorted.begin(), sorted.end(), [](const CpuCore& a, const CpuCore& b) {
+    if (a.package_id != b.package_id) return a.package_id < b.package_id;
+    if (a.cluster_id != b.cluster_id) return a.cluster_id < b.cluster_id;
+    if (a.core_id != b.core_id) return a.core_id < b.core_id;
+    return a.cpu_id < b.cpu_id;
+  });
+
+  // Split whole physical cores when there are enough, logical cpus otherwise
+  std::vector<std::vector<int>> units;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    bool sibling = i > 0 && sorted[i].package_id == sorted[i - 1].package_id &&
+                   sorted[i].core_id == sorted[i - 1].core_id;
+    if (sibling) {
+      units.back().push_back(sorted[i].cpu_id);
+    } else {
+      units.push_back({sorted[i].cpu_id});
+    }
+  }
+  if (units.size() < count) {
+    units.clear();
+    for (const auto& core : sorted) units.push_back({core.cpu_id});
+  }
+
+  if (units.size() < count) {
+    return {units[index % units.size()].front()};
+  }
+
+  std::vector<int> cpus;
+  size_t begin = index * units.size() / count;
+  size_t end = (index + 1) * units.size() / count;
+  for (size_t i = begin; i < end; ++i) {
+    cpus.insert(cpus.end(), units[i].begin(), units[i].end());
+  }
+  return cpus;
+}
+
+bool CpuTopology::pinThread(std::thread& thread, int cpu_id) {
+#ifdef __linux__
+  if (cpu_id < 0 || cpu_id >= CPU_SETSIZE) return false;
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu_id, &cpu_set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+  (void)thread;
+  (void)cpu_id;
+  return false;
+#endif
+}
+
+ScopedAffinity::ScopedAffinity(const std::vector<int>& cpus) : applied_(false) {
+#ifdef __linux__
+  if (cpus.empty()) return;
+
+  cpu_set_t previous;
+  CPU_ZERO(&previous);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) != 0) return;
+
+  cpu_set_t confined;
+  CPU_ZERO(&confined);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &confined);
+  }
+  if (CPU_COUNT(&confined) == 0 || CPU_EQUAL(&confined, &previous)) return;
+  if (pthread_setaffinity_np(pthread_self(), sizeof(confined), &confined) != 0) return;
+
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &previous)) previous_.push_back(cpu);
+  }
+  applied_ = true;
+#else
+  (void)cpus;
+#endif
+}
+
+ScopedAffinity::~ScopedAffinity() {
+#ifdef __linux__
+  if (!applied_) return;
+
+  cpu_set_t previous;
+  CPU_ZERO(&previous);
+  for (int cpu : previous_) CPU_SET(cpu, &previous);
+  pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+#endif
+}
+
+void setDefaultThreadAffinity(const ThreadAffinity& affinity) {
+  std::lock_guard<std::mutex> lock(defaultAffinityMutex());
+  defaultAffinity() = affinity;
+}
+
+ThreadAffinity getDefaultThreadAffinity() {
+  std::lock_guard<std::mutex> lock(defaultAffinityMutex());
+  return defaultAffinity();
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
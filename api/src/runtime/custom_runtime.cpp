@@ -5,61 +5,12 @@
 namespace cochl_api {
 namespace runtime {
 
-// ThreadPool implementation
-ThreadPool::ThreadPool(size_t num_threads) : stop_(false) {
-  for (size_t i = 0; i < num_threads; ++i) {
-    workers_.emplace_back([this]() {
-      while (true) {
-        std::function<void()> task;
-
-        {
-          std::unique_lock<std::mutex> lock(this->queue_mutex_);
-
-          // Wait for new task or stop signal
-          this->condition_.wait(lock, [this]() {
-            return this->stop_ || !this->tasks_.empty();
-          });
-
-          // Exit if stopped and no tasks remaining
-          if (this->stop_ && this->tasks_.empty()) {
-            return;
-          }
-
-          // Get task from queue
-          task = std::move(this->tasks_.front());
-          this->tasks_.pop();
-        }
-
-        // Execute task
-        task();
-      }
-    });
-  }
-}
-
-ThreadPool::~ThreadPool() {
-  {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    stop_ = true;
-  }
-
-  // Notify all workers
-  condition_.notify_all();
-
-  // Wait for all workers to finish
-  for (std::thread& worker : workers_) {
-    if (worker.joinable()) {
-      worker.join();
-    }
-  }
-}
-
 // CustomRuntime implementation
 CustomRuntime::CustomRuntime()
-    : thread_pool_(nullptr),
+    : num_threads_(0),
       input_size_(0),
       output_size_(0),
-      num_threads_(4) {
+      initialized_(false) {
 }
 
 CustomRuntime::~CustomRuntime() = default;
@@ -78,19 +29,19 @@ bool CustomRuntime::loadModel(const char* model_path) {
   input_size_ = 224 * 224 * 3;  // 150528
   output_size_ = 1000;
 
-  // Initialize thread pool
-  thread_pool_ = std::make_unique<ThreadPool>(num_threads_);
+  initialized_ = true;
 
   std::cout << "[CustomRuntime] Model loaded successfully (Mock)" << std::endl;
-  std::cout << "[CustomRuntime] Thread pool initialized with " << num_threads_ << " threads" << std::endl;
+  std::cout << "[CustomRuntime] Using shared compute pool with "
+            << ComputePool::instance().getThreadBudget() << " threads" << std::endl;
 
   return true;
 }
 
 bool CustomRuntime::runInference(const float* input, const std::vector<int64_t>& input_shape,
                                   float* output) {
-  if (!thread_pool_) {
-    std::cerr << "[CustomRuntime] Thread pool not initialized" << std::endl;
+  if (!initialized_) {
+    std::cerr << "[CustomRuntime] Runtime not initialized" << std::endl;
     return false;
   }
 
@@ -112,9 +63,14 @@ bool CustomRuntime::runInference(const float* input, const std::vector<int64_t>&
 
   std::cout << "[CustomRuntime] Running inference with thread pool..." << std::endl;
 
+  // Hold the pool for the whole parallel region
+  std::shared_ptr<ThreadPool> thread_pool = threadPool();
+
   // Mock inference: Parallel computation using thread pool
-  // Split output computation across threads
-  thread_pool_->ParallelFor(0, output_size_, [this, input, output, input_size](size_t start, size_t end) {
+  // Guided chunks keep a preempted worker from stalling the whole layer;
+  // inference is latency-critical, so it runs ahead of any background work
+  ParallelOptions options{Schedule::GUIDED, 16, TaskPriority::HIGH, num_threads_};
+  thread_pool->ParallelFor(0, output_size_, options, [input, output, input_size](size_t start, size_t end) {
     for (size_t i = start; i < end; ++i) {
       // Mock computation: Simple weighted sum with some fake processing
       float sum = 0.0f;
@@ -134,6 +90,76 @@ bool CustomRuntime::runInference(const float* input, const std::vector<int64_t>&
   return true;
 }
 
+bool CustomRuntime::runBatch(const float* inputs, size_t batch_size,
+                             const std::vector<int64_t>& sample_shape, float* outputs) {
+  if (!initialized_) {
+    std::cerr << "[CustomRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
+
+  if (!inputs || !outputs || batch_size == 0) {
+    std::cerr << "[CustomRuntime] Invalid batch input or output" << std::endl;
+    return false;
+  }
+
+  if (sample_shape.empty()) {
+    std::cerr << "[CustomRuntime] Empty input shape" << std::endl;
+    return false;
+  }
+
+  // Calculate per-sample input size from shape
+  size_t sample_size = 1;
+  for (auto dim : sample_shape) {
+    sample_size *= dim;
+  }
+
+  std::cout << "[CustomRuntime] Running batch of " << batch_size << " with thread pool..."
+            << std::endl;
+
+  std::shared_ptr<ThreadPool> thread_pool = threadPool();
+
+  // Tile samples x outputs so small batches still spread over every worker
+  size_t output_size = output_size_;
+  ParallelOptions options{Schedule::DYNAMIC, 1, TaskPriority::HIGH, num_threads_};
+  thread_pool->ParallelFor2D(
+      batch_size, output_size, 1, 64, options,
+      [inputs, outputs, sample_size, output_size](size_t n_begin, size_t n_end, size_t begin,
+                                                  size_t end) {
+        for (size_t n = n_begin; n < n_end; ++n) {
+          const float* input = inputs + n * sample_size;
+          float* output = outputs + n * output_size;
+          for (size_t i = begin; i < end; ++i) {
+            // Same mock computation as runInference
+            float sum = 0.0f;
+            for (size_t j = 0; j < 10; ++j) {
+              size_t idx = (i * 17 + j * 13) % sample_size;
+              sum += input[idx] * 0.01f;
+            }
+            output[i] = sum + static_cast<float>(i % 100) * 0.001f;
+          }
+        }
+      });
+
+  std::cout << "[CustomRuntime] Batch inference completed" << std::endl;
+  return true;
+}
+
+std::unique_ptr<IRuntime> CustomRuntime::clone() const {
+  if (!initialized_) {
+    return nullptr;
+  }
+
+  // Stateless apart from the sizes: all clones share the compute (or partition) pool
+  auto runtime = std::make_unique<CustomRuntime>();
+  runtime->partition_pool_ = partition_pool_;
+  runtime->num_threads_ = num_threads_;
+  runtime->model_path_ = model_path_;
+  runtime->input_size_ = input_size_;
+  runtime->output_size_ = output_size_;
+  runtime->initialized_ = true;
+  return runtime;
+}
+
 size_t CustomRuntime::getInputSize() const {
   return input_size_;
 }
@@ -146,13 +172,50 @@ const char* CustomRuntime::getRuntimeType() const {
   return "Custom Backend (Thread Pool)";
 }
 
-void CustomRuntime::setNumThreads(size_t num_threads) {
+std::vector<int64_t> CustomRuntime::getInputShape() const {
+  // Mock model takes one ResNet50 image (NCHW)
+  return {1, 3, 224, 224};
+}
+
+size_t CustomRuntime::prepareShape(const std::vector<int64_t>& input_shape) {
+  // Mock computation samples any input into one output vector
+  return initialized_ && !input_shape.empty() ? output_size_ : 0;
+}
+
+bool CustomRuntime::setNumThreads(size_t num_threads) {
+  // A per-loop limit: resizing the shared pool would change every other runtime too
   num_threads_ = num_threads;
-  if (thread_pool_) {
-    // Recreate thread pool with new size
-    thread_pool_ = std::make_unique<ThreadPool>(num_threads_);
-    std::cout << "[CustomRuntime] Thread pool recreated with " << num_threads_ << " threads" << std::endl;
+  if (num_threads > 0) {
+    std::cout << "[CustomRuntime] Threads: " << num_threads << std::endl;
+  } else {
+    std::cout << "[CustomRuntime] Threads: all workers of the pool" << std::endl;
   }
+  return true;
+}
+
+void CustomRuntime::setThreadAffinity(const ThreadAffinity& affinity) {
+  ComputePool::instance().setThreadAffinity(affinity);
+  std::cout << "[CustomRuntime] Shared thread pool pinned to "
+            << ComputePool::instance().getThreadPool()->GetPinnedCpus().size() << " cpus"
+            << std::endl;
+}
+
+bool CustomRuntime::setCpuSet(const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    partition_pool_.reset();
+    return true;
+  }
+
+  ThreadAffinity affinity;
+  affinity.policy = AffinityPolicy::EXPLICIT;
+  affinity.cpus = cpus;
+  partition_pool_ = std::make_shared<ThreadPool>(cpus.size(), affinity);
+  std::cout << "[CustomRuntime] Partition pool pinned to " << cpus.size() << " cpus" << std::endl;
+  return true;
+}
+
+std::shared_ptr<ThreadPool> CustomRuntime::threadPool() const {
+  return partition_pool_ ? partition_pool_ : ComputePool::instance().getThreadPool();
 }
 
 }  // namespace runtime
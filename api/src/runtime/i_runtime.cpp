@@ -0,0 +1,71 @@
+#include "runtime/i_runtime.h"
+
+namespace cochl_api {
+namespace runtime {
+
+bool IRuntime::runTyped(const std::vector<InputTensor>& inputs,
+                        const std::vector<OutputTensor>& outputs) {
+  std::vector<TensorInfo> output_info = getOutputInfo();
+  if (inputs.empty() || outputs.size() != output_info.size()) {
+    return false;
+  }
+
+  TensorLayout native = getInputLayout();
+  std::vector<std::vector<float>> input_data(inputs.size());
+  std::vector<const float*> input_ptrs;
+  std::vector<std::vector<int64_t>> input_shapes;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    size_t count = 1;
+    for (auto dim : inputs[i].shape) {
+      count *= static_cast<size_t>(dim > 0 ? dim : 0);
+    }
+    bool transpose = inputs[i].shape.size() == 4 && inputs[i].layout != native;
+    if (inputs[i].dtype == DataType::FLOAT32 && !transpose) {
+      input_ptrs.push_back(static_cast<const float*>(inputs[i].data));
+    } else {
+      input_data[i].resize(count);
+      convertToFloat(inputs[i].data, inputs[i].dtype, count, input_data[i].data());
+      if (transpose) {
+        std::vector<float> native_data(count);
+        convertLayout(input_data[i].data(), native_data.data(), sizeof(float), inputs[i].shape,
+                      inputs[i].layout, native);
+        input_data[i].swap(native_data);
+      }
+      input_ptrs.push_back(input_data[i].data());
+    }
+    input_shapes.push_back(transpose ? convertShape(inputs[i].shape, inputs[i].layout, native)
+                                     : inputs[i].shape);
+  }
+
+  // Float scratch for the other output types: a shape prepared with prepareShape() may
+  // produce more than N per-sample outputs (reported for the first output of
+  // single-input models)
+  size_t batch = inputs[0].shape.empty() ? 0 : static_cast<size_t>(inputs[0].shape[0]);
+  std::vector<std::vector<float>> output_data(outputs.size());
+  std::vector<float*> output_ptrs;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i].dtype == DataType::FLOAT32) {
+      output_ptrs.push_back(static_cast<float*>(outputs[i].data));
+      continue;
+    }
+
+    size_t count = i == 0 && input_shapes.size() == 1 ? prepareShape(input_shapes[0]) : 0;
+    output_data[i].resize(count > 0 ? count : output_info[i].size * batch);
+    output_ptrs.push_back(output_data[i].data());
+  }
+
+  if (!runMulti(input_ptrs, input_shapes, output_ptrs)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i].dtype != DataType::FLOAT32) {
+      convertFromFloat(output_data[i].data(), output_data[i].size(), outputs[i].dtype,
+                       outputs[i].data);
+    }
+  }
+  return true;
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
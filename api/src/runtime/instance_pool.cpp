@@ -0,0 +1,169 @@
+#include "runtime/instance_pool.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+#include "runtime/compute_pool.h"
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultIdleTimeout(30000);
+
+size_t resolveLimit(size_t max_instances) {
+  if (max_instances > 0) return max_instances;
+  return std::max<size_t>(1, ComputePool::instance().getThreadBudget());
+}
+
+}  // namespace
+
+RuntimeInstancePool::Lease::Lease(RuntimeInstancePool* pool, std::unique_ptr<IRuntime> runtime)
+    : pool_(pool), runtime_(std::move(runtime)) {}
+
+RuntimeInstancePool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), runtime_(std::move(other.runtime_)) {
+  other.pool_ = nullptr;
+}
+
+RuntimeInstancePool::Lease::~Lease() {
+  if (pool_ && runtime_) {
+    pool_->release(std::move(runtime_));
+  }
+}
+
+RuntimeInstancePool::RuntimeInstancePool(std::unique_ptr<IRuntime> primary, size_t max_instances)
+    : runtime_type_(primary->getRuntimeType()),
+      input_size_(primary->getInputSize()),
+      output_size_(primary->getOutputSize()),
+      input_layout_(primary->getInputLayout()),
+      input_info_(primary->getInputInfo()),
+      output_info_(primary->getOutputInfo()),
+      source_(primary->clone()),
+      num_instances_(1),
+      max_instances_(max_instances),
+      cloneable_(source_ != nullptr),
+      idle_timeout_(kDefaultIdleTimeout) {
+  if (!cloneable_) {
+    LOG(WARNING) << "[RuntimeInstancePool] " << runtime_type_
+                 << " cannot clone instances; concurrent calls will queue";
+  }
+  // The loaded instance is the warm one: lease it rather than the clone source
+  idle_.push_back({std::move(primary), std::chrono::steady_clock::now()});
+}
+
+RuntimeInstancePool::Lease RuntimeInstancePool::acquire() {
+  std::vector<std::unique_ptr<IRuntime>> expired;
+  std::unique_lock<std::mutex> lock(mutex_);
+  expired = trimLocked(std::chrono::steady_clock::now());
+
+  while (true) {
+    if (!idle_.empty()) {
+      std::unique_ptr<IRuntime> runtime = std::move(idle_.back().runtime);
+      idle_.pop_back();
+      return Lease(this, std::move(runtime));
+    }
+
+    if (cloneable_ && num_instances_ < resolveLimit(max_instances_)) {
+      // Reserve the slot, then clone outside the lock: building an interpreter is slow
+      ++num_instances_;
+      lock.unlock();
+      std::unique_ptr<IRuntime> runtime = source_->clone();
+      lock.lock();
+
+      if (runtime) {
+        LOG(INFO) << "[RuntimeInstancePool] Grew to " << num_instances_ << " instances";
+        return Lease(this, std::move(runtime));
+      }
+
+      --num_instances_;
+      cloneable_ = false;
+      LOG(WARNING) << "[RuntimeInstancePool] " << runtime_type_
+                   << " failed to clone an instance; concurrent calls will queue";
+      continue;
+    }
+
+    available_.wait(lock);
+  }
+}
+
+void RuntimeInstancePool::release(std::unique_ptr<IRuntime> runtime) {
+  std::vector<std::unique_ptr<IRuntime>> expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+
+    if (num_instances_ > resolveLimit(max_instances_)) {
+      // Over the limit after a shrink: retire instead of parking
+      expired.push_back(std::move(runtime));
+      --num_instances_;
+    } else {
+      idle_.push_back({std::move(runtime), now});
+    }
+
+    auto trimmed = trimLocked(now);
+    std::move(trimmed.begin(), trimmed.end(), std::back_inserter(expired));
+  }
+  available_.notify_one();
+
+  // Destroyed outside the lock (frees arenas and backend threads)
+}
+
+std::vector<std::unique_ptr<IRuntime>> RuntimeInstancePool::trimLocked(
+    std::chrono::steady_clock::time_point now) {
+  std::vector<std::unique_ptr<IRuntime>> expired;
+  size_t limit = resolveLimit(max_instances_);
+
+  // Oldest first, keeping one instance so the next call does not pay for a clone
+  for (auto it = idle_.begin(); it != idle_.end() && num_instances_ > 1;) {
+    bool over_limit = num_instances_ > limit;
+    bool timed_out = now - it->since > idle_timeout_;
+    if (over_limit || timed_out) {
+      expired.push_back(std::move(it->runtime));
+      it = idle_.erase(it);
+      --num_instances_;
+    } else {
+      ++it;
+    }
+  }
+
+  if (!expired.empty()) {
+    LOG(INFO) << "[RuntimeInstancePool] Shrank to " << num_instances_ << " instances";
+  }
+  return expired;
+}
+
+std::unique_ptr<IRuntime> RuntimeInstancePool::clone() const {
+  return source_ ? source_->clone() : nullptr;
+}
+
+void RuntimeInstancePool::setMaxInstances(size_t max_instances) {
+  std::vector<std::unique_ptr<IRuntime>> expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_instances_ = max_instances;
+    expired = trimLocked(std::chrono::steady_clock::now());
+  }
+  // A higher limit may let waiters clone
+  available_.notify_all();
+}
+
+size_t RuntimeInstancePool::getMaxInstances() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return resolveLimit(max_instances_);
+}
+
+void RuntimeInstancePool::setIdleTimeout(std::chrono::milliseconds idle_timeout) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  idle_timeout_ = idle_timeout;
+}
+
+size_t RuntimeInstancePool::getNumInstances() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_instances_;
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,135 @@
+#include "runtime/model_registry.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "utils/hash.h"
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+// Hash the file in chunks, chaining each chunk's hash as the next seed
+bool hashFile(const std::string& path, uint64_t& hash) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  std::vector<char> chunk(1 << 20);
+  hash = 0;
+  while (file) {
+    file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    std::streamsize read = file.gcount();
+    if (read <= 0) break;
+    hash = utils::Hash64(chunk.data(), static_cast<size_t>(read), hash);
+  }
+  return !file.bad();
+}
+
+}  // namespace
+
+ModelRegistry& ModelRegistry::instance() {
+  static ModelRegistry registry;
+  return registry;
+}
+
+std::string ModelRegistry::makeKey(const std::string& model_path) {
+  char resolved[PATH_MAX];
+  if (!realpath(model_path.c_str(), resolved)) {
+    return "";
+  }
+
+  uint64_t hash = 0;
+  if (!hashFile(resolved, hash)) {
+    return "";
+  }
+
+  char hex[17];
+  std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+  return std::string(resolved) + "#" + hex;
+}
+
+std::shared_ptr<RuntimeInstancePool> ModelRegistry::acquire(const std::string& model_path,
+                                                            const std::string& settings,
+                                                            const Loader& loader,
+                                                            std::string* key_out) {
+  std::string key = makeKey(model_path);
+  if (key.empty()) {
+    LOG(ERROR) << "[ModelRegistry] Cannot read model file: " << model_path;
+    return nullptr;
+  }
+  key += "@" + settings;
+  if (key_out) {
+    *key_out = key;
+  }
+
+  std::promise<std::shared_ptr<RuntimeInstancePool>> loaded;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    pruneLocked();
+
+    Entry& entry = entries_[key];
+    if (auto pool = entry.pool.lock()) {
+      LOG(INFO) << "[ModelRegistry] Sharing already loaded model: " << key;
+      return pool;
+    }
+
+    if (entry.loading.valid()) {
+      // Another caller is loading the same file: wait for its result
+      auto pending = entry.loading;
+      lock.unlock();
+      return pending.get();
+    }
+
+    entry.loading = loaded.get_future().share();
+  }
+
+  // Load outside the lock so other models can be looked up meanwhile
+  std::shared_ptr<RuntimeInstancePool> pool;
+  try {
+    pool = loader();
+  } catch (...) {
+    pool = nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[key];
+    entry.pool = pool;
+    entry.loading = {};
+    if (!pool) {
+      entries_.erase(key);
+    }
+  }
+  loaded.set_value(pool);
+  return pool;
+}
+
+size_t ModelRegistry::getNumModels() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (const auto& entry : entries_) {
+    if (!entry.second.pool.expired()) ++count;
+  }
+  return count;
+}
+
+void ModelRegistry::pruneLocked() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.pool.expired() && !it->second.loading.valid()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
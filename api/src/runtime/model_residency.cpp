@@ -0,0 +1,154 @@
+#include "runtime/model_residency.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include <glog/logging.h>
+
+namespace cochl_api {
+namespace runtime {
+
+ModelResidency::Ticket::Ticket(ModelResidency& owner, std::string key, size_t bytes,
+                               Evictor evict)
+    : owner_(owner),
+      key_(std::move(key)),
+      bytes_(bytes),
+      evict_(std::move(evict)),
+      last_used_(0),
+      resident_(true) {}
+
+ModelResidency::Ticket::~Ticket() { owner_.remove(this); }
+
+void ModelResidency::Ticket::touch() {
+  last_used_.store(owner_.clock_.fetch_add(1, std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+}
+
+ModelResidency& ModelResidency::instance() {
+  static ModelResidency residency;
+  return residency;
+}
+
+ModelResidency::ModelResidency() : budget_(0), evictions_(0), reloads_(0), clock_(0) {}
+
+void ModelResidency::setBudget(size_t max_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = max_bytes;
+  LOG(INFO) << "[ModelResidency] Memory budget: "
+            << (max_bytes ? std::to_string(max_bytes) + " bytes" : std::string("unlimited"));
+  enforceLocked("");
+}
+
+size_t ModelResidency::getBudget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
+
+std::unique_ptr<ModelResidency::Ticket> ModelResidency::admit(const std::string& key,
+                                                              size_t bytes, Evictor evict) {
+  std::unique_ptr<Ticket> ticket(new Ticket(*this, key, bytes, std::move(evict)));
+  ticket->touch();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  tickets_.push_back(ticket.get());
+  enforceLocked(key);
+  return ticket;
+}
+
+void ModelResidency::readmit(Ticket& ticket) {
+  ticket.touch();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!ticket.resident_) {
+    ticket.resident_ = true;
+    ++reloads_;
+  }
+  enforceLocked(ticket.key_);
+}
+
+ResidencyStats ModelResidency::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, bool> models;
+  for (const Ticket* ticket : tickets_) {
+    models[ticket->key_] = models[ticket->key_] || ticket->resident_;
+  }
+
+  ResidencyStats stats;
+  stats.budget_bytes = budget_;
+  stats.resident_bytes = residentBytesLocked();
+  for (const auto& model : models) {
+    ++(model.second ? stats.resident_models : stats.evicted_models);
+  }
+  stats.evictions = evictions_;
+  stats.reloads = reloads_;
+  return stats;
+}
+
+size_t ModelResidency::modelBytes(const std::string& model_path) {
+  struct stat info;
+  if (stat(model_path.c_str(), &info) != 0) {
+    return 0;
+  }
+  return static_cast<size_t>(info.st_size);
+}
+
+void ModelResidency::enforceLocked(const std::string& keep) {
+  if (budget_ == 0) {
+    return;
+  }
+
+  while (residentBytesLocked() > budget_) {
+    // A model was last used when the last of its managers was
+    std::map<std::string, uint64_t> last_used;
+    for (const Ticket* ticket : tickets_) {
+      if (ticket->resident_ && ticket->key_ != keep) {
+        uint64_t used = ticket->last_used_.load(std::memory_order_relaxed);
+        last_used[ticket->key_] = std::max(last_used[ticket->key_], used);
+      }
+    }
+    if (last_used.empty()) {
+      LOG(WARNING) << "[ModelResidency] " << keep << " alone exceeds the memory budget of "
+                   << budget_ << " bytes";
+      return;
+    }
+
+    auto victim = std::min_element(
+        last_used.begin(), last_used.end(),
+        [](const std::pair<const std::string, uint64_t>& a,
+           const std::pair<const std::string, uint64_t>& b) { return a.second < b.second; });
+    for (Ticket* ticket : tickets_) {
+      if (ticket->resident_ && ticket->key_ == victim->first) {
+        ticket->resident_ = false;
+        ticket->evict_();
+      }
+    }
+    ++evictions_;
+    LOG(INFO) << "[ModelResidency] Evicted least recently used model: " << victim->first;
+  }
+}
+
+size_t ModelResidency::residentBytesLocked() const {
+  std::map<std::string, size_t> resident;
+  for (const Ticket* ticket : tickets_) {
+    if (ticket->resident_) {
+      resident[ticket->key_] = ticket->bytes_;
+    }
+  }
+
+  size_t bytes = 0;
+  for (const auto& model : resident) {
+    bytes += model.second;
+  }
+  return bytes;
+}
+
+void ModelResidency::remove(Ticket* ticket) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tickets_.erase(std::remove(tickets_.begin(), tickets_.end(), ticket), tickets_.end());
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
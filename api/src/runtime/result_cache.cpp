@@ -0,0 +1,127 @@
+#include "runtime/result_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "utils/hash.h"
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+size_t shapeSize(const std::vector<int64_t>& shape) {
+  size_t size = shape.empty() ? 0 : 1;
+  for (auto dim : shape) {
+    size *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+  }
+  return size;
+}
+
+}  // namespace
+
+ResultCache::ResultCache(size_t max_bytes) : max_bytes_(max_bytes), epoch_(0) {
+  stats_.max_bytes = max_bytes;
+}
+
+uint64_t ResultCache::makeKey(const float* input, size_t input_size,
+                              const std::vector<int64_t>& input_shape) {
+  // Same bytes in another shape are another input
+  uint64_t seed = utils::Hash64(input_shape.data(), input_shape.size() * sizeof(int64_t));
+  return utils::Hash64(input, input_size * sizeof(float), seed);
+}
+
+std::list<ResultCache::Entry>::iterator ResultCache::lookup(
+    uint64_t key, const float* input, size_t input_size,
+    const std::vector<int64_t>& input_shape) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return entries_.end();
+  }
+
+  const Entry& entry = *it->second;
+  if (entry.shape != input_shape || entry.input.size() != input_size ||
+      std::memcmp(entry.input.data(), input, input_size * sizeof(float)) != 0) {
+    return entries_.end();
+  }
+  return it->second;
+}
+
+bool ResultCache::find(const float* input, const std::vector<int64_t>& input_shape,
+                       float* output, uint64_t& epoch) {
+  size_t input_size = shapeSize(input_shape);
+  uint64_t key = makeKey(input, input_size, input_shape);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  epoch = epoch_;
+
+  auto entry = lookup(key, input, input_size, input_shape);
+  if (entry == entries_.end()) {
+    ++stats_.misses;
+    return false;
+  }
+
+  ++stats_.hits;
+  entries_.splice(entries_.begin(), entries_, entry);
+  std::copy(entry->output.begin(), entry->output.end(), output);
+  return true;
+}
+
+void ResultCache::insert(const float* input, const std::vector<int64_t>& input_shape,
+                         const float* output, size_t output_size, uint64_t epoch) {
+  size_t input_size = shapeSize(input_shape);
+  if ((input_size + output_size) * sizeof(float) > max_bytes_) {
+    return;
+  }
+
+  // Copy outside the lock; the key is recomputed rather than trusted from find()
+  Entry entry;
+  entry.key = makeKey(input, input_size, input_shape);
+  entry.shape = input_shape;
+  entry.input.assign(input, input + input_size);
+  entry.output.assign(output, output + output_size);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (epoch != epoch_) {
+    return;
+  }
+
+  auto existing = index_.find(entry.key);
+  if (existing != index_.end()) {
+    erase(existing->second);
+  }
+  while (!entries_.empty() && stats_.bytes + entry.bytes() > max_bytes_) {
+    erase(std::prev(entries_.end()));
+    ++stats_.evictions;
+  }
+
+  stats_.bytes += entry.bytes();
+  entries_.push_front(std::move(entry));
+  index_[entries_.front().key] = entries_.begin();
+  stats_.entries = entries_.size();
+}
+
+void ResultCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  stats_.entries = 0;
+  stats_.bytes = 0;
+  ++epoch_;
+}
+
+ResultCacheStats ResultCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void ResultCache::erase(std::list<Entry>::iterator entry) {
+  stats_.bytes -= entry->bytes();
+  index_.erase(entry->key);
+  entries_.erase(entry);
+  stats_.entries = entries_.size();
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
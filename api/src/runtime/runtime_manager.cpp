@@ -1,10 +1,19 @@
 #include "runtime/runtime_manager.h"
 
+#include <sys/stat.h>
+
 #include <algorithm>
+#include <mutex>
 #include <glog/logging.h>
 
 #include "error/api_error.h"
+#include "runtime/cpu_topology.h"
+#include "runtime/model_registry.h"
 
+#ifdef COCHL_RUNTIME_PLUGINS
+// TFLite, LibTorch and TVM live in plugin libraries loaded on first use
+#include "runtime/runtime_plugin.h"
+#else
 #ifdef USE_TFLITE
 #include "runtime/tf_runtime.h"
 #endif
@@ -16,6 +25,7 @@
 #ifdef USE_TVM
 #include "runtime/tvm_runtime.h"
 #endif
+#endif  // COCHL_RUNTIME_PLUGINS
 
 #ifdef USE_CUSTOM
 #include "runtime/custom_runtime.h"
@@ -24,9 +34,71 @@
 namespace cochl_api {
 namespace runtime {
 
-RuntimeManager::RuntimeManager() : runtime_type_(InferenceEngine::UNKNOWN), initialized_(false) {}
+namespace {
+
+// Model file extensions of each backend; the name keys the auto-tuning cache
+struct EngineFormat {
+  RuntimeManager::InferenceEngine type;
+  const char* name;
+  std::vector<std::string> extensions;
+};
+
+const std::vector<EngineFormat>& compiledEngines() {
+  static const std::vector<EngineFormat> engines = {
+#ifdef USE_TFLITE
+      {RuntimeManager::InferenceEngine::TFLITE, "tflite", {"tflite"}},
+#endif
+#ifdef USE_LIBTORCH
+      {RuntimeManager::InferenceEngine::LIBTORCH, "torch", {"pt", "pth"}},
+#endif
+#ifdef USE_TVM
+      {RuntimeManager::InferenceEngine::TVM, "tvm", {"so", "dylib", "dll"}},
+#endif
+#ifdef USE_CUSTOM
+      {RuntimeManager::InferenceEngine::CUSTOM, "custom", {"bin"}},
+#endif
+  };
+  return engines;
+}
 
-RuntimeManager::~RuntimeManager() = default;
+// Settings a loaded model depends on: loads that differ in them do not share a pool
+std::string loadSettings(RuntimeManager::InferenceEngine type, size_t num_threads) {
+  std::string engine = std::to_string(static_cast<int>(type));
+  for (const auto& format : compiledEngines()) {
+    if (format.type == type) engine = format.name;
+  }
+  return engine + ":" + std::to_string(num_threads) + "t";
+}
+
+bool isRegularFile(const std::string& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+std::mutex& warmupMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+WarmupOptions& warmupOptions() {
+  static WarmupOptions options;
+  return options;
+}
+
+}  // namespace
+
+RuntimeManager::RuntimeManager()
+    : runtime_type_(InferenceEngine::UNKNOWN), initialized_(false), num_threads_(0) {}
+
+RuntimeManager::~RuntimeManager() {
+  // Bindings may outlive the manager; they stop calling back into it
+  std::lock_guard<std::mutex> lock(bindings_mutex_);
+  for (const auto& weak : bindings_) {
+    if (auto binding = weak.lock()) {
+      binding->detach();
+    }
+  }
+}
 
 std::unique_ptr<RuntimeManager> RuntimeManager::create(const std::string& model_path) {
   if (model_path.empty()) {
@@ -34,8 +106,6 @@ std::unique_ptr<RuntimeManager> RuntimeManager::create(const std::string& model_
     return nullptr;
   }
 
-  auto manager = std::unique_ptr<RuntimeManager>(new RuntimeManager());
-
   // Detect runtime type from file extension
   InferenceEngine type = detectInferenceEngine(model_path);
 
@@ -44,11 +114,56 @@ std::unique_ptr<RuntimeManager> RuntimeManager::create(const std::string& model_
     return nullptr;
   }
 
-  // Load model with detected runtime
-  if (!manager->loadModel(model_path, type)) {
+  return createWithEngine(model_path, type, 0);
+}
+
+std::unique_ptr<RuntimeManager> RuntimeManager::createAutoTuned(const std::string& model_path,
+                                                                const TuningOptions& options) {
+  if (model_path.empty()) {
+    error::printError(error::ApiError::EMPTY_PATH);
+    return nullptr;
+  }
+
+  std::vector<InferenceEngine> types;
+  std::vector<AutoTuner::Candidate> candidates = tuningCandidates(model_path, types);
+  if (candidates.empty()) {
+    error::printError(error::ApiError::MODEL_INVALID_FORMAT, model_path);
+    return nullptr;
+  }
+
+  TuningResult result;
+  if (!AutoTuner(options).tune(candidates, result)) {
+    LOG(WARNING) << "[RuntimeManager] Auto-tuning found no runnable backend, loading "
+                 << model_path << " by extension";
+    return create(model_path);
+  }
+
+  const AutoTuner::Candidate& chosen = candidates[result.candidate];
+  LOG(INFO) << "[RuntimeManager] Auto-tuned: " << chosen.name << " (" << chosen.model_path
+            << "), " << result.num_threads << " threads, " << result.latency_ms << " ms";
+  return createWithEngine(chosen.model_path, types[result.candidate], result.num_threads);
+}
+
+std::unique_ptr<RuntimeManager> RuntimeManager::createWithEngine(const std::string& model_path,
+                                                                 InferenceEngine type,
+                                                                 size_t num_threads) {
+  auto manager = std::unique_ptr<RuntimeManager>(new RuntimeManager());
+
+  // Load model with the given runtime, or share it if the same file is already loaded
+  std::string key;
+  manager->instances_ = ModelRegistry::instance().acquire(
+      model_path, loadSettings(type, num_threads), [&model_path, type, num_threads]() {
+        return loadModel(model_path, type, num_threads);
+      }, &key);
+  if (!manager->instances_) {
     error::printError(error::ApiError::MODEL_LOAD_FAILED, model_path);
     return nullptr;
   }
+  manager->runtime_type_ = type;
+  manager->initialized_ = true;
+  manager->model_path_ = model_path;
+  manager->num_threads_ = num_threads;
+  manager->admitResidency(key, model_path);
 
   const char* runtime_name = "Unknown";
   switch (manager->runtime_type_) {
@@ -119,99 +234,566 @@ RuntimeManager::InferenceEngine RuntimeManager::detectInferenceEngine(
   return InferenceEngine::UNKNOWN;
 }
 
-bool RuntimeManager::loadModel(const std::string& model_path, InferenceEngine type) {
-  if (initialized_) {
-    error::printError(error::ApiError::MODEL_ALREADY_LOADED);
-    return false;
+std::vector<AutoTuner::Candidate> RuntimeManager::tuningCandidates(
+    const std::string& model_path, std::vector<InferenceEngine>& types) {
+  std::string stem = model_path;
+  size_t dot_pos = model_path.find_last_of('.');
+  size_t slash_pos = model_path.find_last_of('/');
+  if (dot_pos != std::string::npos && (slash_pos == std::string::npos || dot_pos > slash_pos)) {
+    stem = model_path.substr(0, dot_pos);
   }
 
-  runtime_type_ = type;
+  // The requested file goes first so it wins ties
+  std::vector<AutoTuner::Candidate> candidates;
+  InferenceEngine requested = detectInferenceEngine(model_path);
+  for (const auto& engine : compiledEngines()) {
+    if (engine.type == requested) {
+      InferenceEngine type = engine.type;
+      candidates.insert(candidates.begin(),
+                        {engine.name, model_path, [type]() { return newRuntime(type); }});
+      types.insert(types.begin(), type);
+      continue;
+    }
 
-  switch (type) {
-#ifdef USE_TFLITE
-    case InferenceEngine::TFLITE: {
-      auto tf_runtime = std::make_unique<TFRuntime>();
-      if (!tf_runtime->loadModel(model_path.c_str())) {
-        error::printError(error::ApiError::MODEL_LOAD_FAILED, "TFLite runtime");
-        return false;
+    // Other backends run the same network if it was exported next to it
+    for (const auto& extension : engine.extensions) {
+      std::string path = stem + "." + extension;
+      if (isRegularFile(path)) {
+        InferenceEngine type = engine.type;
+        candidates.push_back({engine.name, path, [type]() { return newRuntime(type); }});
+        types.push_back(type);
+        break;
       }
-      runtime_ = std::move(tf_runtime);
-      initialized_ = true;
-      return true;
     }
+  }
+  return candidates;
+}
+
+std::unique_ptr<IRuntime> RuntimeManager::newRuntime(InferenceEngine type) {
+  switch (type) {
+#ifdef USE_TFLITE
+    case InferenceEngine::TFLITE:
+#ifdef COCHL_RUNTIME_PLUGINS
+      return RuntimePlugin::createRuntime("tflite");
+#else
+      return std::make_unique<TFRuntime>();
+#endif
 #endif
 
 #ifdef USE_LIBTORCH
-    case InferenceEngine::LIBTORCH: {
-      auto torch_runtime = std::make_unique<TorchRuntime>();
-      if (!torch_runtime->loadModel(model_path.c_str())) {
-        error::printError(error::ApiError::MODEL_LOAD_FAILED, "LibTorch runtime");
-        return false;
-      }
-      runtime_ = std::move(torch_runtime);
-      initialized_ = true;
-      return true;
-    }
+    case InferenceEngine::LIBTORCH:
+#ifdef COCHL_RUNTIME_PLUGINS
+      return RuntimePlugin::createRuntime("torch");
+#else
+      return std::make_unique<TorchRuntime>();
+#endif
 #endif
 
 #ifdef USE_TVM
-    case InferenceEngine::TVM: {
-      auto tvm_runtime = std::make_unique<TVMRuntime>();
-      if (!tvm_runtime->loadModel(model_path.c_str())) {
-        error::printError(error::ApiError::MODEL_LOAD_FAILED, "TVM runtime");
-        return false;
-      }
-      runtime_ = std::move(tvm_runtime);
-      initialized_ = true;
-      return true;
-    }
+    case InferenceEngine::TVM:
+#ifdef COCHL_RUNTIME_PLUGINS
+      return RuntimePlugin::createRuntime("tvm");
+#else
+      return std::make_unique<TVMRuntime>();
+#endif
 #endif
 
 #ifdef USE_CUSTOM
-    case InferenceEngine::CUSTOM: {
-      auto custom_runtime = std::make_unique<CustomRuntime>();
-      if (!custom_runtime->loadModel(model_path.c_str())) {
-        error::printError(error::ApiError::MODEL_LOAD_FAILED, "Custom runtime");
-        return false;
-      }
-      runtime_ = std::move(custom_runtime);
-      initialized_ = true;
-      return true;
-    }
+    case InferenceEngine::CUSTOM:
+      return std::make_unique<CustomRuntime>();
 #endif
 
     default:
-      error::printError(error::ApiError::RUNTIME_NOT_SUPPORTED);
-      return false;
+      return nullptr;
   }
 }
 
+std::shared_ptr<RuntimeInstancePool> RuntimeManager::loadModel(const std::string& model_path,
+                                                               InferenceEngine type,
+                                                               size_t num_threads) {
+  std::unique_ptr<IRuntime> runtime = newRuntime(type);
+  if (!runtime) {
+    error::printError(error::ApiError::RUNTIME_NOT_SUPPORTED);
+    return nullptr;
+  }
+
+  if (!runtime->loadModel(model_path.c_str())) {
+    error::printError(error::ApiError::MODEL_LOAD_FAILED,
+                      std::string(runtime->getRuntimeType()) + " runtime");
+    return nullptr;
+  }
+
+  // Clones made for concurrent callers inherit the thread count
+  if (num_threads > 0 && !runtime->setNumThreads(num_threads)) {
+    LOG(WARNING) << "[RuntimeManager] " << runtime->getRuntimeType()
+                 << " keeps its default thread count";
+  }
+
+  // Pay for lazy allocation and weight packing here rather than on the first request
+  WarmupStats warmup = Warmup::run(*runtime, getWarmupOptions());
+
+  auto instances = std::make_shared<RuntimeInstancePool>(std::move(runtime));
+  instances->setWarmupStats(warmup);
+  return instances;
+}
+
 bool RuntimeManager::runInference(const float* input, const std::vector<int64_t>& input_shape,
                                    float* output) const {
-  if (!runtime_) {
+  // Looked up before the model is pinned: an epoch read after swapModel() cleared the cache
+  // guarantees the snapshot below is the new model
+  auto cache = std::atomic_load(&result_cache_);
+  uint64_t epoch = 0;
+  if (cache && cache->find(input, input_shape, output, epoch)) {
+    return true;
+  }
+
+  // Pins the current model until this call returns, even if it is swapped meanwhile
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  // Each concurrent caller runs on its own instance
+  ScopedAffinity confine(partitionCpus());
+  auto runtime = instances->acquire();
+  if (!runtime->runInference(input, input_shape, output)) {
+    return false;
+  }
+
+  if (cache) {
+    // The plan for this shape exists now, so this is a lookup
+    size_t output_size = runtime->prepareShape(input_shape);
+    if (output_size > 0) {
+      cache->insert(input, input_shape, output, output_size, epoch);
+    }
+  }
+  return true;
+}
+
+bool RuntimeManager::runBatch(const float* inputs, size_t batch_size,
+                              const std::vector<int64_t>& sample_shape, float* outputs) const {
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  ScopedAffinity confine(partitionCpus());
+  auto runtime = instances->acquire();
+  return runtime->runBatch(inputs, batch_size, sample_shape, outputs);
+}
+
+bool RuntimeManager::runMulti(const std::vector<const float*>& inputs,
+                              const std::vector<std::vector<int64_t>>& input_shapes,
+                              const std::vector<float*>& outputs) const {
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  ScopedAffinity confine(partitionCpus());
+  auto runtime = instances->acquire();
+  return runtime->runMulti(inputs, input_shapes, outputs);
+}
+
+bool RuntimeManager::runTyped(const std::vector<InputTensor>& inputs,
+                              const std::vector<OutputTensor>& outputs) const {
+  auto instances = currentInstances();
+  if (!instances) {
     error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
     return false;
   }
 
-  return runtime_->runInference(input, input_shape, output);
+  ScopedAffinity confine(partitionCpus());
+  auto runtime = instances->acquire();
+  return runtime->runTyped(inputs, outputs);
+}
+
+std::shared_ptr<TensorBinding> RuntimeManager::bindBuffers(
+    const std::vector<InputTensor>& inputs, const std::vector<OutputTensor>& outputs) const {
+  if (!currentInstances()) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return nullptr;
+  }
+
+  // Bound to whatever the manager serves at each run, not to the model loaded now
+  TensorBinding::Source source;
+  source.instances = [this]() { return currentInstances(); };
+  source.cpus = [this]() { return partitionCpus(); };
+  auto binding = std::make_shared<TensorBinding>(std::move(source), inputs, outputs);
+
+  std::lock_guard<std::mutex> lock(bindings_mutex_);
+  bindings_.erase(std::remove_if(bindings_.begin(), bindings_.end(),
+                                 [](const std::weak_ptr<TensorBinding>& weak) {
+                                   return weak.expired();
+                                 }),
+                  bindings_.end());
+  bindings_.push_back(binding);
+  return binding;
+}
+
+size_t RuntimeManager::prepareShape(const std::vector<int64_t>& input_shape) const {
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return 0;
+  }
+
+  ScopedAffinity confine(partitionCpus());
+  auto runtime = instances->acquire();
+  size_t output_size = runtime->prepareShape(input_shape);
+  if (output_size == 0) {
+    error::printError(error::ApiError::INVALID_INPUT_SIZE, "Model cannot take this input shape");
+  }
+  return output_size;
+}
+
+void RuntimeManager::setMaxInstances(size_t max_instances) {
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return;
+  }
+
+  instances->setMaxInstances(max_instances);
+}
+
+size_t RuntimeManager::getMaxInstances() const {
+  auto instances = currentInstances();
+  return instances ? instances->getMaxInstances() : 0;
+}
+
+size_t RuntimeManager::getNumInstances() const {
+  auto instances = currentInstances();
+  return instances ? instances->getNumInstances() : 0;
+}
+
+bool RuntimeManager::swapModel(const std::string& model_path,
+                               const std::vector<int64_t>& warmup_shape) {
+  if (!initialized_) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (model_path.empty()) {
+    error::printError(error::ApiError::EMPTY_PATH);
+    return false;
+  }
+
+  InferenceEngine type = detectInferenceEngine(model_path);
+  if (type == InferenceEngine::UNKNOWN) {
+    error::printError(error::ApiError::MODEL_INVALID_FORMAT, model_path);
+    return false;
+  }
+
+  // Serving continues on the current model while the new one loads
+  std::string key;
+  auto next = ModelRegistry::instance().acquire(
+      model_path, loadSettings(type, 0),
+      [&model_path, type]() { return loadModel(model_path, type); }, &key);
+  if (!next) {
+    error::printError(error::ApiError::MODEL_LOAD_FAILED, model_path);
+    return false;
+  }
+
+  auto current = residentInstances();
+  if (!current) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+  if (next == current) {
+    LOG(INFO) << "[RuntimeManager] " << model_path << " is already being served";
+    return true;
+  }
+
+  // Callers size their buffers from getInputSize()/getOutputSize() (and per tensor for runMulti)
+  auto sameSizes = [](const std::vector<TensorInfo>& a, const std::vector<TensorInfo>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (a[i].size != b[i].size) return false;
+    }
+    return true;
+  };
+  if (next->getInputSize() != current->getInputSize() ||
+      next->getOutputSize() != current->getOutputSize() ||
+      !sameSizes(next->getInputInfo(), current->getInputInfo()) ||
+      !sameSizes(next->getOutputInfo(), current->getOutputInfo())) {
+    error::printError(error::ApiError::INVALID_PARAMETER,
+                      "Swapped model must keep the input and output sizes");
+    return false;
+  }
+
+  // First inference pays for lazy allocation and kernel selection: keep it off the request path
+  if (!warmup_shape.empty()) {
+    size_t input_size = 1;
+    for (auto dim : warmup_shape) {
+      input_size *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+    }
+    size_t batch = static_cast<size_t>(std::max<int64_t>(warmup_shape[0], 1));
+    std::vector<float> input(input_size, 0.0f);
+    std::vector<float> output(next->getOutputSize() * batch);
+
+    auto runtime = next->acquire();
+    if (!runtime->runInference(input.data(), warmup_shape, output.data())) {
+      error::printError(error::ApiError::INFERENCE_FAILED, "Warmup of swapped model");
+      return false;
+    }
+  }
+
+  // Publish: new calls see the new model, in-flight calls keep their reference to the old one,
+  // which is released when the last of them returns
+  {
+    // A reload after an eviction from here on loads the new model
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    model_path_ = model_path;
+    num_threads_ = 0;
+    runtime_type_ = type;
+    std::atomic_store(&instances_, next);
+  }
+  admitResidency(key, model_path);
+  invalidateBindings();
+
+  // Results of the old model; runs still in flight on it are dropped by the epoch
+  auto cache = std::atomic_load(&result_cache_);
+  if (cache) {
+    cache->clear();
+  }
+
+  // Until the new model is confined, calls run on its shared instances (still on the cpus)
+  auto partition = std::atomic_load(&partition_);
+  if (partition) {
+    std::atomic_store(&partition_, makePartition(partition->cpus, next));
+  }
+
+  LOG(INFO) << "[RuntimeManager] Swapped in model: " << model_path;
+  return true;
+}
+
+void RuntimeManager::setResultCache(size_t max_bytes) {
+  if (max_bytes == 0) {
+    std::atomic_store(&result_cache_, std::shared_ptr<ResultCache>());
+    LOG(INFO) << "[RuntimeManager] Result cache off";
+    return;
+  }
+
+  std::atomic_store(&result_cache_, std::make_shared<ResultCache>(max_bytes));
+  LOG(INFO) << "[RuntimeManager] Result cache of " << max_bytes << " bytes";
+}
+
+ResultCacheStats RuntimeManager::getResultCacheStats() const {
+  auto cache = std::atomic_load(&result_cache_);
+  return cache ? cache->getStats() : ResultCacheStats();
+}
+
+void RuntimeManager::setWarmupOptions(const WarmupOptions& options) {
+  std::lock_guard<std::mutex> lock(warmupMutex());
+  warmupOptions() = options;
+}
+
+WarmupOptions RuntimeManager::getWarmupOptions() {
+  std::lock_guard<std::mutex> lock(warmupMutex());
+  return warmupOptions();
+}
+
+WarmupStats RuntimeManager::getWarmupStats() const {
+  auto instances = std::atomic_load(&instances_);
+  return instances ? instances->getWarmupStats() : WarmupStats();
+}
+
+std::vector<TensorInfo> RuntimeManager::getInputInfo() const {
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return {};
+  }
+
+  return instances->getInputInfo();
+}
+
+std::vector<TensorInfo> RuntimeManager::getOutputInfo() const {
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return {};
+  }
+
+  return instances->getOutputInfo();
+}
+
+TensorLayout RuntimeManager::getInputLayout() const {
+  auto instances = currentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return TensorLayout::NCHW;
+  }
+
+  return instances->getInputLayout();
 }
 
 size_t RuntimeManager::getInputSize() const {
-  if (!runtime_) {
+  auto instances = currentInstances();
+  if (!instances) {
     error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
     return 0;
   }
 
-  return runtime_->getInputSize();
+  return instances->getInputSize();
 }
 
 size_t RuntimeManager::getOutputSize() const {
-  if (!runtime_) {
+  auto instances = currentInstances();
+  if (!instances) {
     error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
     return 0;
   }
 
-  return runtime_->getOutputSize();
+  return instances->getOutputSize();
+}
+
+bool RuntimeManager::setCpuPartition(const ThreadAffinity& affinity) {
+  auto instances = residentInstances();
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED);
+    return false;
+  }
+
+  if (affinity.policy == AffinityPolicy::NONE) {
+    std::atomic_store(&partition_, std::shared_ptr<const Partition>());
+    LOG(INFO) << "[RuntimeManager] CPU partition removed";
+    return true;
+  }
+
+  std::vector<int> cpus = CpuTopology::get().resolve(affinity);
+  if (cpus.empty()) {
+    error::printError(error::ApiError::INVALID_PARAMETER, "CPU partition has no online cpu");
+    return false;
+  }
+
+  std::atomic_store(&partition_, makePartition(cpus, instances));
+  return true;
+}
+
+std::vector<int> RuntimeManager::getCpuPartition() const {
+  return partitionCpus();
+}
+
+std::shared_ptr<const RuntimeManager::Partition> RuntimeManager::makePartition(
+    const std::vector<int>& cpus, std::shared_ptr<RuntimeInstancePool> source) {
+  auto partition = std::make_shared<Partition>();
+  partition->cpus = cpus;
+  partition->source = source;
+
+  // Backend workers created from here on inherit the partition
+  ScopedAffinity confine(cpus);
+  std::unique_ptr<IRuntime> runtime = source->clone();
+  if (runtime && runtime->setCpuSet(cpus)) {
+    partition->instances = std::make_shared<RuntimeInstancePool>(std::move(runtime));
+    LOG(INFO) << "[RuntimeManager] Confined to " << cpus.size() << " cpus";
+  } else {
+    LOG(WARNING) << "[RuntimeManager] " << source->getRuntimeType()
+                 << " workers are process-wide; only calling threads are confined to "
+                 << cpus.size() << " cpus";
+  }
+  return partition;
+}
+
+std::shared_ptr<RuntimeInstancePool> RuntimeManager::currentInstances() const {
+  auto instances = residentInstances();
+  auto partition = std::atomic_load(&partition_);
+  if (partition && partition->instances && partition->source == instances) {
+    return partition->instances;
+  }
+  return instances;
+}
+
+std::shared_ptr<RuntimeInstancePool> RuntimeManager::residentInstances() const {
+  auto instances = std::atomic_load(&instances_);
+  if (!instances && initialized_) {
+    instances = reload();
+  }
+
+  auto residency = std::atomic_load(&residency_);
+  if (instances && residency) {
+    residency->touch();
+  }
+  return instances;
+}
+
+std::shared_ptr<RuntimeInstancePool> RuntimeManager::reload() const {
+  std::lock_guard<std::mutex> lock(load_mutex_);
+
+  // Concurrent callers of an evicted model wait here for the first one to reload it
+  auto instances = std::atomic_load(&instances_);
+  if (instances) {
+    return instances;
+  }
+
+  // Shared if another manager has loaded the file since
+  std::string model_path = model_path_;
+  InferenceEngine type = runtime_type_;
+  size_t num_threads = num_threads_;
+  std::string key;
+  instances = ModelRegistry::instance().acquire(
+      model_path, loadSettings(type, num_threads), [&model_path, type, num_threads]() {
+        return loadModel(model_path, type, num_threads);
+      }, &key);
+  if (!instances) {
+    error::printError(error::ApiError::MODEL_LOAD_FAILED, "Reload of evicted model " + model_path);
+    return nullptr;
+  }
+  std::atomic_store(&instances_, instances);
+
+  auto partition = std::atomic_load(&partition_);
+  if (partition) {
+    std::atomic_store(&partition_, makePartition(partition->cpus, instances));
+  }
+
+  // A file rewritten in place since the first load is another model
+  auto residency = std::atomic_load(&residency_);
+  if (residency && residency->getKey() == key) {
+    ModelResidency::instance().readmit(*residency);
+  } else {
+    admitResidency(key, model_path);
+  }
+
+  LOG(INFO) << "[RuntimeManager] Reloaded evicted model: " << model_path;
+  return instances;
+}
+
+void RuntimeManager::admitResidency(const std::string& key, const std::string& model_path) const {
+  std::shared_ptr<ModelResidency::Ticket> residency = ModelResidency::instance().admit(
+      key, ModelResidency::modelBytes(model_path), [this]() { evict(); });
+  std::atomic_store(&residency_, residency);
+}
+
+void RuntimeManager::evict() const {
+  // Calls in flight keep their snapshot; the model is unloaded when the last of them returns
+  std::atomic_store(&instances_, std::shared_ptr<RuntimeInstancePool>());
+  invalidateBindings();
+
+  // The partition keeps confining calling threads and is rebuilt on reload
+  auto partition = std::atomic_load(&partition_);
+  if (partition && partition->source) {
+    auto cpus_only = std::make_shared<Partition>();
+    cpus_only->cpus = partition->cpus;
+    std::atomic_store(&partition_, std::shared_ptr<const Partition>(cpus_only));
+  }
+}
+
+std::vector<int> RuntimeManager::partitionCpus() const {
+  auto partition = std::atomic_load(&partition_);
+  return partition ? partition->cpus : std::vector<int>();
+}
+
+void RuntimeManager::invalidateBindings() const {
+  std::lock_guard<std::mutex> lock(bindings_mutex_);
+  for (const auto& weak : bindings_) {
+    if (auto binding = weak.lock()) {
+      binding->invalidate();
+    }
+  }
 }
 
 }  // namespace runtime
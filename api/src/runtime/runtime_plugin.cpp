@@ -0,0 +1,116 @@
+#include "runtime/runtime_plugin.h"
+
+#include <dlfcn.h>
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <glog/logging.h>
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+using CreateFn = IRuntime* (*)();
+using AbiVersionFn = int (*)();
+
+struct PluginState {
+  std::mutex mutex;
+  // nullptr entry: lookup already failed, do not retry on every model load
+  std::map<std::string, CreateFn> factories;
+};
+
+PluginState& pluginState() {
+  static PluginState state;
+  return state;
+}
+
+// Directory holding libcochl_api.so itself
+std::string libraryDir() {
+  Dl_info info;
+  if (dladdr(reinterpret_cast<void*>(&pluginState), &info) == 0 || !info.dli_fname) {
+    return "";
+  }
+  std::string path(info.dli_fname);
+  size_t slash = path.find_last_of('/');
+  return slash == std::string::npos ? "" : path.substr(0, slash);
+}
+
+std::vector<std::string> candidatePaths(const std::string& file_name) {
+  std::vector<std::string> paths;
+  if (const char* dir = std::getenv("COCHL_RUNTIME_PLUGIN_PATH")) {
+    if (*dir) paths.push_back(std::string(dir) + "/" + file_name);
+  }
+
+  std::string lib_dir = libraryDir();
+  if (!lib_dir.empty()) {
+    paths.push_back(lib_dir + "/" + file_name);
+    paths.push_back(lib_dir + "/runtime/" + file_name);
+  }
+
+  // Bare name: LD_LIBRARY_PATH, rpath and system directories
+  paths.push_back(file_name);
+  return paths;
+}
+
+CreateFn openPlugin(const std::string& name) {
+  const std::string file_name = "libcochl_runtime_" + name + ".so";
+
+  std::string last_error = "no candidate path";
+  for (const std::string& path : candidatePaths(file_name)) {
+    // RTLD_LOCAL keeps each backend's bundled dependencies from clashing
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+      const char* error = dlerror();
+      if (error) last_error = error;
+      continue;
+    }
+
+    auto abi_version = reinterpret_cast<AbiVersionFn>(dlsym(handle, "CochlRuntime_AbiVersion"));
+    auto create = reinterpret_cast<CreateFn>(dlsym(handle, "CochlRuntime_Create"));
+    if (!abi_version || !create || abi_version() != COCHL_RUNTIME_PLUGIN_ABI_VERSION) {
+      LOG(ERROR) << "[RuntimePlugin] Incompatible plugin: " << path;
+      dlclose(handle);
+      continue;
+    }
+
+    LOG(INFO) << "[RuntimePlugin] Loaded " << name << " backend from " << path;
+    return create;
+  }
+
+  LOG(ERROR) << "[RuntimePlugin] Plugin not found: " << file_name << " (" << last_error << ")";
+  return nullptr;
+}
+
+}  // namespace
+
+std::unique_ptr<IRuntime> RuntimePlugin::createRuntime(const std::string& name) {
+  CreateFn create = nullptr;
+  {
+    PluginState& state = pluginState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.factories.find(name);
+    if (it == state.factories.end()) {
+      it = state.factories.emplace(name, openPlugin(name)).first;
+    }
+    create = it->second;
+  }
+
+  if (!create) {
+    return nullptr;
+  }
+  return std::unique_ptr<IRuntime>(create());
+}
+
+bool RuntimePlugin::isLoaded(const std::string& name) {
+  PluginState& state = pluginState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  auto it = state.factories.find(name);
+  return it != state.factories.end() && it->second != nullptr;
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -0,0 +1,80 @@
+#include "runtime/tensor_binding.h"
+
+#include <utility>
+
+#include <glog/logging.h>
+
+#include "error/api_error.h"
+#include "runtime/cpu_topology.h"
+
+namespace cochl_api {
+namespace runtime {
+
+TensorBinding::TensorBinding(Source source, std::vector<InputTensor> inputs,
+                             std::vector<OutputTensor> outputs)
+    : source_(std::make_shared<const Source>(std::move(source))),
+      inputs_(std::move(inputs)),
+      outputs_(std::move(outputs)),
+      stale_(false) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bind(source_->instances());
+}
+
+bool TensorBinding::run() {
+  // Resolved before taking the lock: a reload may evict other models, whose bindings must
+  // not wait for this one
+  auto source = std::atomic_load(&source_);
+  auto instances = source ? source->instances() : nullptr;
+  if (!instances) {
+    error::printError(error::ApiError::RUNTIME_NOT_INITIALIZED, "Bound model is no longer served");
+    return false;
+  }
+
+  ScopedAffinity confine(source->cpus ? source->cpus() : std::vector<int>());
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stale_.exchange(false) || bound_instances_.lock() != instances) {
+    LOG(INFO) << "[TensorBinding] Model changed, binding the buffers again";
+    bind(instances);
+  }
+
+  auto runtime = std::atomic_load(&runtime_);
+  if (runtime) {
+    return runtime->runBound();
+  }
+
+  auto pooled = instances->acquire();
+  return pooled->runTyped(inputs_, outputs_);
+}
+
+void TensorBinding::invalidate() {
+  std::atomic_store(&runtime_, std::shared_ptr<IRuntime>());
+  stale_ = true;
+}
+
+void TensorBinding::detach() {
+  std::atomic_store(&source_, std::shared_ptr<const Source>());
+  invalidate();
+}
+
+void TensorBinding::bind(const std::shared_ptr<RuntimeInstancePool>& instances) {
+  std::atomic_store(&runtime_, std::shared_ptr<IRuntime>());
+  bound_instances_ = instances;
+  if (!instances) {
+    return;
+  }
+
+  // The bound instance is created confined, like clones made by a call
+  auto source = std::atomic_load(&source_);
+  ScopedAffinity confine(source && source->cpus ? source->cpus() : std::vector<int>());
+  std::shared_ptr<IRuntime> runtime = instances->clone();
+  if (runtime && runtime->bindBuffers(inputs_, outputs_)) {
+    std::atomic_store(&runtime_, runtime);
+    LOG(INFO) << "[TensorBinding] Buffers bound in place on " << runtime->getRuntimeType();
+  } else {
+    LOG(INFO) << "[TensorBinding] " << instances->getRuntimeType()
+              << " cannot use the buffers in place, copying on each run";
+  }
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
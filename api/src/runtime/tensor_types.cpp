@@ -0,0 +1,252 @@
+#include "runtime/tensor_types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+template <typename T>
+void toFloat(const T* src, size_t count, float* dst, float scale, int32_t zero_point) {
+  if (scale > 0.0f) {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = (static_cast<int32_t>(src[i]) - zero_point) * scale;
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = static_cast<float>(src[i]);
+    }
+  }
+}
+
+template <typename T>
+void fromFloat(const float* src, size_t count, T* dst, float scale, int32_t zero_point) {
+  constexpr float lo = static_cast<float>(std::numeric_limits<T>::min());
+  constexpr float hi = static_cast<float>(std::numeric_limits<T>::max());
+  for (size_t i = 0; i < count; ++i) {
+    float value = scale > 0.0f ? src[i] / scale + zero_point : src[i];
+    dst[i] = static_cast<T>(std::min(hi, std::max(lo, std::nearbyint(value))));
+  }
+}
+
+// Moves each element of the [N, A, B, C] tensor to [N, B, C, A] (NCHW -> NHWC) or the
+// inverse (NHWC -> NCHW, with the source read as [N, B, C, A])
+template <typename T>
+void transpose(const T* src, T* dst, int64_t N, int64_t C, int64_t H, int64_t W, bool to_nhwc) {
+  const int64_t plane = H * W;
+  for (int64_t n = 0; n < N; ++n) {
+    const T* src_n = src + n * C * plane;
+    T* dst_n = dst + n * C * plane;
+    for (int64_t c = 0; c < C; ++c) {
+      for (int64_t p = 0; p < plane; ++p) {
+        if (to_nhwc) {
+          dst_n[p * C + c] = src_n[c * plane + p];
+        } else {
+          dst_n[c * plane + p] = src_n[p * C + c];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+size_t dataTypeSize(DataType dtype) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      return 4;
+    case DataType::FLOAT16:
+    case DataType::INT16:
+      return 2;
+    case DataType::INT8:
+    case DataType::UINT8:
+      return 1;
+  }
+  return 0;
+}
+
+const char* dataTypeName(DataType dtype) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      return "float32";
+    case DataType::FLOAT16:
+      return "float16";
+    case DataType::INT8:
+      return "int8";
+    case DataType::UINT8:
+      return "uint8";
+    case DataType::INT16:
+      return "int16";
+  }
+  return "unknown";
+}
+
+const char* tensorLayoutName(TensorLayout layout) {
+  return layout == TensorLayout::NHWC ? "nhwc" : "nchw";
+}
+
+std::vector<int64_t> convertShape(const std::vector<int64_t>& shape, TensorLayout from,
+                                  TensorLayout to) {
+  if (shape.size() != 4 || from == to) {
+    return shape;
+  }
+  if (to == TensorLayout::NHWC) {
+    return {shape[0], shape[2], shape[3], shape[1]};
+  }
+  return {shape[0], shape[3], shape[1], shape[2]};
+}
+
+void convertLayout(const void* src, void* dst, size_t element_size,
+                   const std::vector<int64_t>& shape, TensorLayout from, TensorLayout to) {
+  size_t count = 1;
+  for (auto dim : shape) {
+    count *= static_cast<size_t>(dim);
+  }
+  if (shape.size() != 4 || from == to) {
+    std::memcpy(dst, src, count * element_size);
+    return;
+  }
+
+  std::vector<int64_t> nchw = convertShape(shape, from, TensorLayout::NCHW);
+  bool to_nhwc = to == TensorLayout::NHWC;
+  switch (element_size) {
+    case 1:
+      transpose(static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dst), nchw[0], nchw[1],
+                nchw[2], nchw[3], to_nhwc);
+      break;
+    case 2:
+      transpose(static_cast<const uint16_t*>(src), static_cast<uint16_t*>(dst), nchw[0], nchw[1],
+                nchw[2], nchw[3], to_nhwc);
+      break;
+    default:
+      transpose(static_cast<const uint32_t*>(src), static_cast<uint32_t*>(dst), nchw[0], nchw[1],
+                nchw[2], nchw[3], to_nhwc);
+      break;
+  }
+}
+
+float halfToFloat(uint16_t half) {
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+
+  uint32_t bits;
+  if (exponent == 0x1f) {
+    // Inf / NaN
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Subnormal: normalize the mantissa
+    exponent = 113;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint16_t floatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  uint32_t abs_bits = bits & 0x7fffffff;
+
+  if (abs_bits >= 0x7f800000) {
+    // Inf stays Inf, NaN stays a (quiet) NaN
+    return sign | 0x7c00 | (abs_bits > 0x7f800000 ? 0x200 : 0);
+  }
+  if (abs_bits >= 0x477ff000) {
+    // Rounds past the largest half (65504)
+    return sign | 0x7c00;
+  }
+  if (abs_bits < 0x38800000) {
+    // Subnormal half (or zero): shift the mantissa with its implicit bit into place
+    if (abs_bits < 0x33000000) {
+      return sign;
+    }
+    uint32_t exponent = abs_bits >> 23;
+    uint32_t mantissa = (abs_bits & 0x7fffff) | 0x800000;
+    uint32_t shift = 126 - exponent;
+    uint32_t half = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1))) {
+      ++half;
+    }
+    return sign | static_cast<uint16_t>(half);
+  }
+
+  // Normal: rebias the exponent and round the mantissa to 10 bits
+  uint32_t half = ((abs_bits - 0x38000000) >> 13);
+  uint32_t remainder = abs_bits & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+    ++half;
+  }
+  return sign | static_cast<uint16_t>(half);
+}
+
+void convertToFloat(const void* src, DataType dtype, size_t count, float* dst, float scale,
+                    int32_t zero_point) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      std::memcpy(dst, src, count * sizeof(float));
+      break;
+    case DataType::FLOAT16: {
+      const uint16_t* half = static_cast<const uint16_t*>(src);
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] = halfToFloat(half[i]);
+      }
+      break;
+    }
+    case DataType::INT8:
+      toFloat(static_cast<const int8_t*>(src), count, dst, scale, zero_point);
+      break;
+    case DataType::UINT8:
+      toFloat(static_cast<const uint8_t*>(src), count, dst, scale, zero_point);
+      break;
+    case DataType::INT16:
+      toFloat(static_cast<const int16_t*>(src), count, dst, scale, zero_point);
+      break;
+  }
+}
+
+void convertFromFloat(const float* src, size_t count, DataType dtype, void* dst, float scale,
+                      int32_t zero_point) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      std::memcpy(dst, src, count * sizeof(float));
+      break;
+    case DataType::FLOAT16: {
+      uint16_t* half = static_cast<uint16_t*>(dst);
+      for (size_t i = 0; i < count; ++i) {
+        half[i] = floatToHalf(src[i]);
+      }
+      break;
+    }
+    case DataType::INT8:
+      fromFloat(src, count, static_cast<int8_t*>(dst), scale, zero_point);
+      break;
+    case DataType::UINT8:
+      fromFloat(src, count, static_cast<uint8_t*>(dst), scale, zero_point);
+      break;
+    case DataType::INT16:
+      fromFloat(src, count, static_cast<int16_t*>(dst), scale, zero_point);
+      break;
+  }
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
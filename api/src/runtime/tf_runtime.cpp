@@ -1,9 +1,14 @@
 #include "runtime/tf_runtime.h"
+#include "runtime/compute_pool.h"
+#include "runtime/runtime_plugin.h"
 #include "runtime/runtime_manager.h"
 
 #ifdef USE_TFLITE
 
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <string>
 
 #include "tensorflow/lite/interpreter.h"
 #include "tensorflow/lite/kernels/register.h"
@@ -12,12 +17,32 @@
 namespace cochl_api {
 namespace runtime {
 
+TFRuntime::ThreadShare::ThreadShare() : reservation(0), threads(0) {
+  reservation = ComputePool::instance().acquireBackendThreads(
+      [this](size_t share) { threads.store(share, std::memory_order_relaxed); });
+}
+
+TFRuntime::ThreadShare::~ThreadShare() {
+  ComputePool::instance().releaseBackendThreads(reservation);
+}
+
 TFRuntime::TFRuntime()
     : initialized_(false),
+      num_threads_(0),
+      rebuilt_threads_(0),
       input_size_(0),
       output_size_(0) {}
 
-TFRuntime::~TFRuntime() = default;
+TFRuntime::~TFRuntime() {
+  // A background rebuild reads this runtime; interpreters (and their XNNPACK workers) must go
+  // before the budget is returned
+  if (rebuilt_.valid()) {
+    rebuilt_.wait();
+  }
+  interpreter_.reset();
+  bound_interpreter_.reset();
+  share_.reset();
+}
 
 bool TFRuntime::loadModel(const char* model_path) {
   std::cout << "[TFRuntime] Loading model from: " << model_path << std::endl;
@@ -29,46 +54,320 @@ bool TFRuntime::loadModel(const char* model_path) {
     return false;
   }
 
+  if (!initInterpreter()) {
+    return false;
+  }
+
+  std::cout << "[TFRuntime] Input size: " << input_size_ << std::endl;
+  std::cout << "[TFRuntime] Output size: " << output_size_ << std::endl;
+  std::cout << "[TFRuntime] Threads: " << num_threads_ << std::endl;
+  std::cout << "[TFRuntime] Model loaded successfully" << std::endl;
+
+  return true;
+}
+
+std::unique_ptr<IRuntime> TFRuntime::clone() const {
+  if (!initialized_) {
+    return nullptr;
+  }
+
+  // New interpreter (tensor arena, delegate state) over the same flatbuffer. An explicit
+  // thread count (e.g. from auto-tuning) carries over, and so does the model's budget share.
+  auto runtime = std::make_unique<TFRuntime>();
+  runtime->model_ = model_;
+  runtime->share_ = share_;
+  runtime->num_threads_ = num_threads_;
+  runtime->native_shapes_ = native_shapes_;
+  runtime->input_info_ = input_info_;
+  runtime->output_info_ = output_info_;
+  runtime->input_size_ = input_size_;
+  runtime->output_size_ = output_size_;
+  if (!runtime->initInterpreter()) {
+    return nullptr;
+  }
+  return runtime;
+}
+
+namespace {
+
+size_t tensorSize(const TfLiteTensor* tensor) {
+  size_t size = 1;
+  for (int i = 0; i < tensor->dims->size; ++i) {
+    size *= tensor->dims->data[i];
+  }
+  return size;
+}
+
+bool toDataType(TfLiteType type, DataType& dtype) {
+  switch (type) {
+    case kTfLiteFloat32:
+      dtype = DataType::FLOAT32;
+      return true;
+    case kTfLiteFloat16:
+      dtype = DataType::FLOAT16;
+      return true;
+    case kTfLiteInt8:
+      dtype = DataType::INT8;
+      return true;
+    case kTfLiteUInt8:
+      dtype = DataType::UINT8;
+      return true;
+    case kTfLiteInt16:
+      dtype = DataType::INT16;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Per-sample info of a tensor. 4D inputs are reported NCHW, as callers lay them out;
+// outputs are copied out as the interpreter writes them, so keep their NHWC shape
+TensorInfo tensorInfo(const TfLiteTensor* tensor, const char* name, const std::string& fallback,
+                      bool to_nchw) {
+  const TfLiteIntArray* dims = tensor->dims;
+  TensorInfo info;
+  info.name = name && *name ? name : fallback;
+  toDataType(tensor->type, info.dtype);
+  info.scale = tensor->params.scale;
+  info.zero_point = tensor->params.zero_point;
+  if (to_nchw && dims->size == 4) {
+    info.shape = {1, dims->data[3], dims->data[1], dims->data[2]};
+  } else {
+    info.shape.assign(dims->data, dims->data + dims->size);
+    if (!info.shape.empty()) info.shape[0] = 1;
+  }
+  info.size = 1;
+  for (auto dim : info.shape) {
+    info.size *= static_cast<size_t>(dim);
+  }
+  return info;
+}
+
+}  // namespace
+
+bool TFRuntime::initInterpreter() {
+  // Size the interpreter (and the XNNPACK delegate) from the shared thread budget
+  if (num_threads_ == 0 && !share_) {
+    share_ = std::make_shared<ThreadShare>();
+  }
+  if (share_) {
+    num_threads_ = share_->threads.load(std::memory_order_relaxed);
+  }
+
+  interpreter_ = buildInterpreter(num_threads_);
+  interpreter_key_.clear();
+  if (!interpreter_) {
+    return false;
+  }
+
+  // Allocate tensors
+  if (interpreter_->AllocateTensors() != kTfLiteOk) {
+    std::cerr << "[TFRuntime] Failed to allocate tensors" << std::endl;
+    return false;
+  }
+
+  // Read once per model: rebuilds and clones keep the same inputs and outputs
+  if (input_info_.empty() && !readTensorInfo()) {
+    return false;
+  }
+  interpreter_key_ = makePlanKey(native_shapes_);
+
+  initialized_ = true;
+  return true;
+}
+
+bool TFRuntime::readTensorInfo() {
+  // Cache every input's exported shape (NHWC in the interpreter, NCHW for callers)
+  const tflite::Interpreter& interpreter = *interpreter_;
+  native_shapes_.clear();
+  input_info_.clear();
+  for (size_t i = 0; i < interpreter.inputs().size(); ++i) {
+    const TfLiteTensor* tensor = interpreter.tensor(interpreter.inputs()[i]);
+    const TfLiteIntArray* dims = tensor->dims;
+    if (dims->size == 4) {
+      native_shapes_.push_back({dims->data[0], dims->data[3], dims->data[1], dims->data[2]});
+    } else {
+      native_shapes_.emplace_back(dims->data, dims->data + dims->size);
+    }
+    input_info_.push_back(tensorInfo(tensor, interpreter.GetInputName(i),
+                                     "input_" + std::to_string(i), true));
+  }
+
+  output_info_.clear();
+  for (size_t i = 0; i < interpreter.outputs().size(); ++i) {
+    const TfLiteTensor* tensor = interpreter.tensor(interpreter.outputs()[i]);
+    output_info_.push_back(tensorInfo(tensor, interpreter.GetOutputName(i),
+                                      "output_" + std::to_string(i), false));
+  }
+
+  if (native_shapes_.empty() || output_info_.empty()) {
+    std::cerr << "[TFRuntime] Model has no input or no output" << std::endl;
+    input_info_.clear();
+    return false;
+  }
+
+  // Sizes of the first input and output, as used by runInference()
+  input_size_ = tensorSize(interpreter.tensor(interpreter.inputs()[0]));
+  output_size_ = tensorSize(interpreter.tensor(interpreter.outputs()[0]));
+  return true;
+}
+
+std::unique_ptr<tflite::Interpreter> TFRuntime::buildInterpreter(size_t num_threads) const {
   // Build interpreter
   tflite::ops::builtin::BuiltinOpResolver resolver;
   tflite::InterpreterBuilder builder(*model_, resolver);
+  builder.SetNumThreads(static_cast<int>(num_threads));
 
-  interpreter_ = std::make_unique<tflite::Interpreter>();
-  if (builder(&interpreter_) != kTfLiteOk) {
+  std::unique_ptr<tflite::Interpreter> interpreter;
+  if (builder(&interpreter) != kTfLiteOk || !interpreter) {
     std::cerr << "[TFRuntime] Failed to build interpreter" << std::endl;
+    return nullptr;
+  }
+  return interpreter;
+}
+
+bool TFRuntime::resizeInterpreter(const std::vector<std::vector<int64_t>>& input_shapes) {
+  std::vector<int64_t> key = makePlanKey(input_shapes);
+  if (key == interpreter_key_) {
+    return true;
+  }
+
+  interpreter_key_.clear();
+  if (resizeInputs(*interpreter_, input_shapes)) {
+    interpreter_key_ = key;
+    return true;
+  }
+
+  // Leave the interpreter usable at the exported shapes
+  if (resizeInputs(*interpreter_, native_shapes_)) {
+    interpreter_key_ = makePlanKey(native_shapes_);
+  }
+  return false;
+}
+
+bool TFRuntime::resizeInputs(tflite::Interpreter& interpreter,
+                             const std::vector<std::vector<int64_t>>& input_shapes) const {
+  if (input_shapes.size() != native_shapes_.size()) {
+    std::cerr << "[TFRuntime] Model takes " << native_shapes_.size() << " inputs, got "
+              << input_shapes.size() << std::endl;
     return false;
   }
 
-  // Allocate tensors
-  if (interpreter_->AllocateTensors() != kTfLiteOk) {
-    std::cerr << "[TFRuntime] Failed to allocate tensors" << std::endl;
+  for (size_t i = 0; i < input_shapes.size(); ++i) {
+    const std::vector<int64_t>& input_shape = input_shapes[i];
+    if (input_shape.size() != native_shapes_[i].size()) {
+      std::cerr << "[TFRuntime] Input " << i << " is " << native_shapes_[i].size() << "D, got "
+                << input_shape.size() << "D" << std::endl;
+      return false;
+    }
+
+    // Interpreter dims: NCHW -> NHWC for images, as-is otherwise
+    std::vector<int> dims(input_shape.begin(), input_shape.end());
+    if (dims.size() == 4) {
+      dims = {dims[0], dims[2], dims[3], dims[1]};
+    }
+    for (int dim : dims) {
+      if (dim <= 0) {
+        std::cerr << "[TFRuntime] Invalid input dimension: " << dim << std::endl;
+        return false;
+      }
+    }
+
+    if (interpreter.ResizeInputTensor(interpreter.inputs()[i], dims) != kTfLiteOk) {
+      std::cerr << "[TFRuntime] Input " << i << " cannot be resized to the requested shape"
+                << std::endl;
+      return false;
+    }
+  }
+
+  if (interpreter.AllocateTensors() != kTfLiteOk) {
+    std::cerr << "[TFRuntime] Model cannot be resized to the requested input shape" << std::endl;
     return false;
   }
+  return true;
+}
 
-  // Cache input/output sizes
-  int input_idx = interpreter_->inputs()[0];
-  TfLiteTensor* input_tensor = interpreter_->tensor(input_idx);
-  input_size_ = 1;
-  for (int i = 0; i < input_tensor->dims->size; ++i) {
-    input_size_ *= input_tensor->dims->data[i];
+size_t TFRuntime::prepareShape(const std::vector<int64_t>& input_shape) {
+  if (!initialized_ || input_shape.empty()) {
+    return 0;
   }
 
-  int output_idx = interpreter_->outputs()[0];
-  const TfLiteTensor* output_tensor = interpreter_->tensor(output_idx);
-  output_size_ = 1;
-  for (int i = 0; i < output_tensor->dims->size; ++i) {
-    output_size_ *= output_tensor->dims->data[i];
+  if (!resizeInterpreter({input_shape})) {
+    return 0;
   }
+  prepared_shapes_.insert(makePlanKey({input_shape}));
+  return tensorSize(interpreter_->tensor(interpreter_->outputs()[0]));
+}
 
-  std::cout << "[TFRuntime] Input size: " << input_size_ << std::endl;
-  std::cout << "[TFRuntime] Output size: " << output_size_ << std::endl;
+bool TFRuntime::setNumThreads(size_t num_threads) {
+  if (!model_) {
+    std::cerr << "[TFRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
 
-  initialized_ = true;
-  std::cout << "[TFRuntime] Model loaded successfully" << std::endl;
+  // XNNPACK sizes its workers when the delegate is applied, so the interpreters are rebuilt
+  if (rebuilt_.valid()) {
+    rebuilt_.wait();
+    rebuilt_ = {};
+  }
+  interpreter_.reset();
+  unbindBuffers();
+  share_.reset();
+  num_threads_ = num_threads;
 
+  if (!initInterpreter()) {
+    initialized_ = false;
+    return false;
+  }
+
+  std::cout << "[TFRuntime] Threads: " << num_threads_ << std::endl;
   return true;
 }
 
+void TFRuntime::applyThreadShare() {
+  if (!share_) {
+    return;
+  }
+
+  if (rebuilt_.valid()) {
+    if (rebuilt_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return;
+    }
+    // Allocated at the exported shapes; the call resizes it if it needs others
+    std::unique_ptr<tflite::Interpreter> rebuilt = rebuilt_.get();
+    if (rebuilt) {
+      interpreter_ = std::move(rebuilt);
+      interpreter_key_ = makePlanKey(native_shapes_);
+    }
+    // On failure the current interpreter stays, without retrying for this share
+    num_threads_ = rebuilt_threads_;
+  }
+
+  size_t share = share_->threads.load(std::memory_order_relaxed);
+  if (share == num_threads_) {
+    return;
+  }
+
+  // XNNPACK sizes its workers when the delegate is applied, so a new share needs a new
+  // interpreter. It is built (on a thread that inherits the caller's cpus) while calls keep
+  // running on the current one (bound buffers keep theirs).
+  rebuilt_threads_ = share;
+  rebuilt_ = std::async(std::launch::async, [this, share]() {
+    std::unique_ptr<tflite::Interpreter> interpreter = buildInterpreter(share);
+    if (!interpreter || interpreter->AllocateTensors() != kTfLiteOk) {
+      std::cerr << "[TFRuntime] Failed to rebuild the interpreter with " << share << " threads"
+                << std::endl;
+      return std::unique_ptr<tflite::Interpreter>();
+    }
+    std::cout << "[TFRuntime] Threads rebalanced: " << share << std::endl;
+    return interpreter;
+  });
+}
+
+bool TFRuntime::setCpuSet(const std::vector<int>& cpus) {
+  return setNumThreads(cpus.size());
+}
+
 bool TFRuntime::runInference(const float* input, const std::vector<int64_t>& input_shape,
                               float* output) {
   if (!initialized_) {
@@ -86,46 +385,264 @@ bool TFRuntime::runInference(const float* input, const std::vector<int64_t>& inp
     return false;
   }
 
-  float* input_tensor = interpreter_->typed_input_tensor<float>(0);
+  return invoke({{input, DataType::FLOAT32, input_shape}}, {{output, DataType::FLOAT32}});
+}
 
-  // Input is in NCHW format, TFLite expects NHWC, so convert NCHW -> NHWC
-  if (input_shape.size() == 4) {
-    // input_shape is NCHW: [N, C, H, W]
-    int N = input_shape[0];
-    int C = input_shape[1];
-    int H = input_shape[2];
-    int W = input_shape[3];
+bool TFRuntime::runBatch(const float* inputs, size_t batch_size,
+                         const std::vector<int64_t>& sample_shape, float* outputs) {
+  if (!initialized_) {
+    std::cerr << "[TFRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
 
-    // Convert NCHW -> NHWC
-    for (int n = 0; n < N; ++n) {
-      for (int c = 0; c < C; ++c) {
-        for (int h = 0; h < H; ++h) {
-          for (int w = 0; w < W; ++w) {
-            int nchw_idx = n * C * H * W + c * H * W + h * W + w;
-            int nhwc_idx = n * H * W * C + h * W * C + w * C + c;
-            input_tensor[nhwc_idx] = input[nchw_idx];
-          }
-        }
-      }
+  if (!inputs || !outputs || batch_size == 0) {
+    std::cerr << "[TFRuntime] Invalid batch input or output" << std::endl;
+    return false;
+  }
+
+  if (sample_shape.empty()) {
+    std::cerr << "[TFRuntime] Empty input shape" << std::endl;
+    return false;
+  }
+
+  // One Invoke() over the whole batch amortizes interpreter overhead
+  std::vector<int64_t> batch_shape = sample_shape;
+  batch_shape[0] = static_cast<int64_t>(batch_size);
+  return invoke({{inputs, DataType::FLOAT32, batch_shape}}, {{outputs, DataType::FLOAT32}});
+}
+
+bool TFRuntime::runMulti(const std::vector<const float*>& inputs,
+                         const std::vector<std::vector<int64_t>>& input_shapes,
+                         const std::vector<float*>& outputs) {
+  if (inputs.size() != input_shapes.size()) {
+    std::cerr << "[TFRuntime] One shape per input required" << std::endl;
+    return false;
+  }
+
+  std::vector<InputTensor> typed_inputs;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    typed_inputs.push_back({inputs[i], DataType::FLOAT32, input_shapes[i]});
+  }
+  std::vector<OutputTensor> typed_outputs;
+  for (float* output : outputs) {
+    typed_outputs.push_back({output, DataType::FLOAT32});
+  }
+  return runTyped(typed_inputs, typed_outputs);
+}
+
+bool TFRuntime::runTyped(const std::vector<InputTensor>& inputs,
+                         const std::vector<OutputTensor>& outputs) {
+  if (!initialized_) {
+    std::cerr << "[TFRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
+
+  if (inputs.size() != input_info_.size() || outputs.size() != output_info_.size()) {
+    std::cerr << "[TFRuntime] Model takes " << input_info_.size() << " inputs and "
+              << output_info_.size() << " outputs" << std::endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!inputs[i].data || inputs[i].shape.empty()) {
+      std::cerr << "[TFRuntime] Invalid input " << i << std::endl;
+      return false;
     }
-  } else {
-    std::cerr << "[TFRuntime] TFLite runtime requires 4D tensor (NCHW)" << std::endl;
+  }
+  for (const auto& output : outputs) {
+    if (!output.data) {
+      std::cerr << "[TFRuntime] Invalid output pointer" << std::endl;
+      return false;
+    }
+  }
+
+  return invoke(inputs, outputs);
+}
+
+bool TFRuntime::invoke(const std::vector<InputTensor>& inputs,
+                       const std::vector<OutputTensor>& outputs) {
+  applyThreadShare();
+
+  // Shapes are keyed in NCHW whichever layout the caller wrote
+  std::vector<std::vector<int64_t>> input_shapes;
+  for (const auto& input : inputs) {
+    input_shapes.push_back(convertShape(input.shape, input.layout, TensorLayout::NCHW));
+  }
+
+  if (!resizeInterpreter(input_shapes)) {
     return false;
   }
+  tflite::Interpreter* interpreter = interpreter_.get();
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    TfLiteTensor* tensor = interpreter->tensor(interpreter->inputs()[i]);
+    DataType native;
+    if (!toDataType(tensor->type, native)) {
+      std::cerr << "[TFRuntime] Unsupported type of input " << i << std::endl;
+      return false;
+    }
+
+    const std::vector<int64_t>& input_shape = inputs[i].shape;
+    size_t input_count = 1;
+    for (auto dim : input_shape) {
+      input_count *= static_cast<size_t>(dim);
+    }
+
+    // Data of the model's own type goes straight in; anything else is converted by value
+    // (and quantized with the tensor's parameters)
+    const void* input = inputs[i].data;
+    if (inputs[i].dtype != native) {
+      const float* values = static_cast<const float*>(input);
+      if (inputs[i].dtype != DataType::FLOAT32) {
+        scratch_values_.resize(input_count);
+        convertToFloat(input, inputs[i].dtype, input_count, scratch_values_.data());
+        values = scratch_values_.data();
+      }
+      scratch_bytes_.resize(input_count * dataTypeSize(native));
+      convertFromFloat(values, input_count, native, scratch_bytes_.data(), tensor->params.scale,
+                       tensor->params.zero_point);
+      input = scratch_bytes_.data();
+    }
+
+    // TFLite computes in NHWC: NCHW images are transposed, NHWC images, sequences and
+    // feature vectors are copied as they are
+    convertLayout(input, tensor->data.raw, dataTypeSize(native), input_shape, inputs[i].layout,
+                  TensorLayout::NHWC);
+  }
 
   // Run inference
-  if (interpreter_->Invoke() != kTfLiteOk) {
+  if (interpreter->Invoke() != kTfLiteOk) {
     std::cerr << "[TFRuntime] Inference failed" << std::endl;
     return false;
   }
 
-  // Copy output data
-  std::copy(interpreter_->typed_output_tensor<float>(0),
-            interpreter_->typed_output_tensor<float>(0) + output_size_, output);
+  // Shapes not prepared with prepareShape() must produce the default per-sample outputs:
+  // callers sized their buffers from getOutputSize()
+  bool prepared = prepared_shapes_.count(interpreter_key_) > 0;
+  size_t batch = static_cast<size_t>(input_shapes[0][0]);
+
+  // Copy output data (runInference reads the first output only)
+  for (size_t i = 0; i < outputs.size() && i < interpreter->outputs().size(); ++i) {
+    const TfLiteTensor* tensor = interpreter->tensor(interpreter->outputs()[i]);
+    DataType native;
+    if (!toDataType(tensor->type, native)) {
+      std::cerr << "[TFRuntime] Unsupported type of output " << i << std::endl;
+      return false;
+    }
+
+    size_t output_count = tensorSize(tensor);
+    if (!prepared && output_count != output_info_[i].size * batch) {
+      std::cerr << "[TFRuntime] Output size mismatch. Expected: " << output_info_[i].size * batch
+                << ", Got: " << output_count << std::endl;
+      return false;
+    }
+    if (outputs[i].dtype == native) {
+      std::memcpy(outputs[i].data, tensor->data.raw, output_count * dataTypeSize(native));
+      continue;
+    }
+
+    // Dequantized to real values, then converted to the requested type
+    float* values = static_cast<float*>(outputs[i].data);
+    if (outputs[i].dtype != DataType::FLOAT32) {
+      scratch_values_.resize(output_count);
+      values = scratch_values_.data();
+    }
+    convertToFloat(tensor->data.raw, native, output_count, values, tensor->params.scale,
+                   tensor->params.zero_point);
+    if (outputs[i].dtype != DataType::FLOAT32) {
+      convertFromFloat(values, output_count, outputs[i].dtype, outputs[i].data);
+    }
+  }
 
   return true;
 }
 
+bool TFRuntime::bindBuffers(const std::vector<InputTensor>& inputs,
+                            const std::vector<OutputTensor>& outputs) {
+  unbindBuffers();
+  if (!initialized_ || inputs.size() != input_info_.size() ||
+      outputs.size() != output_info_.size()) {
+    return false;
+  }
+
+  // An interpreter of its own: the instance's keeps its arena for runInference()
+  std::vector<std::vector<int64_t>> input_shapes;
+  for (const auto& input : inputs) {
+    input_shapes.push_back(convertShape(input.shape, input.layout, TensorLayout::NCHW));
+  }
+  std::unique_ptr<tflite::Interpreter> bound = buildInterpreter(num_threads_);
+  if (!bound || !resizeInputs(*bound, input_shapes)) {
+    return false;
+  }
+  tflite::Interpreter* interpreter = bound.get();
+
+  // The buffer replaces the arena memory of the tensor, so it must match it exactly
+  auto bind = [interpreter](int tensor_index, void* data, DataType dtype) {
+    const TfLiteTensor* tensor = interpreter->tensor(tensor_index);
+    DataType native;
+    if (!data || !toDataType(tensor->type, native) || native != dtype ||
+        reinterpret_cast<uintptr_t>(data) % kTensorAlignment != 0) {
+      return false;
+    }
+    TfLiteCustomAllocation allocation{data, tensor->bytes};
+    return interpreter->SetCustomAllocationForTensor(tensor_index, allocation) == kTfLiteOk;
+  };
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    // Images are read in place only if they are already NHWC
+    if (inputs[i].shape.size() == 4 && inputs[i].layout != TensorLayout::NHWC) {
+      return false;
+    }
+    if (!bind(interpreter->inputs()[i], const_cast<void*>(inputs[i].data), inputs[i].dtype)) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (!bind(interpreter->outputs()[i], outputs[i].data, outputs[i].dtype)) {
+      return false;
+    }
+  }
+
+  if (interpreter->AllocateTensors() != kTfLiteOk) {
+    std::cerr << "[TFRuntime] Cannot allocate around the bound buffers" << std::endl;
+    return false;
+  }
+
+  bound_interpreter_ = std::move(bound);
+  std::cout << "[TFRuntime] Bound " << inputs.size() << " input and " << outputs.size()
+            << " output buffers" << std::endl;
+  return true;
+}
+
+bool TFRuntime::runBound() {
+  if (!bound_interpreter_) {
+    std::cerr << "[TFRuntime] No buffers bound" << std::endl;
+    return false;
+  }
+
+  if (bound_interpreter_->Invoke() != kTfLiteOk) {
+    std::cerr << "[TFRuntime] Inference failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void TFRuntime::unbindBuffers() {
+  bound_interpreter_.reset();
+}
+
+std::vector<int64_t> TFRuntime::getInputShape() const {
+  if (!initialized_) {
+    return {};
+  }
+
+  std::vector<int64_t> shape = native_shapes_[0];
+  if (!shape.empty()) {
+    shape[0] = 1;
+  }
+  return shape;
+}
+
 size_t TFRuntime::getInputSize() const {
   return input_size_;
 }
@@ -137,4 +654,9 @@ size_t TFRuntime::getOutputSize() const {
 }  // namespace runtime
 }  // namespace cochl_api
 
+#ifdef COCHL_RUNTIME_PLUGIN
+// Built as libcochl_runtime_<name>.so: entry points for RuntimePlugin
+COCHL_DEFINE_RUNTIME_PLUGIN(cochl_api::runtime::TFRuntime)
+#endif
+
 #endif  // USE_TFLITE
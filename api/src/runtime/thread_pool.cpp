@@ -0,0 +1,158 @@
+#include "runtime/thread_pool.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace cochl_api {
+namespace runtime {
+
+// ThreadPool implementation
+ThreadPool::ThreadPool(size_t num_threads, const ThreadAffinity& affinity)
+    : pinned_cpus_(CpuTopology::get().resolve(affinity)),
+      running_background_(0),
+      active_threads_(std::max<size_t>(1, num_threads)),
+      stop_(false) {
+  for (auto& pending : pending_) {
+    pending.store(0);
+  }
+
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  for (size_t i = 0; i < active_threads_; ++i) {
+    SpawnWorker(i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+  }
+
+  // Notify all workers, including parked ones
+  park_condition_.notify_all();
+  condition_.notify_all();
+
+  // Wait for all workers to finish
+  std::lock_guard<std::mutex> lock(workers_mutex_);
+  for (std::thread& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void ThreadPool::SpawnWorker(size_t index) {
+  workers_.emplace_back([this, index]() { WorkerLoop(index); });
+
+  // Pin worker round-robin over the resolved cpus
+  if (!pinned_cpus_.empty()) {
+    int cpu = pinned_cpus_[index % pinned_cpus_.size()];
+    if (!CpuTopology::pinThread(workers_.back(), cpu)) {
+      std::cerr << "[ThreadPool] Failed to pin worker " << index << " to cpu " << cpu << std::endl;
+    }
+  }
+}
+
+size_t ThreadPool::NextRunnableLane() const {
+  constexpr size_t kBackground = static_cast<size_t>(TaskPriority::BACKGROUND);
+
+  for (size_t lane = 0; lane < kNumPriorities; ++lane) {
+    if (tasks_[lane].empty()) continue;
+
+    // Background work never takes the last free worker, except the only one of a
+    // single-worker pool (see TaskPriority): there it still runs after all queued requests
+    if (lane == kBackground) {
+      size_t active = active_threads_.load(std::memory_order_acquire);
+      size_t background_limit = active > 1 ? active - 1 : 1;
+      if (running_background_ >= background_limit) continue;
+    }
+    return lane;
+  }
+  return kNumPriorities;
+}
+
+bool ThreadPool::AllQueuesEmpty() const {
+  for (const auto& lane : tasks_) {
+    if (!lane.empty()) return false;
+  }
+  return true;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+  constexpr size_t kBackground = static_cast<size_t>(TaskPriority::BACKGROUND);
+
+  auto is_active = [this, index]() {
+    return index < active_threads_.load(std::memory_order_acquire);
+  };
+
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (true) {
+    // Parked: sleep on a separate condition so Submit() never wakes us
+    park_condition_.wait(lock, [this, &is_active]() { return stop_ || is_active(); });
+
+    // Wait for runnable task, stop signal or shrink
+    condition_.wait(lock, [this, &is_active]() {
+      return stop_ || NextRunnableLane() < kNumPriorities || !is_active();
+    });
+
+    // Exit if stopped and no tasks remaining; parked workers leave draining to active ones
+    if (stop_ && (AllQueuesEmpty() || !is_active())) {
+      return;
+    }
+
+    if (!is_active()) {
+      // Shrunk while waiting: hand a possibly consumed notification to an active worker
+      if (!AllQueuesEmpty()) condition_.notify_one();
+      continue;
+    }
+
+    size_t lane = NextRunnableLane();
+    if (lane == kNumPriorities) {
+      // Stopping with only throttled background work left
+      condition_.wait_for(lock, std::chrono::milliseconds(1));
+      continue;
+    }
+
+    // Get task from the highest-priority lane
+    std::function<void()> task = std::move(tasks_[lane].front());
+    tasks_[lane].pop();
+    pending_[lane].fetch_sub(1, std::memory_order_relaxed);
+    if (lane == kBackground) ++running_background_;
+
+    // Execute task
+    lock.unlock();
+    task();
+    lock.lock();
+
+    if (lane == kBackground) {
+      --running_background_;
+      // A throttled background task may be runnable now
+      if (!tasks_[kBackground].empty()) condition_.notify_one();
+    }
+  }
+}
+
+void ThreadPool::Resize(size_t num_threads) {
+  num_threads = std::max<size_t>(1, num_threads);
+
+  {
+    std::lock_guard<std::mutex> workers_lock(workers_mutex_);
+    {
+      std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+      if (stop_) return;
+      active_threads_.store(num_threads, std::memory_order_release);
+    }
+
+    // Spawn only the workers that never existed; parked ones are reactivated
+    for (size_t i = workers_.size(); i < num_threads; ++i) {
+      SpawnWorker(i);
+    }
+  }
+
+  // Wake parked workers (grow) and move surplus ones to the park state (shrink)
+  park_condition_.notify_all();
+  condition_.notify_all();
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
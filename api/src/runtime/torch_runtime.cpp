@@ -1,9 +1,16 @@
 #include "runtime/torch_runtime.h"
+#include "runtime/compute_pool.h"
+#include "runtime/runtime_plugin.h"
 #include "runtime/runtime_manager.h"
 
 #ifdef USE_LIBTORCH
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <string>
 
 #include <torch/script.h>
 #include <torch/torch.h>
@@ -18,41 +25,178 @@ TorchRuntime::TorchRuntime()
 
 TorchRuntime::~TorchRuntime() = default;
 
+namespace {
+
+// Share of the ComputePool budget for the intra-op pool, and the share LibTorch runs with
+std::atomic<size_t> intra_op_share{0};
+std::atomic<size_t> applied_share{0};
+
+}  // namespace
+
+void TorchRuntime::configureThreads() {
+  // Intra-op pool is process-global in LibTorch: it is one ComputePool consumer, whatever
+  // the number of runtimes
+  static std::once_flag configured;
+  std::call_once(configured, []() {
+    try {
+      // Inter-op parallelism would add a second pool on top of the budget
+      at::set_num_interop_threads(1);
+    } catch (const c10::Error& e) {
+      std::cerr << "[TorchRuntime] Inter-op threads already configured: " << e.what() << std::endl;
+    }
+    ComputePool::instance().acquireBackendThreads(
+        [](size_t share) { intra_op_share.store(share, std::memory_order_relaxed); });
+  });
+
+  // Applied here rather than in the listener, which runs under the ComputePool lock
+  size_t share = intra_op_share.load(std::memory_order_relaxed);
+  if (applied_share.exchange(share, std::memory_order_relaxed) != share) {
+    at::set_num_threads(static_cast<int>(share));
+    std::cout << "[TorchRuntime] Intra-op threads: " << share << std::endl;
+  }
+}
+
+bool TorchRuntime::setNumThreads(size_t num_threads) {
+  // at::set_num_threads() would resize the pool every TorchRuntime in the process runs on,
+  // so only the ComputePool share applies
+  return num_threads == 0;
+}
+
+namespace {
+
+// Model outputs in a fixed order: a tensor, a tuple or list of tensors, or a dict of named tensors
+std::vector<torch::Tensor> collectOutputs(const c10::IValue& result,
+                                          std::vector<std::string>* names = nullptr) {
+  std::vector<torch::Tensor> tensors;
+  if (result.isTensor()) {
+    tensors.push_back(result.toTensor());
+  } else if (result.isTuple()) {
+    for (const auto& element : result.toTupleRef().elements()) {
+      tensors.push_back(element.toTensor());
+    }
+  } else if (result.isList()) {
+    for (const auto& element : result.toListRef()) {
+      tensors.push_back(element.toTensor());
+    }
+  } else if (result.isGenericDict()) {
+    // Dicts keep insertion order, i.e. the order the model builds them in
+    for (const auto& entry : result.toGenericDict()) {
+      if (names) names->push_back(entry.key().toStringRef());
+      tensors.push_back(entry.value().toTensor());
+    }
+  } else {
+    TORCH_CHECK(false, "Unsupported model output type: ", result.tagKind());
+  }
+  return tensors;
+}
+
+c10::ScalarType toScalarType(DataType dtype) {
+  switch (dtype) {
+    case DataType::FLOAT16:
+      return torch::kHalf;
+    case DataType::INT8:
+      return torch::kChar;
+    case DataType::UINT8:
+      return torch::kByte;
+    case DataType::INT16:
+      return torch::kShort;
+    case DataType::FLOAT32:
+      break;
+  }
+  return torch::kFloat32;
+}
+
+}  // namespace
+
 bool TorchRuntime::inferShapes() {
   try {
-    // Try common input shapes for image models
-    std::vector<std::vector<int64_t>> common_shapes = {
-      {1, 3, 224, 224},  // ResNet, VGG, etc.
-      {1, 3, 299, 299},  // Inception
-      {1, 3, 512, 512},  // Larger models
-    };
-
-    for (const auto& shape : common_shapes) {
+    std::vector<std::vector<std::vector<int64_t>>> candidates;
+    std::vector<std::string> input_names;
+
+    // Traced modules record the example inputs' sizes in the graph: use them when present
+    auto graph = module_->get_method("forward").graph();
+    std::vector<std::vector<int64_t>> recorded;
+    for (size_t i = 1; i < graph->inputs().size(); ++i) {
+      const torch::jit::Value* value = graph->inputs()[i];
+      input_names.push_back(value->hasDebugName() ? value->debugName()
+                                                  : "input_" + std::to_string(i - 1));
+      if (auto tensor_type = value->type()->cast<c10::TensorType>()) {
+        if (auto sizes = tensor_type->sizes().concrete_sizes()) {
+          recorded.push_back(*sizes);
+        }
+      }
+    }
+    if (!recorded.empty() && recorded.size() == input_names.size()) {
+      candidates.push_back(recorded);
+    }
+
+    // Otherwise try common input shapes for single-input image models
+    if (input_names.size() <= 1) {
+      candidates.insert(candidates.end(), {
+        {{1, 3, 224, 224}},  // ResNet, VGG, etc.
+        {{1, 3, 299, 299}},  // Inception
+        {{1, 3, 512, 512}},  // Larger models
+      });
+    }
+    if (input_names.empty()) {
+      input_names.push_back("input_0");
+    }
+
+    for (const auto& shapes : candidates) {
       try {
-        // Create dummy input
-        auto dummy_input = torch::zeros(shape, torch::kFloat32);
+        // Create dummy inputs
         std::vector<torch::jit::IValue> inputs;
-        inputs.push_back(dummy_input);
+        for (const auto& shape : shapes) {
+          inputs.push_back(torch::zeros(shape, torch::kFloat32));
+        }
 
         // Try forward pass
-        auto output = module_->forward(inputs).toTensor();
+        std::vector<std::string> output_names;
+        std::vector<torch::Tensor> outputs = collectOutputs(module_->forward(inputs), &output_names);
+        if (outputs.empty()) {
+          continue;
+        }
 
-        // Success! Cache the shapes
-        input_shape_ = shape;
-        input_size_ = 1;
-        for (auto dim : shape) {
-          input_size_ *= dim;
+        // Success! Cache the shapes (per sample)
+        input_info_.clear();
+        for (size_t i = 0; i < shapes.size(); ++i) {
+          TensorInfo info;
+          info.name = input_names[i];
+          info.shape = shapes[i];
+          info.shape[0] = 1;
+          info.size = 1;
+          for (auto dim : info.shape) {
+            info.size *= dim;
+          }
+          input_info_.push_back(info);
         }
 
-        output_size_ = output.numel();
+        int64_t batch = std::max<int64_t>(shapes[0][0], 1);
+        output_info_.clear();
+        for (size_t i = 0; i < outputs.size(); ++i) {
+          TensorInfo info;
+          info.name = i < output_names.size() ? output_names[i] : "output_" + std::to_string(i);
+          info.shape = outputs[i].sizes().vec();
+          if (!info.shape.empty()) info.shape[0] = 1;
+          info.size = static_cast<size_t>(outputs[i].numel() / batch);
+          output_info_.push_back(info);
+        }
 
+        input_size_ = input_info_[0].size;
+        output_size_ = output_info_[0].size;
+
+        const std::vector<int64_t>& input_shape = input_info_[0].shape;
         std::cout << "[TorchRuntime] Inferred input shape: [";
-        for (size_t i = 0; i < input_shape_.size(); ++i) {
-          std::cout << input_shape_[i];
-          if (i < input_shape_.size() - 1) std::cout << ", ";
+        for (size_t i = 0; i < input_shape.size(); ++i) {
+          std::cout << input_shape[i];
+          if (i < input_shape.size() - 1) std::cout << ", ";
         }
         std::cout << "], size: " << input_size_ << std::endl;
         std::cout << "[TorchRuntime] Inferred output size: " << output_size_ << std::endl;
+        if (input_info_.size() > 1 || output_info_.size() > 1) {
+          std::cout << "[TorchRuntime] Inputs: " << input_info_.size()
+                    << ", outputs: " << output_info_.size() << std::endl;
+        }
 
         return true;
       } catch (...) {
@@ -73,9 +217,11 @@ bool TorchRuntime::inferShapes() {
 bool TorchRuntime::loadModel(const char* model_path) {
   std::cout << "[TorchRuntime] Loading model from: " << model_path << std::endl;
 
+  configureThreads();
+
   try {
     // Load the model
-    module_ = std::make_unique<torch::jit::script::Module>(
+    module_ = std::make_shared<torch::jit::script::Module>(
         torch::jit::load(model_path));
 
     // Set to eval mode
@@ -97,6 +243,22 @@ bool TorchRuntime::loadModel(const char* model_path) {
   }
 }
 
+std::unique_ptr<IRuntime> TorchRuntime::clone() const {
+  if (!initialized_) {
+    return nullptr;
+  }
+
+  // Same weights and compiled graph; each forward() keeps its own interpreter frame
+  auto runtime = std::make_unique<TorchRuntime>();
+  runtime->module_ = module_;
+  runtime->input_info_ = input_info_;
+  runtime->output_info_ = output_info_;
+  runtime->input_size_ = input_size_;
+  runtime->output_size_ = output_size_;
+  runtime->initialized_ = true;
+  return runtime;
+}
+
 bool TorchRuntime::runInference(const float* input, const std::vector<int64_t>& input_shape,
                                  float* output) {
   if (!initialized_) {
@@ -114,32 +276,189 @@ bool TorchRuntime::runInference(const float* input, const std::vector<int64_t>&
     return false;
   }
 
+  return forward({{input, DataType::FLOAT32, input_shape}}, {{output, DataType::FLOAT32}});
+}
+
+bool TorchRuntime::runBatch(const float* inputs, size_t batch_size,
+                            const std::vector<int64_t>& sample_shape, float* outputs) {
+  if (!initialized_) {
+    std::cerr << "[TorchRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
+
+  if (!inputs || !outputs || batch_size == 0) {
+    std::cerr << "[TorchRuntime] Invalid batch input or output" << std::endl;
+    return false;
+  }
+
+  if (sample_shape.empty()) {
+    std::cerr << "[TorchRuntime] Empty input shape" << std::endl;
+    return false;
+  }
+
+  // One forward() over [N, ...] turns N GEMVs into one GEMM
+  std::vector<int64_t> batch_shape = sample_shape;
+  batch_shape[0] = static_cast<int64_t>(batch_size);
+  return forward({{inputs, DataType::FLOAT32, batch_shape}}, {{outputs, DataType::FLOAT32}});
+}
+
+bool TorchRuntime::runMulti(const std::vector<const float*>& inputs,
+                            const std::vector<std::vector<int64_t>>& input_shapes,
+                            const std::vector<float*>& outputs) {
+  if (inputs.size() != input_shapes.size()) {
+    std::cerr << "[TorchRuntime] One shape per input required" << std::endl;
+    return false;
+  }
+
+  std::vector<InputTensor> typed_inputs;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    typed_inputs.push_back({inputs[i], DataType::FLOAT32, input_shapes[i]});
+  }
+  std::vector<OutputTensor> typed_outputs;
+  for (float* output : outputs) {
+    typed_outputs.push_back({output, DataType::FLOAT32});
+  }
+  return runTyped(typed_inputs, typed_outputs);
+}
+
+bool TorchRuntime::runTyped(const std::vector<InputTensor>& inputs,
+                            const std::vector<OutputTensor>& outputs) {
+  if (!initialized_) {
+    std::cerr << "[TorchRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
+
+  if (inputs.size() != input_info_.size() || outputs.size() != output_info_.size()) {
+    std::cerr << "[TorchRuntime] Model takes " << input_info_.size() << " inputs and "
+              << output_info_.size() << " outputs" << std::endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!inputs[i].data || inputs[i].shape.empty()) {
+      std::cerr << "[TorchRuntime] Invalid input " << i << std::endl;
+      return false;
+    }
+  }
+  for (const auto& output : outputs) {
+    if (!output.data) {
+      std::cerr << "[TorchRuntime] Invalid output pointer" << std::endl;
+      return false;
+    }
+  }
+
+  return forward(inputs, outputs);
+}
+
+TorchRuntime::Plan& TorchRuntime::getPlan(const std::vector<std::vector<int64_t>>& input_shapes) {
+  std::vector<int64_t> key = makePlanKey(input_shapes);
+  if (Plan* plan = plans_.find(key)) {
+    return *plan;
+  }
+
+  Plan plan;
+  for (const auto& shape : input_shapes) {
+    plan.inputs.push_back(torch::empty(shape, torch::TensorOptions().dtype(torch::kFloat32)));
+  }
+  return plans_.insert(key, std::move(plan));
+}
+
+size_t TorchRuntime::prepareShape(const std::vector<int64_t>& input_shape) {
+  if (!initialized_ || input_shape.empty() || input_info_.size() != 1) {
+    return 0;
+  }
+  for (auto dim : input_shape) {
+    if (dim <= 0) return 0;
+  }
+
   try {
-    auto options = torch::TensorOptions().dtype(torch::kFloat32);
+    Plan& plan = getPlan({input_shape});
+    if (plan.output_sizes.empty()) {
+      // Output size of a new shape is only known after running it once
+      plan.inputs[0].zero_();
+      std::vector<torch::jit::IValue> inputs(plan.inputs.begin(), plan.inputs.end());
+      for (const auto& output : collectOutputs(module_->forward(inputs))) {
+        plan.output_sizes.push_back(output.numel());
+      }
+    }
+    return plan.output_sizes.empty() ? 0 : plan.output_sizes[0];
+  } catch (const c10::Error& e) {
+    std::cerr << "[TorchRuntime] Model cannot run the requested input shape: " << e.what()
+              << std::endl;
+    return 0;
+  }
+}
 
-    // Input is always in NCHW format (preprocessing handles conversion)
-    torch::Tensor input_tensor = torch::from_blob(const_cast<float*>(input), input_shape, options).clone();
+bool TorchRuntime::forward(const std::vector<InputTensor>& inputs,
+                           const std::vector<OutputTensor>& outputs) {
+  configureThreads();
+
+  std::vector<std::vector<int64_t>> input_shapes;
+  for (const auto& input : inputs) {
+    input_shapes.push_back(convertShape(input.shape, input.layout, TensorLayout::NCHW));
+    for (auto dim : input.shape) {
+      if (dim <= 0) {
+        std::cerr << "[TorchRuntime] Invalid input dimension: " << dim << std::endl;
+        return false;
+      }
+    }
+  }
 
-    // Prepare inputs for the model
-    std::vector<torch::jit::IValue> inputs;
-    inputs.push_back(input_tensor);
+  try {
+    // Models compute in NCHW; inputs are copied into the plan's tensors instead of
+    // allocating them per call
+    Plan& plan = getPlan(input_shapes);
+    std::vector<torch::jit::IValue> model_inputs;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      bool nhwc = inputs[i].shape.size() == 4 && inputs[i].layout == TensorLayout::NHWC;
+      if (inputs[i].dtype == DataType::FLOAT32 && !nhwc) {
+        std::memcpy(plan.inputs[i].data_ptr<float>(), inputs[i].data,
+                    plan.inputs[i].numel() * sizeof(float));
+      } else {
+        // Widened (and NHWC permuted) by ATen's vectorized copy straight from the caller's buffer
+        torch::Tensor source = torch::from_blob(const_cast<void*>(inputs[i].data), inputs[i].shape,
+                                                toScalarType(inputs[i].dtype));
+        plan.inputs[i].copy_(nhwc ? source.permute({0, 3, 1, 2}) : source);
+      }
+      model_inputs.push_back(plan.inputs[i]);
+    }
 
     // Execute the model
-    torch::Tensor output_tensor = module_->forward(inputs).toTensor();
+    std::vector<torch::Tensor> output_tensors = collectOutputs(module_->forward(model_inputs));
+    if (output_tensors.size() < outputs.size()) {
+      std::cerr << "[TorchRuntime] Model returned " << output_tensors.size() << " outputs, "
+                << outputs.size() << " requested" << std::endl;
+      return false;
+    }
 
-    // Get output shape and flatten
-    output_tensor = output_tensor.flatten();
+    // Shapes not prepared with prepareShape() must produce the default per-sample outputs
+    bool known = !plan.output_sizes.empty();
+    size_t batch = static_cast<size_t>(input_shapes[0][0]);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      // Get output shape and flatten
+      torch::Tensor output_tensor = output_tensors[i].contiguous().flatten();
+
+      size_t expected = known ? plan.output_sizes[i] : output_info_[i].size * batch;
+      size_t total_elements = output_tensor.numel();
+      if (total_elements != expected) {
+        std::cerr << "[TorchRuntime] Output size mismatch. Expected: " << expected
+                  << ", Got: " << total_elements << std::endl;
+        return false;
+      }
 
-    // Verify output size matches cached value
-    size_t total_elements = output_tensor.numel();
-    if (total_elements != output_size_) {
-      std::cerr << "[TorchRuntime] Output size mismatch. Expected: " << output_size_
-                << ", Got: " << total_elements << std::endl;
-      return false;
+      // Copy output data, converted if another type was requested
+      if (output_tensor.scalar_type() != toScalarType(outputs[i].dtype)) {
+        output_tensor = output_tensor.to(toScalarType(outputs[i].dtype));
+      }
+      std::memcpy(outputs[i].data, output_tensor.data_ptr(),
+                  total_elements * dataTypeSize(outputs[i].dtype));
     }
 
-    // Copy output data
-    std::memcpy(output, output_tensor.data_ptr<float>(), output_size_ * sizeof(float));
+    if (!known) {
+      for (const auto& output_tensor : output_tensors) {
+        plan.output_sizes.push_back(output_tensor.numel());
+      }
+    }
 
     return true;
 
@@ -149,6 +468,89 @@ bool TorchRuntime::runInference(const float* input, const std::vector<int64_t>&
   }
 }
 
+bool TorchRuntime::bindBuffers(const std::vector<InputTensor>& inputs,
+                               const std::vector<OutputTensor>& outputs) {
+  unbindBuffers();
+  if (!initialized_ || inputs.size() != input_info_.size() ||
+      outputs.size() != output_info_.size()) {
+    return false;
+  }
+
+  try {
+    auto binding = std::make_unique<Binding>();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (!inputs[i].data || inputs[i].dtype != input_info_[i].dtype) {
+        return false;
+      }
+      torch::Tensor input = torch::from_blob(const_cast<void*>(inputs[i].data), inputs[i].shape,
+                                             toScalarType(inputs[i].dtype));
+      bool nhwc = inputs[i].shape.size() == 4 && inputs[i].layout == TensorLayout::NHWC;
+      binding->inputs.push_back(nhwc ? input.permute({0, 3, 1, 2}) : input);
+    }
+
+    // Output sizes of the bound shapes are learned with one forward() on the current contents
+    std::vector<torch::jit::IValue> model_inputs(binding->inputs.begin(), binding->inputs.end());
+    std::vector<torch::Tensor> results = collectOutputs(module_->forward(model_inputs));
+    if (results.size() < outputs.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      if (!outputs[i].data) {
+        return false;
+      }
+      binding->outputs.push_back(torch::from_blob(outputs[i].data, {results[i].numel()},
+                                                  toScalarType(outputs[i].dtype)));
+    }
+
+    bound_ = std::move(binding);
+    std::cout << "[TorchRuntime] Bound " << inputs.size() << " input and " << outputs.size()
+              << " output buffers" << std::endl;
+    return true;
+  } catch (const c10::Error& e) {
+    std::cerr << "[TorchRuntime] Cannot bind buffers: " << e.what() << std::endl;
+    return false;
+  }
+}
+
+bool TorchRuntime::runBound() {
+  if (!bound_) {
+    std::cerr << "[TorchRuntime] No buffers bound" << std::endl;
+    return false;
+  }
+
+  try {
+    std::vector<torch::jit::IValue> model_inputs(bound_->inputs.begin(), bound_->inputs.end());
+    std::vector<torch::Tensor> results = collectOutputs(module_->forward(model_inputs));
+    if (results.size() < bound_->outputs.size()) {
+      std::cerr << "[TorchRuntime] Model returned " << results.size() << " outputs, "
+                << bound_->outputs.size() << " bound" << std::endl;
+      return false;
+    }
+
+    // Converted and written in one pass, no intermediate contiguous copy
+    for (size_t i = 0; i < bound_->outputs.size(); ++i) {
+      if (results[i].numel() != bound_->outputs[i].numel()) {
+        std::cerr << "[TorchRuntime] Output size mismatch. Expected: "
+                  << bound_->outputs[i].numel() << ", Got: " << results[i].numel() << std::endl;
+        return false;
+      }
+      bound_->outputs[i].copy_(results[i].reshape({-1}));
+    }
+    return true;
+  } catch (const c10::Error& e) {
+    std::cerr << "[TorchRuntime] Inference error: " << e.what() << std::endl;
+    return false;
+  }
+}
+
+void TorchRuntime::unbindBuffers() {
+  bound_.reset();
+}
+
+std::vector<int64_t> TorchRuntime::getInputShape() const {
+  return input_info_.empty() ? std::vector<int64_t>() : input_info_[0].shape;
+}
+
 size_t TorchRuntime::getInputSize() const {
   return input_size_;
 }
@@ -160,4 +562,9 @@ size_t TorchRuntime::getOutputSize() const {
 }  // namespace runtime
 }  // namespace cochl_api
 
+#ifdef COCHL_RUNTIME_PLUGIN
+// Built as libcochl_runtime_<name>.so: entry points for RuntimePlugin
+COCHL_DEFINE_RUNTIME_PLUGIN(cochl_api::runtime::TorchRuntime)
+#endif
+
 #endif  // USE_LIBTORCH
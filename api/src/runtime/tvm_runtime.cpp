@@ -1,15 +1,88 @@
 #include "runtime/tvm_runtime.h"
+#include "runtime/compute_pool.h"
+#include "runtime/runtime_plugin.h"
 
 #ifdef USE_TVM
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <numeric>
+#include <sstream>
+#include <string>
 
 namespace cochl_api {
 namespace runtime {
 
+namespace {
+
+// Share of the ComputePool budget for the TVM workers, and the size of the calling thread's
+// pool (TVM keeps one worker pool per calling thread)
+std::atomic<size_t> worker_share{0};
+thread_local size_t applied_share = 0;
+
+bool configThreadPool(int num_threads) {
+  auto config_threadpool = tvm::ffi::Function::GetGlobal("runtime.config_threadpool");
+  if (!config_threadpool.defined()) {
+    std::cerr << "[TVMRuntime] runtime.config_threadpool is not available" << std::endl;
+    return false;
+  }
+
+  try {
+    // Affinity mode 1 (kBig) is the TVM default: workers on the big cores first
+    config_threadpool.value()(1, num_threads);
+  } catch (const std::exception& e) {
+    std::cerr << "[TVMRuntime] Failed to configure thread pool: " << e.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// DLPack view of a caller buffer; the deleter frees the view, never the data
+struct BorrowedTensor {
+  DLManagedTensor managed;
+  std::vector<int64_t> shape;
+};
+
+tvm::runtime::Tensor borrowTensor(const void* data, const std::vector<int64_t>& shape,
+                                  DLDevice device) {
+  auto* borrowed = new BorrowedTensor();
+  borrowed->shape = shape;
+
+  DLTensor& tensor = borrowed->managed.dl_tensor;
+  tensor.data = const_cast<void*>(data);
+  tensor.device = device;
+  tensor.ndim = static_cast<int32_t>(borrowed->shape.size());
+  tensor.dtype.code = kDLFloat;
+  tensor.dtype.bits = 32;
+  tensor.dtype.lanes = 1;
+  tensor.shape = borrowed->shape.data();
+  tensor.strides = nullptr;
+  tensor.byte_offset = 0;
+
+  borrowed->managed.manager_ctx = borrowed;
+  borrowed->managed.deleter = [](DLManagedTensor* self) {
+    delete static_cast<BorrowedTensor*>(self->manager_ctx);
+  };
+  try {
+    // Rejected (e.g. unaligned) before it takes ownership of the view
+    return tvm::runtime::Tensor::FromDLPack(&borrowed->managed, kTensorAlignment);
+  } catch (...) {
+    delete borrowed;
+    throw;
+  }
+}
+
+}  // namespace
+
 TVMRuntime::TVMRuntime()
-    : input_size_(0), output_size_(0), initialized_(false) {
+    : input_size_(0),
+      output_size_(0),
+      initialized_(false),
+      supports_dynamic_batch_(true),
+      num_threads_(0) {
   // Initialize device to CPU
   device_.device_type = kDLCPU;
   device_.device_id = 0;
@@ -29,83 +102,292 @@ bool TVMRuntime::loadModel(const char* model_path) {
       return false;
     }
 
-    const tvm::ffi::Module& mod = module_.value();
+    if (!initExecutor()) {
+      return false;
+    }
 
-    // Check if this is a Relax VM module by looking for vm_load_executable
-    auto vm_load_func = mod->GetFunction("vm_load_executable");
-    if (vm_load_func.defined()) {
-      std::cout << "[TVMRuntime] Detected Relax VM module, creating VirtualMachine..." << std::endl;
+    // Compiled libraries carry no input metadata: find the default shape
+    initialized_ = true;
+    if (!inferShapes(model_path)) {
+      initialized_ = false;
+      std::cerr << "[TVMRuntime] Failed to determine the model input shape" << std::endl;
+      return false;
+    }
 
-      // Step 1: Call vm_load_executable to get the VM module
-      // This is equivalent to Python's: self.module = rt_mod["vm_load_executable"]()
-      tvm::ffi::Any vm_result = vm_load_func.value()();
-      vm_module_ = vm_result.cast<tvm::ffi::Module>();
+    std::cout << "[TVMRuntime] Model loaded successfully" << std::endl;
+    std::cout << "[TVMRuntime] Input size: " << input_size_ << std::endl;
+    std::cout << "[TVMRuntime] Output size: " << output_size_ << std::endl;
 
-      if (!vm_module_.defined()) {
-        std::cerr << "[TVMRuntime] Failed to create VM module from vm_load_executable" << std::endl;
-        return false;
-      }
-      std::cout << "[TVMRuntime] VM module created from vm_load_executable" << std::endl;
-
-      // Step 2: Initialize the VM with device info
-      // Python equivalent: self.module["vm_initialization"](device_type, device_id, alloc_type)
-      auto vm_init_func = vm_module_.value()->GetFunction("vm_initialization");
-      if (vm_init_func.defined()) {
-        // Args: device_type, device_id, allocator_type (POOLED_ALLOCATOR = 2)
-        int device_type = static_cast<int>(device_.device_type);
-        int device_id = device_.device_id;
-        int alloc_type = 2;  // POOLED_ALLOCATOR
-
-        // Also add CPU device for shape functions (same as Python)
-        vm_init_func.value()(device_type, device_id, alloc_type, kDLCPU, 0, alloc_type);
-        std::cout << "[TVMRuntime] VM initialized with device" << std::endl;
-      } else {
-        std::cerr << "[TVMRuntime] vm_initialization function not found" << std::endl;
-        return false;
-      }
+    return true;
+  } catch (const std::exception& e) {
+    std::cerr << "[TVMRuntime] Exception during model loading: " << e.what() << std::endl;
+    return false;
+  }
+}
 
-      // Step 3: Get the "main" function from VM module
-      auto main_func = vm_module_.value()->GetFunction("main");
-      if (!main_func.defined()) {
-        std::cerr << "[TVMRuntime] Could not find 'main' function in VirtualMachine" << std::endl;
-        return false;
-      }
+std::unique_ptr<IRuntime> TVMRuntime::clone() const {
+  if (!initialized_) {
+    return nullptr;
+  }
+
+  // Share the loaded executable; only the VM instance is per clone
+  auto runtime = std::make_unique<TVMRuntime>();
+  runtime->module_ = module_;
+  runtime->device_ = device_;
+  try {
+    if (!runtime->initExecutor()) {
+      return nullptr;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "[TVMRuntime] Exception while cloning: " << e.what() << std::endl;
+    return nullptr;
+  }
+
+  runtime->input_info_ = input_info_;
+  runtime->output_info_ = output_info_;
+  runtime->input_size_ = input_size_;
+  runtime->output_size_ = output_size_;
+  runtime->num_threads_ = num_threads_;
+  runtime->initialized_ = true;
+  return runtime;
+}
+
+bool TVMRuntime::initExecutor() {
+  const tvm::ffi::Module& mod = module_.value();
+
+  // Check if this is a Relax VM module by looking for vm_load_executable
+  auto vm_load_func = mod->GetFunction("vm_load_executable");
+  if (vm_load_func.defined()) {
+    std::cout << "[TVMRuntime] Detected Relax VM module, creating VirtualMachine..." << std::endl;
 
-      inference_func_ = main_func;
-      std::cout << "[TVMRuntime] 'main' function found in VirtualMachine" << std::endl;
+    // Step 1: Call vm_load_executable to get the VM module
+    // This is equivalent to Python's: self.module = rt_mod["vm_load_executable"]()
+    tvm::ffi::Any vm_result = vm_load_func.value()();
+    vm_module_ = vm_result.cast<tvm::ffi::Module>();
+
+    if (!vm_module_.defined()) {
+      std::cerr << "[TVMRuntime] Failed to create VM module from vm_load_executable" << std::endl;
+      return false;
+    }
+    std::cout << "[TVMRuntime] VM module created from vm_load_executable" << std::endl;
+
+    // Step 2: Initialize the VM with device info
+    // Python equivalent: self.module["vm_initialization"](device_type, device_id, alloc_type)
+    auto vm_init_func = vm_module_.value()->GetFunction("vm_initialization");
+    if (vm_init_func.defined()) {
+      // Args: device_type, device_id, allocator_type (POOLED_ALLOCATOR = 2)
+      int device_type = static_cast<int>(device_.device_type);
+      int device_id = device_.device_id;
+      int alloc_type = 2;  // POOLED_ALLOCATOR
+
+      // Also add CPU device for shape functions (same as Python)
+      vm_init_func.value()(device_type, device_id, alloc_type, kDLCPU, 0, alloc_type);
+      std::cout << "[TVMRuntime] VM initialized with device" << std::endl;
     } else {
-      // Non-VM module: Try to get the main function directly
-      auto func_opt = mod->GetFunction("main");
+      std::cerr << "[TVMRuntime] vm_initialization function not found" << std::endl;
+      return false;
+    }
+
+    // Step 3: Get the "main" function from VM module
+    auto main_func = vm_module_.value()->GetFunction("main");
+    if (!main_func.defined()) {
+      std::cerr << "[TVMRuntime] Could not find 'main' function in VirtualMachine" << std::endl;
+      return false;
+    }
+
+    inference_func_ = main_func;
+    std::cout << "[TVMRuntime] 'main' function found in VirtualMachine" << std::endl;
+  } else {
+    // Non-VM module: Try to get the main function directly
+    auto func_opt = mod->GetFunction("main");
+    if (!func_opt.defined()) {
+      func_opt = mod->GetFunction("__tvm_main__");
       if (!func_opt.defined()) {
-        func_opt = mod->GetFunction("__tvm_main__");
+        func_opt = mod->GetFunction("default");
         if (!func_opt.defined()) {
-          func_opt = mod->GetFunction("default");
-          if (!func_opt.defined()) {
-            std::cerr << "[TVMRuntime] Could not find main/default function in module" << std::endl;
-            return false;
-          }
+          std::cerr << "[TVMRuntime] Could not find main/default function in module" << std::endl;
+          return false;
         }
       }
-      inference_func_ = func_opt;
     }
+    inference_func_ = func_opt;
+  }
 
-    // Set default shapes for ResNet50-like models (NHWC for TFLite-converted models)
-    input_shape_ = {1, 224, 224, 3};  // NHWC format (from TFLite)
-    output_shape_ = {1, 1000};         // ImageNet classes
+  return true;
+}
 
-    input_size_ = calculateSize(input_shape_);
-    output_size_ = calculateSize(output_shape_);
+bool TVMRuntime::inferShapes(const std::string& model_path) {
+  std::vector<std::vector<std::vector<int64_t>>> candidates;
+
+  // Written by the exporters next to the library: one line of dimensions per input
+  std::ifstream shape_file(model_path + ".shape");
+  std::vector<std::vector<int64_t>> recorded;
+  std::string line;
+  while (std::getline(shape_file, line)) {
+    std::istringstream dims(line);
+    std::vector<int64_t> shape;
+    int64_t dim = 0;
+    while (dims >> dim) {
+      shape.push_back(dim);
+    }
+    if (!shape.empty()) {
+      recorded.push_back(shape);
+    }
+  }
+  if (!recorded.empty()) {
+    candidates.push_back(recorded);
+  }
 
-    initialized_ = true;
-    std::cout << "[TVMRuntime] Model loaded successfully" << std::endl;
-    std::cout << "[TVMRuntime] Input size: " << input_size_ << std::endl;
-    std::cout << "[TVMRuntime] Output size: " << output_size_ << std::endl;
+  // Otherwise try common image shapes
+  candidates.push_back({{1, 224, 224, 3}});  // NHWC (TFLite-converted models)
+  candidates.push_back({{1, 3, 224, 224}});  // NCHW (PyTorch/ONNX-converted models)
 
+  for (const auto& shapes : candidates) {
+    std::vector<size_t> output_sizes = prepareShapes(shapes);
+    if (output_sizes.empty()) {
+      continue;
+    }
+
+    size_t batch = static_cast<size_t>(shapes[0][0]);
+    input_info_.clear();
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      TensorInfo info;
+      info.name = "input_" + std::to_string(i);
+      info.shape = shapes[i];
+      info.shape[0] = 1;
+      info.size = calculateSize(info.shape);
+      input_info_.push_back(info);
+    }
+    output_info_.clear();
+    for (size_t i = 0; i < output_sizes.size(); ++i) {
+      TensorInfo info;
+      info.name = "output_" + std::to_string(i);
+      info.size = output_sizes[i] / batch;
+      info.shape = {1, static_cast<int64_t>(info.size)};
+      output_info_.push_back(info);
+    }
+    input_size_ = input_info_[0].size;
+    output_size_ = output_info_[0].size;
+
+    for (const auto& shape : shapes) {
+      std::cout << "[TVMRuntime] Input shape: [";
+      for (size_t i = 0; i < shape.size(); ++i) {
+        std::cout << shape[i] << (i + 1 < shape.size() ? ", " : "");
+      }
+      std::cout << "]" << (shapes == recorded ? " (recorded)" : " (probed)") << std::endl;
+    }
+    if (output_info_.size() > 1) {
+      std::cout << "[TVMRuntime] Outputs: " << output_info_.size() << std::endl;
+    }
     return true;
-  } catch (const std::exception& e) {
-    std::cerr << "[TVMRuntime] Exception during model loading: " << e.what() << std::endl;
+  }
+  return false;
+}
+
+TVMRuntime::Plan& TVMRuntime::getPlan(const std::vector<std::vector<int64_t>>& input_shapes) {
+  std::vector<int64_t> key = makePlanKey(input_shapes);
+  if (Plan* plan = plans_.find(key)) {
+    return *plan;
+  }
+
+  DLDataType dtype;
+  dtype.code = kDLFloat;
+  dtype.bits = 32;
+  dtype.lanes = 1;
+
+  Plan plan;
+  for (const auto& shape : input_shapes) {
+    plan.inputs.push_back(tvm::runtime::Tensor::Empty(tvm::ffi::Shape(shape), dtype, device_));
+  }
+  return plans_.insert(key, std::move(plan));
+}
+
+void TVMRuntime::configureThreads(size_t num_threads) {
+  // All TVMRuntime instances are one ComputePool consumer
+  static std::once_flag registered;
+  std::call_once(registered, []() {
+    ComputePool::instance().acquireBackendThreads(
+        [](size_t share) { worker_share.store(share, std::memory_order_relaxed); });
+  });
+
+  // Applied here rather than in the listener, which runs under the ComputePool lock
+  size_t threads = num_threads > 0 ? num_threads : worker_share.load(std::memory_order_relaxed);
+  if (applied_share != threads && configThreadPool(static_cast<int>(threads))) {
+    applied_share = threads;
+  }
+}
+
+std::vector<tvm::runtime::Tensor> TVMRuntime::call(const Plan& plan) const {
+  configureThreads(num_threads_);
+
+  std::vector<tvm::ffi::AnyView> args(plan.inputs.begin(), plan.inputs.end());
+  tvm::ffi::Any result;
+  inference_func_.value().CallPacked(args.data(), static_cast<int32_t>(args.size()), &result);
+
+  // Multi-output models return a tuple of tensors
+  std::vector<tvm::runtime::Tensor> outputs;
+  if (auto tensor = result.try_cast<tvm::runtime::Tensor>()) {
+    outputs.push_back(*tensor);
+  } else {
+    for (const tvm::ffi::Any& field : result.cast<tvm::ffi::Array<tvm::ffi::Any>>()) {
+      outputs.push_back(field.cast<tvm::runtime::Tensor>());
+    }
+  }
+  return outputs;
+}
+
+std::vector<size_t> TVMRuntime::prepareShapes(const std::vector<std::vector<int64_t>>& input_shapes) {
+  for (const auto& shape : input_shapes) {
+    if (shape.empty()) return {};
+    for (auto dim : shape) {
+      if (dim <= 0) return {};
+    }
+  }
+
+  try {
+    Plan& plan = getPlan(input_shapes);
+    if (plan.output_sizes.empty()) {
+      // Output sizes of new shapes are only known after running them once
+      for (size_t i = 0; i < plan.inputs.size(); ++i) {
+        float* input_data = static_cast<float*>(plan.inputs[i]->data);
+        std::fill(input_data, input_data + calculateSize(input_shapes[i]), 0.0f);
+      }
+      for (const auto& output_tensor : call(plan)) {
+        size_t produced = 1;
+        for (int i = 0; i < output_tensor->ndim; ++i) {
+          produced *= output_tensor->shape[i];
+        }
+        plan.output_sizes.push_back(produced);
+      }
+    }
+    return plan.output_sizes;
+  } catch (const std::exception&) {
+    // Models compiled for static shapes reject other shapes
+    return {};
+  }
+}
+
+size_t TVMRuntime::prepareShape(const std::vector<int64_t>& input_shape) {
+  if (!initialized_ || input_shape.empty()) {
+    return 0;
+  }
+
+  std::vector<size_t> output_sizes = prepareShapes({input_shape});
+  return output_sizes.empty() ? 0 : output_sizes[0];
+}
+
+bool TVMRuntime::setNumThreads(size_t num_threads) {
+  if (!tvm::ffi::Function::GetGlobal("runtime.config_threadpool").defined()) {
+    std::cerr << "[TVMRuntime] runtime.config_threadpool is not available" << std::endl;
     return false;
   }
+
+  // Applied on the thread of the next call, so other instances keep their own count
+  num_threads_ = num_threads;
+  std::cout << "[TVMRuntime] Threads: "
+            << (num_threads > 0 ? std::to_string(num_threads) : std::string("ComputePool share"))
+            << std::endl;
+  return true;
 }
 
 bool TVMRuntime::runInference(const float* input, const std::vector<int64_t>& input_shape,
@@ -125,37 +407,230 @@ bool TVMRuntime::runInference(const float* input, const std::vector<int64_t>& in
     return false;
   }
 
-  // Calculate input size from shape
-  size_t input_size = 1;
-  for (auto dim : input_shape) {
-    input_size *= dim;
+  return execute({input}, {input_shape}, {output});
+}
+
+bool TVMRuntime::runBatch(const float* inputs, size_t batch_size,
+                          const std::vector<int64_t>& sample_shape, float* outputs) {
+  if (!initialized_) {
+    std::cerr << "[TVMRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
+
+  if (!inputs || !outputs || batch_size == 0) {
+    std::cerr << "[TVMRuntime] Invalid batch input or output" << std::endl;
+    return false;
+  }
+
+  if (sample_shape.empty()) {
+    std::cerr << "[TVMRuntime] Empty input shape" << std::endl;
+    return false;
+  }
+
+  // Models compiled with a dynamic batch dimension take the whole batch in one call
+  size_t first = 0;
+  size_t sample_size = calculateSize(sample_shape);
+  if (supports_dynamic_batch_) {
+    std::vector<int64_t> batch_shape = sample_shape;
+    batch_shape[0] = static_cast<int64_t>(batch_size);
+    bool rejected = false;
+    if (execute({inputs}, {batch_shape}, {outputs}, &rejected)) {
+      return true;
+    }
+    if (!rejected) {
+      return false;
+    }
+
+    // Refused with only the batch dimension changed if the first sample alone runs:
+    // a static batch, so remember and fall back to per-sample calls
+    if (!execute({inputs}, {sample_shape}, {outputs})) {
+      return false;
+    }
+    supports_dynamic_batch_ = false;
+    first = 1;
+    std::cout << "[TVMRuntime] Model has a static batch dimension, running batch per sample"
+              << std::endl;
+  }
+
+  for (size_t n = first; n < batch_size; ++n) {
+    if (!execute({inputs + n * sample_size}, {sample_shape}, {outputs + n * output_size_})) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TVMRuntime::runMulti(const std::vector<const float*>& inputs,
+                          const std::vector<std::vector<int64_t>>& input_shapes,
+                          const std::vector<float*>& outputs) {
+  if (!initialized_) {
+    std::cerr << "[TVMRuntime] Runtime not initialized" << std::endl;
+    return false;
+  }
+
+  if (inputs.size() != input_info_.size() || input_shapes.size() != inputs.size() ||
+      outputs.size() != output_info_.size()) {
+    std::cerr << "[TVMRuntime] Model takes " << input_info_.size() << " inputs and "
+              << output_info_.size() << " outputs" << std::endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!inputs[i] || input_shapes[i].empty()) {
+      std::cerr << "[TVMRuntime] Invalid input " << i << std::endl;
+      return false;
+    }
+  }
+  for (float* output : outputs) {
+    if (!output) {
+      std::cerr << "[TVMRuntime] Invalid output pointer" << std::endl;
+      return false;
+    }
+  }
+
+  return execute(inputs, input_shapes, outputs);
+}
+
+bool TVMRuntime::execute(const std::vector<const float*>& inputs,
+                         const std::vector<std::vector<int64_t>>& input_shapes,
+                         const std::vector<float*>& outputs, bool* rejected) {
+  if (rejected) {
+    *rejected = false;
   }
 
   try {
-    // Create input tensor
-    DLDataType dtype;
-    dtype.code = kDLFloat;
-    dtype.bits = 32;
-    dtype.lanes = 1;
+    // Input tensors of these shapes are allocated once and reused
+    Plan& plan = getPlan(input_shapes);
+
+    // Copy input data to tensors
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      float* input_data = static_cast<float*>(plan.inputs[i]->data);
+      std::copy(inputs[i], inputs[i] + calculateSize(input_shapes[i]), input_data);
+    }
+
+    // Run inference and get the output tensors
+    std::vector<tvm::runtime::Tensor> output_tensors = call(plan);
+    if (output_tensors.size() < outputs.size()) {
+      std::cerr << "[TVMRuntime] Model returned " << output_tensors.size() << " outputs, "
+                << outputs.size() << " requested" << std::endl;
+      return false;
+    }
 
-    // Create TVM tensor for input using Tensor::Empty
-    tvm::runtime::Tensor input_tensor = tvm::runtime::Tensor::Empty(
-        tvm::ffi::Shape(input_shape), dtype, device_);
+    // Shapes not prepared with prepareShape() must produce the default per-sample outputs
+    bool known = !plan.output_sizes.empty();
+    size_t batch = static_cast<size_t>(input_shapes[0][0]);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      const tvm::runtime::Tensor& output_tensor = output_tensors[i];
+      size_t output_count = known ? plan.output_sizes[i] : output_info_[i].size * batch;
+      size_t produced = 1;
+      for (int d = 0; d < output_tensor->ndim; ++d) {
+        produced *= output_tensor->shape[d];
+      }
+      if (produced != output_count) {
+        std::cerr << "[TVMRuntime] Output size mismatch. Expected: " << output_count
+                  << ", Got: " << produced << std::endl;
+        return false;
+      }
 
-    // Copy input data to tensor
-    float* input_data = static_cast<float*>(input_tensor->data);
-    std::copy(input, input + input_size, input_data);
+      // Copy output data from tensor
+      float* output_data = static_cast<float*>(output_tensor->data);
+      std::copy(output_data, output_data + output_count, outputs[i]);
+    }
 
-    // Run inference and get output
-    tvm::ffi::Any result = inference_func_.value()(input_tensor);
+    if (!known) {
+      for (const auto& output_tensor : output_tensors) {
+        size_t produced = 1;
+        for (int d = 0; d < output_tensor->ndim; ++d) {
+          produced *= output_tensor->shape[d];
+        }
+        plan.output_sizes.push_back(produced);
+      }
+    }
 
-    // Extract output tensor from result
-    tvm::runtime::Tensor output_tensor = result.cast<tvm::runtime::Tensor>();
+    return true;
+  } catch (const std::exception& e) {
+    // Compiled shape checks throw before running the model
+    if (rejected) {
+      *rejected = true;
+    }
+    std::cerr << "[TVMRuntime] Exception during inference: " << e.what() << std::endl;
+    return false;
+  }
+}
 
-    // Copy output data from tensor
-    float* output_data = static_cast<float*>(output_tensor->data);
-    std::copy(output_data, output_data + output_size_, output);
+std::vector<int64_t> TVMRuntime::getInputShape() const {
+  return input_info_.empty() ? std::vector<int64_t>() : input_info_[0].shape;
+}
 
+bool TVMRuntime::bindBuffers(const std::vector<InputTensor>& inputs,
+                             const std::vector<OutputTensor>& outputs) {
+  unbindBuffers();
+  if (!initialized_ || inputs.size() != input_info_.size() ||
+      outputs.size() != output_info_.size()) {
+    return false;
+  }
+
+  // Compiled functions take float32 in the layout they were built for, with no conversion
+  for (const auto& input : inputs) {
+    if (!input.data || input.dtype != DataType::FLOAT32 ||
+        (input.shape.size() == 4 && input.layout != getInputLayout())) {
+      return false;
+    }
+  }
+  for (const auto& output : outputs) {
+    if (!output.data || output.dtype != DataType::FLOAT32) {
+      return false;
+    }
+  }
+
+  std::vector<std::vector<int64_t>> input_shapes;
+  for (const auto& input : inputs) {
+    input_shapes.push_back(input.shape);
+  }
+  std::vector<size_t> output_sizes = prepareShapes(input_shapes);
+  if (output_sizes.size() < outputs.size()) {
+    return false;
+  }
+
+  try {
+    auto plan = std::make_unique<Plan>();
+    for (const auto& input : inputs) {
+      plan->inputs.push_back(borrowTensor(input.data, input.shape, device_));
+    }
+    plan->output_sizes = output_sizes;
+    bound_plan_ = std::move(plan);
+  } catch (const std::exception& e) {
+    // Unaligned or otherwise unusable buffers
+    std::cerr << "[TVMRuntime] Cannot bind buffers: " << e.what() << std::endl;
+    return false;
+  }
+
+  for (const auto& output : outputs) {
+    bound_outputs_.push_back(static_cast<float*>(output.data));
+  }
+  std::cout << "[TVMRuntime] Bound " << inputs.size() << " input and " << outputs.size()
+            << " output buffers" << std::endl;
+  return true;
+}
+
+bool TVMRuntime::runBound() {
+  if (!bound_plan_) {
+    std::cerr << "[TVMRuntime] No buffers bound" << std::endl;
+    return false;
+  }
+
+  try {
+    std::vector<tvm::runtime::Tensor> output_tensors = call(*bound_plan_);
+    if (output_tensors.size() < bound_outputs_.size()) {
+      std::cerr << "[TVMRuntime] Model returned " << output_tensors.size() << " outputs, "
+                << bound_outputs_.size() << " bound" << std::endl;
+      return false;
+    }
+
+    for (size_t i = 0; i < bound_outputs_.size(); ++i) {
+      const float* output_data = static_cast<const float*>(output_tensors[i]->data);
+      std::copy(output_data, output_data + bound_plan_->output_sizes[i], bound_outputs_[i]);
+    }
     return true;
   } catch (const std::exception& e) {
     std::cerr << "[TVMRuntime] Exception during inference: " << e.what() << std::endl;
@@ -163,6 +638,20 @@ bool TVMRuntime::runInference(const float* input, const std::vector<int64_t>& in
   }
 }
 
+void TVMRuntime::unbindBuffers() {
+  bound_plan_.reset();
+  bound_outputs_.clear();
+}
+
+TensorLayout TVMRuntime::getInputLayout() const {
+  std::vector<int64_t> shape = getInputShape();
+  auto isChannels = [](int64_t dim) { return dim == 1 || dim == 3 || dim == 4; };
+  if (shape.size() == 4 && isChannels(shape[3]) && !isChannels(shape[1])) {
+    return TensorLayout::NHWC;
+  }
+  return TensorLayout::NCHW;
+}
+
 size_t TVMRuntime::getInputSize() const {
   return input_size_;
 }
@@ -182,4 +671,9 @@ size_t TVMRuntime::calculateSize(const std::vector<int64_t>& shape) const {
 }  // namespace runtime
 }  // namespace cochl_api
 
+#ifdef COCHL_RUNTIME_PLUGIN
+// Built as libcochl_runtime_<name>.so: entry points for RuntimePlugin
+COCHL_DEFINE_RUNTIME_PLUGIN(cochl_api::runtime::TVMRuntime)
+#endif
+
 #endif  // USE_TVM
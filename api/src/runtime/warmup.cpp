@@ -0,0 +1,119 @@
+#include "runtime/warmup.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+namespace cochl_api {
+namespace runtime {
+
+namespace {
+
+// Median of the last `window` latencies, and whether they lie within tolerance of it
+bool isSteady(const std::vector<double>& latencies, size_t window, double tolerance,
+              double& median) {
+  std::vector<double> tail(latencies.end() - window, latencies.end());
+  std::sort(tail.begin(), tail.end());
+  median = tail[tail.size() / 2];
+  return tail.back() - tail.front() <= tolerance * median;
+}
+
+}  // namespace
+
+WarmupStats Warmup::run(IRuntime& runtime, const WarmupOptions& options) {
+  WarmupStats stats;
+  if (options.max_runs == 0) {
+    return stats;
+  }
+
+  // Every input at the shape the backend reported or probed at load, so multi-input
+  // models warm up too
+  std::vector<TensorInfo> input_info = runtime.getInputInfo();
+  std::vector<std::vector<int64_t>> shapes;
+  for (const auto& info : input_info) {
+    if (info.shape.empty()) {
+      LOG(WARNING) << "[Warmup] " << runtime.getRuntimeType()
+                   << " does not report the shape of " << info.name << "; skipping warmup";
+      return stats;
+    }
+    shapes.push_back(info.shape);
+  }
+  if (shapes.empty()) {
+    LOG(WARNING) << "[Warmup] " << runtime.getRuntimeType()
+                 << " does not report its inputs; skipping warmup";
+    return stats;
+  }
+
+  std::vector<std::vector<float>> inputs;
+  for (const auto& shape : shapes) {
+    size_t input_size = 1;
+    for (auto dim : shape) {
+      input_size *= static_cast<size_t>(std::max<int64_t>(dim, 1));
+    }
+    std::vector<float> input(input_size);
+    for (size_t i = 0; i < input_size; ++i) {
+      input[i] = static_cast<float>(i % 255) / 255.0f;
+    }
+    inputs.push_back(std::move(input));
+  }
+
+  size_t batch = static_cast<size_t>(std::max<int64_t>(shapes[0][0], 1));
+  std::vector<std::vector<float>> outputs;
+  for (const auto& info : runtime.getOutputInfo()) {
+    outputs.emplace_back(info.size * batch);
+  }
+
+  std::vector<const float*> input_ptrs;
+  for (const auto& input : inputs) {
+    input_ptrs.push_back(input.data());
+  }
+  std::vector<float*> output_ptrs;
+  for (auto& output : outputs) {
+    output_ptrs.push_back(output.data());
+  }
+
+  // The cold run is excluded from the steady-state window
+  size_t window = std::max<size_t>(1, options.window);
+  auto deadline = std::chrono::steady_clock::now() + options.budget;
+  std::vector<double> latencies;
+  while (latencies.size() < options.max_runs) {
+    auto start = std::chrono::steady_clock::now();
+    if (!runtime.runMulti(input_ptrs, shapes, output_ptrs)) {
+      LOG(WARNING) << "[Warmup] Inference failed after " << latencies.size() << " runs";
+      break;
+    }
+    auto end = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+    if (latencies.size() > window &&
+        isSteady(latencies, window, options.tolerance, stats.warm_ms)) {
+      stats.steady = true;
+      break;
+    }
+    if (end >= deadline) {
+      break;
+    }
+  }
+
+  if (latencies.empty()) {
+    return stats;
+  }
+
+  stats.runs = latencies.size();
+  stats.cold_ms = latencies.front();
+  if (!stats.steady) {
+    // Best estimate so far: the most recent runs, leaving out the cold one if possible
+    size_t tail = std::min(window, std::max<size_t>(1, latencies.size() - 1));
+    isSteady(latencies, tail, options.tolerance, stats.warm_ms);
+  }
+
+  LOG(INFO) << "[Warmup] " << runtime.getRuntimeType() << ": cold " << stats.cold_ms
+            << " ms, warm " << stats.warm_ms << " ms after " << stats.runs << " runs"
+            << (stats.steady ? "" : " (not steady)");
+  return stats;
+}
+
+}  // namespace runtime
+}  // namespace cochl_api
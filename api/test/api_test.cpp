@@ -1,15 +1,41 @@
 #include <gtest/gtest.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 #include <chrono>
+#include <condition_variable>
 #include <cmath>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <thread>
+#include <atomic>
+#include <future>
 
 #include "cochl_api_c.h"
+#include "runtime/auto_tuner.h"
+#include "runtime/batch_scheduler.h"
+#include "runtime/cascade.h"
+#include "runtime/cpu_topology.h"
+#include "runtime/custom_runtime.h"
+#include "runtime/instance_pool.h"
+#include "runtime/model_registry.h"
+#include "runtime/model_residency.h"
+#include "runtime/plan_cache.h"
+#include "runtime/result_cache.h"
+#include "runtime/runtime_manager.h"
+#include "runtime/runtime_plugin.h"
+#include "runtime/tensor_types.h"
+#include "runtime/thread_pool.h"
+#include "runtime/warmup.h"
+#include "utils/hash.h"
 
 namespace cochl_api {
 namespace test {
@@ -18,7 +44,31 @@ class ApiTest : public ::testing::Test {
  protected:
   void SetUp() override {}
 
-  void TearDown() override {}
+  void TearDown() override {
+    for (const auto& root : fake_sysfs_) {
+      std::filesystem::remove_all(root);
+    }
+  }
+
+  // Fake sysfs cpu directory: cpu i on core core_ids[i] of package 0, with capacities[i] as its
+  // cpu_capacity if given; removed in TearDown()
+  std::string MakeFakeSysfs(const std::string& name, const std::vector<int>& core_ids,
+                            const std::vector<int>& capacities = {}) {
+    const std::filesystem::path root = std::filesystem::path(::testing::TempDir()) / name;
+    std::filesystem::remove_all(root);
+    for (size_t cpu = 0; cpu < core_ids.size(); ++cpu) {
+      const std::filesystem::path dir = root / ("cpu" + std::to_string(cpu));
+      std::filesystem::create_directories(dir / "topology");
+      if (cpu < capacities.size()) {
+        std::ofstream(dir / "cpu_capacity") << capacities[cpu];
+      }
+      std::ofstream(dir / "topology" / "core_id") << core_ids[cpu];
+      std::ofstream(dir / "topology" / "physical_package_id") << 0;
+    }
+    std::ofstream(root / "online") << "0-" << core_ids.size() - 1;
+    fake_sysfs_.push_back(root.string());
+    return root.string();
+  }
 
   // create dummy data for input sample data
   std::vector<float> CreateDummyInput(size_t size) {
@@ -46,8 +96,7 @@ class ApiTest : public ::testing::Test {
     std::vector<double> times;
     times.reserve(num_runs);
 
-    // Warmup run
-    CochlApi_RunInference(api, input, input_shape, shape_size, output);
+    // No warmup run needed: models are warmed to steady state when they are loaded
 
     for (int i = 0; i < num_runs; ++i) {
       auto start = std::chrono::high_resolution_clock::now();
@@ -80,6 +129,9 @@ class ApiTest : public ::testing::Test {
     std::cout << "  Std Dev: " << result.std_dev_ms << " ms" << std::endl;
     std::cout << "  Throughput: " << std::fixed << std::setprecision(1) << (1000.0 / result.avg_ms) << " inferences/sec" << std::endl;
   }
+
+ private:
+  std::vector<std::string> fake_sysfs_;
 };
 
 }  // namespace test
@@ -424,6 +476,1116 @@ TEST_F(ApiTest, CustomRuntimeResNet50) {
 }
 #endif
 
+#ifdef USE_CUSTOM
+// Two instances share the process-wide compute pool
+TEST_F(ApiTest, SharedComputePool) {
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+
+  CochlApi_SetThreadBudget(2);
+  EXPECT_EQ(CochlApi_GetThreadBudget(), 2u);
+
+  void* first = CochlApi_Create(model_path.c_str());
+  void* second = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+
+  auto input = CreateDummyInput(CochlApi_GetInputSize(first));
+  std::vector<float> output_first(CochlApi_GetOutputSize(first));
+  std::vector<float> output_second(CochlApi_GetOutputSize(second));
+  long long input_shape[] = {1, 3, 224, 224};
+
+  EXPECT_EQ(CochlApi_RunInference(first, input.data(), input_shape, 4, output_first.data()), 1);
+  EXPECT_EQ(CochlApi_RunInference(second, input.data(), input_shape, 4, output_second.data()), 1);
+  EXPECT_EQ(output_first, output_second);
+
+  // Backend pools share the budget with the shared pool, and get it back when they go
+  auto& pool = cochl_api::runtime::ComputePool::instance();
+  CochlApi_SetThreadBudget(4);
+  EXPECT_EQ(pool.getThreadPool()->GetNumThreads(), 4u);
+  size_t backend_share = 0;
+  uint64_t reservation =
+      pool.acquireBackendThreads([&backend_share](size_t share) { backend_share = share; });
+  EXPECT_EQ(backend_share, 2u);
+  EXPECT_EQ(pool.getThreadPool()->GetNumThreads(), 2u);
+  CochlApi_SetThreadBudget(8);
+  EXPECT_EQ(backend_share, 4u);
+
+  // Another consumer only moves the others' share once it is at least halved or doubled
+  CochlApi_SetThreadBudget(12);
+  EXPECT_EQ(backend_share, 6u);
+  size_t other_share = 0;
+  uint64_t other =
+      pool.acquireBackendThreads([&other_share](size_t share) { other_share = share; });
+  EXPECT_EQ(other_share, 4u);
+  EXPECT_EQ(backend_share, 6u);
+  pool.releaseBackendThreads(other);
+  EXPECT_EQ(backend_share, 6u);
+  CochlApi_SetThreadBudget(8);
+  EXPECT_EQ(backend_share, 4u);
+
+  pool.releaseBackendThreads(reservation);
+  EXPECT_EQ(pool.getThreadPool()->GetNumThreads(), 8u);
+
+  CochlApi_Destroy(first);
+  CochlApi_Destroy(second);
+  CochlApi_SetThreadBudget(0);
+}
+#endif
+
+#ifdef USE_CUSTOM
+// A batch of N matches N single-sample calls
+TEST_F(ApiTest, CustomRuntimeBatch) {
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+
+  constexpr size_t BATCH = 3;
+  size_t input_size = CochlApi_GetInputSize(api);
+  size_t output_size = CochlApi_GetOutputSize(api);
+  long long sample_shape[] = {1, 3, 224, 224};
+
+  std::vector<float> inputs(BATCH * input_size);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    inputs[i] = static_cast<float>((i * 7) % 251) / 251.0f;
+  }
+
+  std::vector<float> batch_output(BATCH * output_size);
+  ASSERT_EQ(CochlApi_RunBatch(api, inputs.data(), BATCH, sample_shape, 4, batch_output.data()), 1);
+
+  for (size_t n = 0; n < BATCH; ++n) {
+    std::vector<float> single(output_size);
+    ASSERT_EQ(CochlApi_RunInference(api, inputs.data() + n * input_size, sample_shape, 4,
+                                    single.data()), 1);
+    EXPECT_TRUE(std::equal(single.begin(), single.end(), batch_output.begin() + n * output_size));
+  }
+
+  EXPECT_EQ(CochlApi_RunBatch(api, inputs.data(), 0, sample_shape, 4, batch_output.data()), 0);
+
+  CochlApi_Destroy(api);
+}
+#endif
+
+#ifdef USE_CUSTOM
+// Async requests complete in order with the same result as the sync call
+TEST_F(ApiTest, CustomRuntimeAsync) {
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+
+  constexpr int NUM_FRAMES = 4;
+  size_t input_size = CochlApi_GetInputSize(api);
+  size_t output_size = CochlApi_GetOutputSize(api);
+  long long input_shape[] = {1, 3, 224, 224};
+
+  struct Completion {
+    std::atomic<int> done{0};
+    std::atomic<int> succeeded{0};
+    std::promise<void> all_done;
+  } completion;
+
+  auto on_done = [](int status, void* user_data) {
+    auto* c = static_cast<Completion*>(user_data);
+    c->succeeded += status;
+    if (++c->done == NUM_FRAMES) c->all_done.set_value();
+  };
+
+  // Reuse one input buffer: the API copies each frame before returning
+  std::vector<float> frame(input_size);
+  std::vector<std::vector<float>> outputs(NUM_FRAMES, std::vector<float>(output_size));
+  for (int n = 0; n < NUM_FRAMES; ++n) {
+    std::fill(frame.begin(), frame.end(), 0.1f * (n + 1));
+    ASSERT_EQ(CochlApi_RunInferenceAsync(api, frame.data(), input_shape, 4, outputs[n].data(),
+                                         on_done, &completion), 1);
+  }
+
+  auto status = completion.all_done.get_future().wait_for(std::chrono::seconds(10));
+  ASSERT_EQ(status, std::future_status::ready);
+  EXPECT_EQ(completion.succeeded.load(), NUM_FRAMES);
+
+  for (int n = 0; n < NUM_FRAMES; ++n) {
+    std::fill(frame.begin(), frame.end(), 0.1f * (n + 1));
+    std::vector<float> expected(output_size);
+    ASSERT_EQ(CochlApi_RunInference(api, frame.data(), input_shape, 4, expected.data()), 1);
+    EXPECT_EQ(outputs[n], expected);
+  }
+
+  EXPECT_EQ(CochlApi_RunInferenceAsync(api, frame.data(), input_shape, 4, outputs[0].data(),
+                                       nullptr, nullptr), 0);
+
+  CochlApi_Destroy(api);
+}
+#endif
+
+#ifdef USE_CUSTOM
+// Opening the same file twice shares one loaded model until both are destroyed
+TEST_F(ApiTest, ModelRegistrySharesModel) {
+  using cochl_api::runtime::ModelRegistry;
+
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  const std::string alias_path = std::string(PROJECT_ROOT) + "/models/../models/model.bin";
+  size_t loaded_before = ModelRegistry::instance().getNumModels();
+
+  void* first = CochlApi_Create(model_path.c_str());
+  void* second = CochlApi_Create(alias_path.c_str());
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(ModelRegistry::instance().getNumModels(), loaded_before + 1);
+  EXPECT_EQ(ModelRegistry::makeKey(model_path), ModelRegistry::makeKey(alias_path));
+
+  // Other load settings (e.g. a tuned thread count) get their own load, not the shared one
+  {
+    using namespace cochl_api::runtime;
+    bool loaded = false;
+    auto tuned = ModelRegistry::instance().acquire(model_path, "custom:2t", [&]() {
+      loaded = true;
+      auto runtime = std::make_unique<CustomRuntime>();
+      runtime->loadModel(model_path.c_str());
+      return std::make_shared<RuntimeInstancePool>(std::move(runtime));
+    });
+    ASSERT_NE(tuned, nullptr);
+    EXPECT_TRUE(loaded);
+    EXPECT_EQ(ModelRegistry::instance().getNumModels(), loaded_before + 2);
+  }
+
+  CochlApi_Destroy(first);
+  EXPECT_EQ(ModelRegistry::instance().getNumModels(), loaded_before + 1);
+  CochlApi_Destroy(second);
+  EXPECT_EQ(ModelRegistry::instance().getNumModels(), loaded_before);
+
+  // Content hash is XXH64 (reference vectors)
+  EXPECT_EQ(cochl_api::utils::Hash64("", 0), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(cochl_api::utils::Hash64("abc", 3), 0x44BC2CF5AD770999ULL);
+}
+#endif
+
+#ifdef USE_CUSTOM
+// Inference keeps succeeding on another thread while the model is swapped
+TEST_F(ApiTest, HotModelSwap) {
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  const std::string next_path = ::testing::TempDir() + "/cochl_swap_model.bin";
+  {
+    std::ofstream next(next_path, std::ios::binary);
+    next << "v2";
+  }
+
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+
+  size_t input_size = CochlApi_GetInputSize(api);
+  size_t output_size = CochlApi_GetOutputSize(api);
+  long long input_shape[] = {1, 3, 224, 224};
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> failures{0};
+  std::atomic<int> runs{0};
+  std::thread caller([&]() {
+    std::vector<float> input(input_size, 0.5f);
+    std::vector<float> output(output_size);
+    while (!stop) {
+      if (CochlApi_RunInference(api, input.data(), input_shape, 4, output.data()) != 1) ++failures;
+      ++runs;
+    }
+  });
+
+  while (runs < 2) std::this_thread::yield();
+  EXPECT_EQ(CochlApi_SwapModel(api, next_path.c_str(), input_shape, 4), 1);
+  int runs_at_swap = runs;
+  while (runs < runs_at_swap + 2) std::this_thread::yield();
+  stop = true;
+  caller.join();
+
+  EXPECT_EQ(failures.load(), 0);
+
+  // Unsupported extension: the current model keeps serving
+  EXPECT_EQ(CochlApi_SwapModel(api, "model.unknown", nullptr, 0), 0);
+  std::vector<float> input(input_size, 0.5f), output(output_size);
+  EXPECT_EQ(CochlApi_RunInference(api, input.data(), input_shape, 4, output.data()), 1);
+
+  CochlApi_Destroy(api);
+  std::remove(next_path.c_str());
+}
+#endif
+
+#ifdef USE_CUSTOM
+// First auto-tuned load benchmarks and records the decision; the next one reuses it
+TEST_F(ApiTest, AutoTunerCachesDecision) {
+  using cochl_api::runtime::AutoTuner;
+  using cochl_api::runtime::RuntimeManager;
+
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  const std::string cache_dir = ::testing::TempDir() + "/cochl_tune_cache";
+  setenv("XDG_CACHE_HOME", cache_dir.c_str(), 1);
+  std::remove(AutoTuner::cachePath().c_str());
+
+  size_t budget = cochl_api::runtime::ComputePool::instance().getThreadBudget();
+
+  cochl_api::runtime::TuningOptions options;
+  options.thread_counts = {1, 2};
+  options.warmup_runs = 1;
+  options.timed_runs = 2;
+
+  auto manager = RuntimeManager::createAutoTuned(model_path, options);
+  ASSERT_NE(manager, nullptr);
+  EXPECT_EQ(manager->getInferenceEngineType(), RuntimeManager::InferenceEngine::CUSTOM);
+  EXPECT_TRUE(std::ifstream(AutoTuner::cachePath()).good());
+
+  std::vector<AutoTuner::Candidate> candidates = {
+      {"custom", model_path,
+       []() { return std::unique_ptr<cochl_api::runtime::IRuntime>(new cochl_api::runtime::CustomRuntime()); }}};
+  cochl_api::runtime::TuningResult result;
+  ASSERT_TRUE(AutoTuner(options).tune(candidates, result));
+  EXPECT_TRUE(result.cached);
+  EXPECT_EQ(result.candidate, 0u);
+  EXPECT_TRUE(result.num_threads == 1 || result.num_threads == 2);
+
+  // Without the cache the benchmark runs again
+  options.use_cache = false;
+  ASSERT_TRUE(AutoTuner(options).tune(candidates, result));
+  EXPECT_FALSE(result.cached);
+  EXPECT_GT(result.latency_ms, 0.0);
+
+  // Tuned counts stay with the instances that were benchmarked
+  EXPECT_EQ(cochl_api::runtime::ComputePool::instance().getThreadBudget(), budget);
+
+  manager.reset();
+  std::remove(AutoTuner::cachePath().c_str());
+  unsetenv("XDG_CACHE_HOME");
+}
+#endif
+
+/**
+ * =================================================================
+ *   ThreadPool
+ * =================================================================
+ */
+TEST_F(ApiTest, ThreadPoolLiveResize) {
+  cochl_api::runtime::ThreadPool pool(2);
+  std::vector<int> visited(4096, 0);
+
+  // Resize while ParallelFor chunks are in flight
+  std::thread resizer([&pool]() {
+    for (size_t n : {4u, 1u, 3u, 1u}) {
+      pool.Resize(n);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  for (int round = 0; round < 8; ++round) {
+    pool.ParallelFor(0, visited.size(), [&visited](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        ++visited[i];
+        if (i % 512 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+      }
+    });
+  }
+  resizer.join();
+
+  EXPECT_EQ(pool.GetNumThreads(), 1u);
+  EXPECT_TRUE(std::all_of(visited.begin(), visited.end(), [](int v) { return v == 8; }));
+}
+
+TEST_F(ApiTest, ThreadPoolScheduling) {
+  using cochl_api::runtime::ParallelOptions;
+  using cochl_api::runtime::Schedule;
+  using cochl_api::runtime::TaskPriority;
+
+  cochl_api::runtime::ThreadPool pool(3);
+
+  for (Schedule schedule : {Schedule::STATIC, Schedule::DYNAMIC, Schedule::GUIDED}) {
+    std::vector<std::atomic<int>> visited(1000);
+    std::atomic<int> short_chunks{0};
+    pool.ParallelFor(0, visited.size(), ParallelOptions{schedule, 7},
+                     [&](size_t start, size_t end) {
+                       if (end - start < 7) short_chunks++;
+                       for (size_t i = start; i < end; ++i) visited[i]++;
+                     });
+    EXPECT_TRUE(std::all_of(visited.begin(), visited.end(), [](const auto& v) { return v == 1; }));
+    // Only the tail chunk may be smaller than the grain
+    EXPECT_LE(short_chunks.load(), 1);
+  }
+
+  // A per-loop thread limit holds whatever the pool size
+  for (Schedule schedule : {Schedule::STATIC, Schedule::DYNAMIC, Schedule::GUIDED}) {
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    pool.ParallelFor(0, 64, ParallelOptions{schedule, 1, TaskPriority::NORMAL, 1},
+                     [&](size_t, size_t) {
+                       int now = ++running;
+                       peak = std::max(peak.load(), now);
+                       std::this_thread::sleep_for(std::chrono::microseconds(100));
+                       --running;
+                     });
+    EXPECT_EQ(peak.load(), 1);
+  }
+
+  // 2D tiling covers every (row, channel) pair exactly once
+  std::vector<std::atomic<int>> grid(13 * 29);
+  pool.ParallelFor2D(13, 29, 4, 8, [&](size_t r0, size_t r1, size_t c0, size_t c1) {
+    for (size_t r = r0; r < r1; ++r) {
+      for (size_t c = c0; c < c1; ++c) grid[r * 29 + c]++;
+    }
+  });
+  EXPECT_TRUE(std::all_of(grid.begin(), grid.end(), [](const auto& v) { return v == 1; }));
+
+  std::vector<std::atomic<int>> volume(3 * 5 * 7);
+  pool.ParallelFor3D(3, 5, 7, 2, 2, 3,
+                     [&](size_t i0, size_t i1, size_t j0, size_t j1, size_t k0, size_t k1) {
+                       for (size_t i = i0; i < i1; ++i)
+                         for (size_t j = j0; j < j1; ++j)
+                           for (size_t k = k0; k < k1; ++k) volume[(i * 5 + j) * 7 + k]++;
+                     });
+  EXPECT_TRUE(std::all_of(volume.begin(), volume.end(), [](const auto& v) { return v == 1; }));
+}
+
+TEST_F(ApiTest, ThreadPoolPriorityLanes) {
+  using cochl_api::runtime::ParallelOptions;
+  using cochl_api::runtime::Schedule;
+  using cochl_api::runtime::TaskPriority;
+
+  cochl_api::runtime::ThreadPool pool(2);
+
+  // Saturate the pool with background work
+  std::vector<std::future<void>> background;
+  for (int i = 0; i < 6; ++i) {
+    background.push_back(pool.Submit(TaskPriority::BACKGROUND, []() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  // Background never holds the last worker, so a live request starts right away
+  auto start = std::chrono::steady_clock::now();
+  pool.Submit(TaskPriority::HIGH, []() {}).get();
+  double waited_ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+  EXPECT_LT(waited_ms, 40.0);
+
+  // A background ParallelFor still completes every iteration while high work interleaves
+  std::vector<std::atomic<int>> visited(256);
+  std::thread high_load([&pool]() {
+    for (int i = 0; i < 20; ++i) pool.Submit(TaskPriority::HIGH, []() {}).get();
+  });
+  pool.ParallelFor(0, visited.size(), ParallelOptions{Schedule::DYNAMIC, 4, TaskPriority::BACKGROUND},
+                   [&visited](size_t begin, size_t end) {
+                     for (size_t i = begin; i < end; ++i) visited[i]++;
+                   });
+  high_load.join();
+  EXPECT_TRUE(std::all_of(visited.begin(), visited.end(), [](const auto& v) { return v == 1; }));
+
+  for (auto& future : background) future.get();
+}
+
+/**
+ * =================================================================
+ *   CPU Topology ( big.LITTLE placement )
+ * =================================================================
+ */
+// Concurrent callers are coalesced into one batch and get their own result back
+TEST_F(ApiTest, BatchSchedulerCoalesces) {
+  using cochl_api::runtime::BatchOptions;
+  using cochl_api::runtime::BatchScheduler;
+
+  constexpr size_t NUM_CALLERS = 4;
+  std::vector<size_t> batch_sizes;
+
+  // output = 2 * input, one value per sample
+  auto run_batch = [&batch_sizes](const float* inputs, size_t batch_size,
+                                  const std::vector<int64_t>&, float* outputs) {
+    batch_sizes.push_back(batch_size);
+    for (size_t n = 0; n < batch_size; ++n) outputs[n] = inputs[n] * 2.0f;
+    return true;
+  };
+
+  BatchOptions options;
+  options.max_batch_size = NUM_CALLERS;
+  options.max_delay = std::chrono::seconds(5);  // only a full batch dispatches early
+  BatchScheduler scheduler(run_batch, 1, options);
+
+  std::vector<float> results(NUM_CALLERS, 0.0f);
+  std::vector<std::thread> callers;
+  for (size_t i = 0; i < NUM_CALLERS; ++i) {
+    callers.emplace_back([&scheduler, &results, i]() {
+      float input = static_cast<float>(i + 1);
+      std::vector<int64_t> shape = {1, 1};
+      EXPECT_TRUE(scheduler.run(&input, shape, &results[i]));
+    });
+  }
+  for (auto& caller : callers) caller.join();
+
+  for (size_t i = 0; i < NUM_CALLERS; ++i) {
+    EXPECT_FLOAT_EQ(results[i], 2.0f * (i + 1));
+  }
+  ASSERT_EQ(batch_sizes.size(), 1u);
+  EXPECT_EQ(batch_sizes[0], NUM_CALLERS);
+  EXPECT_EQ(scheduler.getStats().requests, NUM_CALLERS);
+  EXPECT_EQ(scheduler.getStats().max_batch, NUM_CALLERS);
+
+  // A lone request is released by the delay, not held forever
+  BatchOptions short_window;
+  short_window.max_batch_size = NUM_CALLERS;
+  short_window.max_delay = std::chrono::milliseconds(2);
+  BatchScheduler lone(run_batch, 1, short_window);
+  float input = 3.0f, output = 0.0f;
+  EXPECT_TRUE(lone.run(&input, {1, 1}, &output));
+  EXPECT_FLOAT_EQ(output, 6.0f);
+
+  // With two batches in flight the next batch forms while the first one still executes
+  std::mutex gate_mutex;
+  std::condition_variable gate;
+  int executing = 0;
+  auto run_paired = [&](const float* inputs, size_t batch_size, const std::vector<int64_t>&,
+                        float* outputs) {
+    std::unique_lock<std::mutex> lock(gate_mutex);
+    ++executing;
+    gate.notify_all();
+    bool paired = gate.wait_for(lock, std::chrono::seconds(5), [&]() { return executing == 2; });
+    for (size_t n = 0; n < batch_size; ++n) outputs[n] = inputs[n] * 2.0f;
+    return paired;
+  };
+  BatchOptions in_flight;
+  in_flight.max_batch_size = 1;
+  in_flight.max_in_flight = 2;
+  BatchScheduler paired(run_paired, 1, in_flight);
+  EXPECT_EQ(paired.getOptions().max_in_flight, 2u);
+  std::vector<float> paired_results(2, 0.0f);
+  std::vector<std::thread> paired_callers;
+  for (size_t i = 0; i < 2; ++i) {
+    paired_callers.emplace_back([&paired, &paired_results, i]() {
+      float input = static_cast<float>(i + 1);
+      EXPECT_TRUE(paired.run(&input, {1, 1}, &paired_results[i]));
+    });
+  }
+  for (auto& caller : paired_callers) caller.join();
+  EXPECT_EQ(paired_results, (std::vector<float>{2.0f, 4.0f}));
+  EXPECT_EQ(paired.getStats().batches, 2u);
+}
+
+// Concurrent leases get distinct instances; idle clones are dropped again
+TEST_F(ApiTest, RuntimeInstancePoolElastic) {
+  using cochl_api::runtime::IRuntime;
+  using cochl_api::runtime::RuntimeInstancePool;
+
+  // Counts live instances, the clone source included; clones share nothing but the counter
+  struct FakeRuntime : IRuntime {
+    explicit FakeRuntime(std::atomic<int>* live) : live(live) { ++*live; }
+    ~FakeRuntime() override { --*live; }
+    bool loadModel(const char*) override { return true; }
+    bool runInference(const float*, const std::vector<int64_t>&, float*) override { return true; }
+    bool runBatch(const float*, size_t, const std::vector<int64_t>&, float*) override { return true; }
+    std::unique_ptr<IRuntime> clone() const override { return std::make_unique<FakeRuntime>(live); }
+    const char* getRuntimeType() const override { return "Fake"; }
+    size_t getInputSize() const override { return 1; }
+    size_t getOutputSize() const override { return 1; }
+    std::atomic<int>* live;
+  };
+
+  std::atomic<int> live{0};
+  RuntimeInstancePool pool(std::make_unique<FakeRuntime>(&live), 3);
+  EXPECT_EQ(pool.getNumInstances(), 1u);
+
+  {
+    auto a = pool.acquire();
+    auto b = pool.acquire();
+    auto c = pool.acquire();
+    EXPECT_NE(&*a, &*b);
+    EXPECT_NE(&*b, &*c);
+    EXPECT_EQ(pool.getNumInstances(), 3u);
+    EXPECT_EQ(live.load(), 4);
+    EXPECT_EQ(pool.getInputSize(), 1u);
+
+    // At the limit a fourth caller waits for a lease to come back
+    std::atomic<bool> leased{false};
+    std::thread waiter([&pool, &leased]() {
+      auto d = pool.acquire();
+      leased = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(leased.load());
+    { auto released = std::move(c); }
+    waiter.join();
+    EXPECT_TRUE(leased.load());
+    EXPECT_EQ(pool.getNumInstances(), 3u);
+  }
+
+  // Load gone: instances past the idle timeout are dropped down to one
+  pool.setIdleTimeout(std::chrono::milliseconds(0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  { auto lease = pool.acquire(); }
+  EXPECT_EQ(pool.getNumInstances(), 1u);
+  EXPECT_EQ(live.load(), 2);
+}
+
+// Warmup runs until latency settles and reports the cold and warm cost
+TEST_F(ApiTest, WarmupReachesSteadyState) {
+  using namespace cochl_api::runtime;
+
+  // Slow first run (lazy allocation), then constant
+  struct ColdStartRuntime : IRuntime {
+    bool loadModel(const char*) override { return true; }
+    bool runInference(const float*, const std::vector<int64_t>&, float*) override {
+      std::this_thread::sleep_for(std::chrono::milliseconds(runs++ == 0 ? 30 : 2));
+      return true;
+    }
+    bool runBatch(const float*, size_t, const std::vector<int64_t>&, float*) override { return true; }
+    const char* getRuntimeType() const override { return "ColdStart"; }
+    size_t getInputSize() const override { return 4; }
+    size_t getOutputSize() const override { return 1; }
+    std::vector<int64_t> getInputShape() const override { return {1, 4}; }
+    int runs = 0;
+  };
+
+  ColdStartRuntime runtime;
+  WarmupOptions options;
+  options.tolerance = 0.5;
+  WarmupStats stats = Warmup::run(runtime, options);
+  EXPECT_TRUE(stats.steady);
+  EXPECT_GE(stats.runs, options.window + 1);
+  EXPECT_LT(stats.runs, options.max_runs);
+  EXPECT_GT(stats.cold_ms, stats.warm_ms * 5);
+
+  // Budget exhausted before latency can settle
+  options.budget = std::chrono::milliseconds(0);
+  stats = Warmup::run(runtime, options);
+  EXPECT_EQ(stats.runs, 1u);
+  EXPECT_FALSE(stats.steady);
+
+  options.max_runs = 0;
+  EXPECT_EQ(Warmup::run(runtime, options).runs, 0u);
+
+#ifdef USE_CUSTOM
+  // Models are warmed at load and report it through the C API
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+  double cold_ms = 0.0, warm_ms = 0.0;
+  EXPECT_EQ(CochlApi_GetWarmupLatency(api, &cold_ms, &warm_ms), 1);
+  EXPECT_GT(cold_ms, 0.0);
+  EXPECT_GT(warm_ms, 0.0);
+  CochlApi_Destroy(api);
+#endif
+}
+
+// Plans are kept per input shape and the least recently used one makes room
+TEST_F(ApiTest, PlanCacheLru) {
+  using cochl_api::runtime::PlanCache;
+
+  PlanCache<int> plans;
+  ASSERT_EQ(plans.capacity(), PlanCache<int>::kDefaultCapacity);
+  for (int frames = 1; frames <= 4; ++frames) {
+    EXPECT_EQ(plans.find({1, frames}), nullptr);
+    plans.insert({1, frames}, frames);
+  }
+  EXPECT_EQ(plans.getMisses(), 4u);
+
+  // Touch the oldest shape so the second oldest is evicted instead
+  ASSERT_NE(plans.find({1, 1}), nullptr);
+  plans.insert({1, 5}, 5);
+  EXPECT_EQ(plans.size(), 4u);
+  EXPECT_EQ(plans.find({1, 2}), nullptr);
+  ASSERT_NE(plans.find({1, 1}), nullptr);
+  EXPECT_EQ(*plans.find({1, 5}), 5);
+  EXPECT_EQ(plans.getHits(), 3u);
+  EXPECT_EQ(plans.getMisses(), 5u);
+
+#ifdef USE_CUSTOM
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+  const long long shape[] = {1, 3, 112, 112};
+  size_t output_size = CochlApi_PrepareShape(api, shape, 4);
+  EXPECT_EQ(output_size, CochlApi_GetOutputSize(api));
+
+  std::vector<float> input(3 * 112 * 112, 0.5f);
+  std::vector<float> output(output_size);
+  EXPECT_EQ(CochlApi_RunInference(api, input.data(), shape, 4, output.data()), 1);
+  CochlApi_Destroy(api);
+#endif
+}
+
+// Repeated inputs are answered from the cache; the byte budget evicts the least recently used
+TEST_F(ApiTest, ResultCacheLru) {
+  using cochl_api::runtime::ResultCache;
+
+  const std::vector<int64_t> shape = {1, 4};
+  const std::vector<float> a = {1, 2, 3, 4}, b = {5, 6, 7, 8}, c = {9, 10, 11, 12};
+  const std::vector<float> result = {0.25f, 0.75f};
+  std::vector<float> output(2);
+  uint64_t epoch = 0;
+
+  // Room for two entries of 4 input and 2 output values
+  ResultCache cache(2 * 6 * sizeof(float));
+  EXPECT_FALSE(cache.find(a.data(), shape, output.data(), epoch));
+  cache.insert(a.data(), shape, result.data(), result.size(), epoch);
+  ASSERT_TRUE(cache.find(a.data(), shape, output.data(), epoch));
+  EXPECT_EQ(output, result);
+  // Same bytes in another shape are another input
+  EXPECT_FALSE(cache.find(a.data(), {1, 2, 2}, output.data(), epoch));
+
+  cache.insert(b.data(), shape, result.data(), result.size(), epoch);
+  ASSERT_TRUE(cache.find(a.data(), shape, output.data(), epoch));
+  cache.insert(c.data(), shape, result.data(), result.size(), epoch);
+  EXPECT_FALSE(cache.find(b.data(), shape, output.data(), epoch));
+  EXPECT_TRUE(cache.find(c.data(), shape, output.data(), epoch));
+
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.entries, 2u);
+  EXPECT_LE(stats.bytes, stats.max_bytes);
+
+  // A result computed before clear() belongs to the previous model
+  EXPECT_FALSE(cache.find(b.data(), shape, output.data(), epoch));
+  cache.clear();
+  cache.insert(b.data(), shape, result.data(), result.size(), epoch);
+  EXPECT_EQ(cache.getStats().entries, 0u);
+
+#ifdef USE_CUSTOM
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+  ASSERT_EQ(CochlApi_SetResultCache(api, 16 << 20), 1);
+
+  std::vector<float> input(CochlApi_GetInputSize(api), 0.5f);
+  std::vector<float> computed(CochlApi_GetOutputSize(api));
+  std::vector<float> cached(CochlApi_GetOutputSize(api));
+  const long long input_shape[] = {1, 3, 224, 224};
+  ASSERT_EQ(CochlApi_RunInference(api, input.data(), input_shape, 4, computed.data()), 1);
+  ASSERT_EQ(CochlApi_RunInference(api, input.data(), input_shape, 4, cached.data()), 1);
+  EXPECT_EQ(cached, computed);
+
+  unsigned long long hits = 0, misses = 0;
+  size_t bytes = 0;
+  ASSERT_EQ(CochlApi_GetResultCacheStats(api, &hits, &misses, &bytes), 1);
+  EXPECT_EQ(hits, 1u);
+  EXPECT_EQ(misses, 1u);
+  EXPECT_EQ(bytes, (input.size() + computed.size()) * sizeof(float));
+
+  ASSERT_EQ(CochlApi_SetResultCache(api, 0), 1);
+  ASSERT_EQ(CochlApi_GetResultCacheStats(api, &hits, &misses, &bytes), 1);
+  EXPECT_EQ(hits + misses, 0u);
+  CochlApi_Destroy(api);
+#endif
+}
+
+// Inputs and outputs are addressable by index and name; single-tensor models are one of each
+TEST_F(ApiTest, MultiTensorIo) {
+  using cochl_api::runtime::makePlanKey;
+
+  // Sets of input shapes never collide with each other or with a single shape
+  EXPECT_EQ(makePlanKey({{1, 3, 224, 224}}), (std::vector<int64_t>{1, 3, 224, 224}));
+  EXPECT_NE(makePlanKey({{1, 3}, {1, 224, 224}}), makePlanKey({{1, 3, 1}, {224, 224}}));
+
+#ifdef USE_CUSTOM
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+
+  ASSERT_EQ(CochlApi_GetNumInputs(api), 1u);
+  ASSERT_EQ(CochlApi_GetNumOutputs(api), 1u);
+  EXPECT_EQ(CochlApi_GetOutputIndex(api, "output_0"), 0);
+  EXPECT_EQ(CochlApi_GetOutputIndex(api, "embeddings"), -1);
+  EXPECT_EQ(CochlApi_GetOutputSizeAt(api, 0), CochlApi_GetOutputSize(api));
+  EXPECT_EQ(CochlApi_GetOutputSizeAt(api, 1), 0u);
+
+  char name[4];
+  EXPECT_EQ(CochlApi_GetInputName(api, 0, name, sizeof(name)), 7u);
+  EXPECT_STREQ(name, "inp");
+
+  long long shape[4] = {};
+  ASSERT_EQ(CochlApi_GetInputShapeAt(api, 0, shape, 4), 4u);
+  EXPECT_EQ(shape[0], 1);
+
+  std::vector<float> input(CochlApi_GetInputSize(api), 0.5f);
+  std::vector<float> output(CochlApi_GetOutputSize(api));
+  const float* inputs[] = {input.data()};
+  const long long* shapes[] = {shape};
+  const size_t shape_sizes[] = {4};
+  float* outputs[] = {output.data(), output.data()};
+  EXPECT_EQ(CochlApi_RunMulti(api, inputs, shapes, shape_sizes, 1, outputs, 1), 1);
+
+  // The model has one output
+  EXPECT_EQ(CochlApi_RunMulti(api, inputs, shapes, shape_sizes, 1, outputs, 2), 0);
+  CochlApi_Destroy(api);
+#endif
+}
+
+// Typed data is converted by value (quantized with the tensor's parameters) end to end
+TEST_F(ApiTest, TypedTensorIo) {
+  using namespace cochl_api::runtime;
+
+  for (float value : {0.0f, 1.0f, -2.5f, 0.333f, 65504.0f, 6.1e-5f, 3.0e-7f}) {
+    EXPECT_NEAR(halfToFloat(floatToHalf(value)), value, std::fabs(value) * 1e-3f + 1e-7f);
+  }
+  EXPECT_TRUE(std::isinf(halfToFloat(floatToHalf(1e6f))));
+
+  // uint8 with scale 0.5 / zero point 128: rounds to nearest and saturates
+  const float real[] = {-64.0f, 0.0f, 1.2f, 200.0f};
+  uint8_t quantized[4];
+  convertFromFloat(real, 4, DataType::UINT8, quantized, 0.5f, 128);
+  EXPECT_EQ(quantized[0], 0);
+  EXPECT_EQ(quantized[1], 128);
+  EXPECT_EQ(quantized[2], 130);
+  EXPECT_EQ(quantized[3], 255);
+  float dequantized[4];
+  convertToFloat(quantized, DataType::UINT8, 4, dequantized, 0.5f, 128);
+  EXPECT_FLOAT_EQ(dequantized[2], 1.0f);
+
+#ifdef USE_CUSTOM
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+  EXPECT_EQ(CochlApi_GetInputDataType(api, 0), COCHL_DTYPE_FLOAT32);
+  EXPECT_EQ(CochlApi_GetOutputDataType(api, 1), -1);
+
+  // uint8 pixels give the same result as the same values passed as float
+  const long long shape[] = {1, 3, 224, 224};
+  const size_t input_size = CochlApi_GetInputSize(api);
+  std::vector<uint8_t> pixels(input_size);
+  std::vector<float> pixels_float(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    pixels[i] = static_cast<uint8_t>(i % 251);
+    pixels_float[i] = pixels[i];
+  }
+  std::vector<float> expected(CochlApi_GetOutputSize(api));
+  std::vector<float> typed(expected.size());
+  ASSERT_EQ(CochlApi_RunInference(api, pixels_float.data(), shape, 4, expected.data()), 1);
+  ASSERT_EQ(CochlApi_RunInferenceTyped(api, pixels.data(), COCHL_DTYPE_UINT8, shape, 4,
+                                       typed.data(), COCHL_DTYPE_FLOAT32), 1);
+  EXPECT_EQ(typed, expected);
+
+  std::vector<uint16_t> half(expected.size());
+  ASSERT_EQ(CochlApi_RunInferenceTyped(api, pixels.data(), COCHL_DTYPE_UINT8, shape, 4,
+                                       half.data(), COCHL_DTYPE_FLOAT16), 1);
+  EXPECT_NEAR(halfToFloat(half[7]), expected[7], std::fabs(expected[7]) * 1e-3f);
+
+  EXPECT_EQ(CochlApi_RunInferenceTyped(api, pixels.data(), 42, shape, 4, typed.data(),
+                                       COCHL_DTYPE_FLOAT32), 0);
+  CochlApi_Destroy(api);
+#endif
+}
+
+TEST_F(ApiTest, LayoutNegotiation) {
+  using namespace cochl_api::runtime;
+
+  // {N, C, H, W} = {2, 3, 2, 4}: transposing there and back is the identity
+  const std::vector<int64_t> nchw_shape = {2, 3, 2, 4};
+  std::vector<float> nchw(48);
+  for (size_t i = 0; i < nchw.size(); ++i) nchw[i] = static_cast<float>(i);
+  std::vector<float> nhwc(nchw.size());
+  std::vector<float> back(nchw.size());
+  convertLayout(nchw.data(), nhwc.data(), sizeof(float), nchw_shape, TensorLayout::NCHW,
+                TensorLayout::NHWC);
+  std::vector<int64_t> nhwc_shape = convertShape(nchw_shape, TensorLayout::NCHW, TensorLayout::NHWC);
+  EXPECT_EQ(nhwc_shape, (std::vector<int64_t>{2, 2, 4, 3}));
+  EXPECT_EQ(nhwc[1], nchw[8]);  // (n0, h0, w0, c1) is (n0, c1, h0, w0)
+  convertLayout(nhwc.data(), back.data(), sizeof(float), nhwc_shape, TensorLayout::NHWC,
+                TensorLayout::NCHW);
+  EXPECT_EQ(back, nchw);
+
+#ifdef USE_CUSTOM
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+  EXPECT_EQ(CochlApi_GetPreferredLayout(api), COCHL_LAYOUT_NCHW);
+  EXPECT_EQ(CochlApi_SetInputLayout(api, 7), 0);
+
+  // The same image declared as NHWC gives the NCHW result
+  const size_t input_size = CochlApi_GetInputSize(api);
+  std::vector<float> image(input_size);
+  for (size_t i = 0; i < input_size; ++i) image[i] = static_cast<float>(i % 97) / 97.0f;
+  std::vector<float> image_nhwc(input_size);
+  convertLayout(image.data(), image_nhwc.data(), sizeof(float), {1, 3, 224, 224},
+                TensorLayout::NCHW, TensorLayout::NHWC);
+
+  const long long nchw_image[] = {1, 3, 224, 224};
+  const long long nhwc_image[] = {1, 224, 224, 3};
+  std::vector<float> expected(CochlApi_GetOutputSize(api));
+  std::vector<float> output(expected.size());
+  ASSERT_EQ(CochlApi_RunInference(api, image.data(), nchw_image, 4, expected.data()), 1);
+  ASSERT_EQ(CochlApi_SetInputLayout(api, COCHL_LAYOUT_NHWC), 1);
+  ASSERT_EQ(CochlApi_RunInference(api, image_nhwc.data(), nhwc_image, 4, output.data()), 1);
+  EXPECT_EQ(output, expected);
+
+  const std::string image_path = std::string(PROJECT_ROOT) + "/api/test/dog.png";
+  if (FileExists(image_path)) {
+    std::vector<float> loaded_nchw(input_size);
+    std::vector<float> loaded_nhwc(input_size);
+    ASSERT_EQ(CochlApi_LoadImage(image_path.c_str(), loaded_nchw.data(), input_size), 1);
+    ASSERT_EQ(CochlApi_LoadImageLayout(image_path.c_str(), COCHL_LAYOUT_NHWC, loaded_nhwc.data(),
+                                       input_size), 1);
+    convertLayout(loaded_nhwc.data(), image.data(), sizeof(float), {1, 224, 224, 3},
+                  TensorLayout::NHWC, TensorLayout::NCHW);
+    EXPECT_EQ(image, loaded_nchw);
+  }
+  CochlApi_Destroy(api);
+#endif
+}
+
+#ifdef USE_CUSTOM
+TEST_F(ApiTest, BoundBuffers) {
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+  EXPECT_EQ(CochlApi_RunBound(api), 0);
+
+  const size_t input_size = CochlApi_GetInputSize(api);
+  const size_t output_size = CochlApi_GetOutputSize(api);
+  std::vector<float> input(input_size, 0.5f);
+  std::vector<float> bound_output(output_size);
+  std::vector<float> expected(output_size);
+
+  const long long shape[] = {1, 3, 224, 224};
+  const void* inputs[] = {input.data()};
+  const long long* shapes[] = {shape};
+  const size_t shape_sizes[] = {4};
+  void* outputs[] = {bound_output.data()};
+  const int dtypes[] = {COCHL_DTYPE_FLOAT32};
+  ASSERT_EQ(CochlApi_BindBuffers(api, inputs, dtypes, shapes, shape_sizes, 1, outputs, dtypes, 1),
+            1);
+  // The mock backend has no in-place binding and runs through the copying fallback
+  EXPECT_EQ(CochlApi_IsZeroCopyBound(api), 0);
+
+  // Every run sees the current contents of the bound input
+  for (float value : {0.5f, -1.0f}) {
+    std::fill(input.begin(), input.end(), value);
+    ASSERT_EQ(CochlApi_RunBound(api), 1);
+    ASSERT_EQ(CochlApi_RunInference(api, input.data(), shape, 4, expected.data()), 1);
+    EXPECT_EQ(bound_output, expected);
+  }
+
+  // The binding moves to a swapped-in model instead of keeping the old one loaded
+  const std::string next_path = ::testing::TempDir() + "/cochl_bound_next.bin";
+  std::ofstream(next_path, std::ios::binary) << "next";
+  size_t models = cochl_api::runtime::ModelRegistry::instance().getNumModels();
+  ASSERT_EQ(CochlApi_SwapModel(api, next_path.c_str(), nullptr, 0), 1);
+  EXPECT_EQ(cochl_api::runtime::ModelRegistry::instance().getNumModels(), models);
+  std::fill(bound_output.begin(), bound_output.end(), 0.0f);
+  ASSERT_EQ(CochlApi_RunBound(api), 1);
+  EXPECT_EQ(bound_output, expected);
+
+  CochlApi_UnbindBuffers(api);
+  EXPECT_EQ(CochlApi_RunBound(api), 0);
+  CochlApi_Destroy(api);
+  std::remove(next_path.c_str());
+}
+#endif
+
+// Only the samples the first stage is unsure about reach the second one
+TEST_F(ApiTest, CascadeEscalates) {
+  using namespace cochl_api::runtime;
+
+  const float logits[] = {2.0f, 0.0f, 0.0f};
+  const float softmax = std::exp(2.0f) / (std::exp(2.0f) + 2.0f);
+  EXPECT_NEAR(topConfidence(logits, 3, ConfidenceMode::SOFTMAX), softmax, 1e-6f);
+  EXPECT_NEAR(topConfidence(logits, 3, ConfidenceMode::SIGMOID), 1.0f / (1.0f + std::exp(-2.0f)),
+              1e-6f);
+  EXPECT_FLOAT_EQ(topConfidence(logits, 3, ConfidenceMode::PROBABILITY), 2.0f);
+
+#ifdef USE_CUSTOM
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* single = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(single, nullptr);
+  const size_t input_size = CochlApi_GetInputSize(single);
+  const size_t output_size = CochlApi_GetOutputSize(single);
+
+  // A confident sample and an unsure one, with the threshold between their top scores
+  std::vector<float> batch(2 * input_size);
+  std::fill(batch.begin(), batch.begin() + input_size, 10.0f);
+  std::fill(batch.begin() + input_size, batch.end(), -10.0f);
+  const long long sample_shape[] = {1, 3, 224, 224};
+  std::vector<float> expected(2 * output_size);
+  for (size_t i = 0; i < 2; ++i) {
+    ASSERT_EQ(CochlApi_RunInference(single, batch.data() + i * input_size, sample_shape, 4,
+                                    expected.data() + i * output_size), 1);
+  }
+  CochlApi_Destroy(single);
+  const float high = topConfidence(expected.data(), output_size, ConfidenceMode::PROBABILITY);
+  const float low =
+      topConfidence(expected.data() + output_size, output_size, ConfidenceMode::PROBABILITY);
+  ASSERT_GT(high, low);
+
+  const char* paths[] = {model_path.c_str(), model_path.c_str()};
+  const float thresholds[] = {(high + low) / 2.0f, 0.0f};
+  void* api = CochlApi_CreateCascade(paths, thresholds, 2, COCHL_CONFIDENCE_PROBABILITY);
+  ASSERT_NE(api, nullptr);
+  EXPECT_EQ(CochlApi_GetNumStages(api), 2u);
+
+  const long long batch_shape[] = {2, 3, 224, 224};
+  std::vector<float> output(2 * output_size);
+  size_t stage = 0;
+  ASSERT_EQ(CochlApi_RunCascade(api, batch.data(), batch_shape, 4, output.data(), &stage), 1);
+  EXPECT_EQ(stage, 1u);
+  EXPECT_EQ(output, expected);
+
+  ASSERT_EQ(CochlApi_RunCascade(api, batch.data(), sample_shape, 4, output.data(), &stage), 1);
+  EXPECT_EQ(stage, 0u);
+
+  // A batch the first stage is confident about throughout answers every sample there
+  std::vector<float> confident(2 * input_size, 10.0f);
+  std::fill(output.begin(), output.end(), 0.0f);
+  ASSERT_EQ(CochlApi_RunCascade(api, confident.data(), batch_shape, 4, output.data(), &stage), 1);
+  EXPECT_EQ(stage, 0u);
+  EXPECT_TRUE(std::equal(output.begin(), output.begin() + output_size, expected.begin()));
+  EXPECT_TRUE(std::equal(output.begin() + output_size, output.end(), expected.begin()));
+
+  unsigned long long runs = 0, answered = 0;
+  double mean_ms = 0.0;
+  ASSERT_EQ(CochlApi_GetCascadeStats(api, 0, &runs, &answered, &mean_ms), 1);
+  EXPECT_EQ(runs, 5u);
+  EXPECT_EQ(answered, 4u);
+  ASSERT_EQ(CochlApi_GetCascadeStats(api, 1, &runs, &answered, &mean_ms), 1);
+  EXPECT_EQ(runs, 1u);
+  EXPECT_EQ(answered, 1u);
+  EXPECT_EQ(CochlApi_GetCascadeStats(api, 2, &runs, &answered, &mean_ms), 0);
+  CochlApi_Destroy(api);
+#endif
+}
+
+// A missing backend plugin is reported once and never half-loaded
+TEST_F(ApiTest, RuntimePluginMissing) {
+  using cochl_api::runtime::RuntimePlugin;
+
+  EXPECT_EQ(RuntimePlugin::createRuntime("does_not_exist"), nullptr);
+  EXPECT_FALSE(RuntimePlugin::isLoaded("does_not_exist"));
+  EXPECT_EQ(RuntimePlugin::createRuntime("does_not_exist"), nullptr);
+}
+
+TEST_F(ApiTest, CpuTopologyBigLittle) {
+  // Fake sysfs: cpu0-1 LITTLE (capacity 446), cpu2-3 big (capacity 1024)
+  const std::string root = MakeFakeSysfs("cochl_fake_cpu", {0, 1, 2, 3}, {446, 446, 1024, 1024});
+
+  using namespace cochl_api::runtime;
+  CpuTopology topology = CpuTopology::detect(root);
+  ASSERT_EQ(topology.cores().size(), 4u);
+  EXPECT_TRUE(topology.isHeterogeneous());
+  EXPECT_EQ(topology.performanceCpus(), (std::vector<int>{2, 3}));
+  EXPECT_EQ(topology.physicalCoreCpus().front(), 2);
+
+  ThreadAffinity explicit_affinity{AffinityPolicy::EXPLICIT, {1, 7}};
+  EXPECT_EQ(topology.resolve(explicit_affinity), (std::vector<int>{1}));
+  EXPECT_TRUE(topology.resolve({AffinityPolicy::EXPLICIT, {7, 9}}).empty());
+  EXPECT_TRUE(topology.resolve(ThreadAffinity()).empty());
+}
+
+// Models sharing a host get disjoint slices of whole cores and run confined to them
+TEST_F(ApiTest, CpuPartition) {
+  // Fake sysfs: 4 cores with 2 SMT siblings each (cpu 2k and 2k+1)
+  const std::string root = MakeFakeSysfs("cochl_fake_smt", {0, 0, 1, 1, 2, 2, 3, 3});
+
+  using namespace cochl_api::runtime;
+  CpuTopology topology = CpuTopology::detect(root);
+  EXPECT_EQ(topology.partition(0, 2), (std::vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(topology.partition(1, 2), (std::vector<int>{4, 5, 6, 7}));
+  EXPECT_EQ(topology.partition(1, 3), (std::vector<int>{2, 3}));
+  // More slices than cores splits siblings; more than cpus shares them
+  EXPECT_EQ(topology.partition(5, 8), (std::vector<int>{5}));
+  EXPECT_EQ(topology.partition(9, 10), (std::vector<int>{1}));
+  EXPECT_TRUE(topology.partition(2, 2).empty());
+
+#ifdef __linux__
+  cpu_set_t before;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+  const int first_cpu = CpuTopology::get().cores().front().cpu_id;
+  if (CPU_COUNT(&before) > 1) {
+    ScopedAffinity confine({first_cpu});
+    EXPECT_TRUE(confine.isApplied());
+    cpu_set_t inside;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(inside), &inside), 0);
+    EXPECT_EQ(CPU_COUNT(&inside), 1);
+  }
+  cpu_set_t after;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+#endif
+
+#ifdef USE_CUSTOM
+  const std::string model_path = std::string(PROJECT_ROOT) + "/models/model.bin";
+  void* api = CochlApi_Create(model_path.c_str());
+  ASSERT_NE(api, nullptr);
+  std::vector<float> input(CochlApi_GetInputSize(api), 0.25f);
+  std::vector<float> expected(CochlApi_GetOutputSize(api));
+  std::vector<float> confined(CochlApi_GetOutputSize(api));
+  const long long shape[] = {1, 3, 224, 224};
+  ASSERT_EQ(CochlApi_RunInference(api, input.data(), shape, 4, expected.data()), 1);
+
+  EXPECT_EQ(CochlApi_SetCpuShare(api, 1, 1), 0);
+  ASSERT_EQ(CochlApi_SetCpuPartition(api, COCHL_AFFINITY_EXPLICIT, &first_cpu, 1), 1);
+  int partition_cpu = -1;
+  EXPECT_EQ(CochlApi_GetCpuPartition(api, &partition_cpu, 1), 1u);
+  EXPECT_EQ(partition_cpu, first_cpu);
+  ASSERT_EQ(CochlApi_RunInference(api, input.data(), shape, 4, confined.data()), 1);
+  EXPECT_EQ(confined, expected);
+#ifdef __linux__
+  // The calling thread is confined only for the call
+  cpu_set_t between;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(between), &between), 0);
+  EXPECT_TRUE(CPU_EQUAL(&before, &between));
+#endif
+
+  ASSERT_EQ(CochlApi_SetCpuPartition(api, COCHL_AFFINITY_NONE, nullptr, 0), 1);
+  EXPECT_EQ(CochlApi_GetCpuPartition(api, nullptr, 0), 0u);
+  CochlApi_Destroy(api);
+#endif
+}
+
+#ifdef USE_CUSTOM
+// Above the memory budget the least recently used model is released and reloaded on its next call
+TEST_F(ApiTest, ResidencyEvictsLru) {
+  std::vector<std::string> paths;
+  for (char name : {'a', 'b', 'c'}) {
+    paths.push_back(::testing::TempDir() + "/cochl_resident_" + name + ".bin");
+    std::ofstream(paths.back(), std::ios::binary) << std::string(1000, name);
+  }
+
+  std::vector<void*> apis;
+  for (const auto& path : paths) {
+    apis.push_back(CochlApi_Create(path.c_str()));
+    ASSERT_NE(apis.back(), nullptr);
+  }
+
+  std::vector<float> input(CochlApi_GetInputSize(apis[0]), 0.5f);
+  std::vector<float> before(CochlApi_GetOutputSize(apis[0]));
+  std::vector<float> after(before.size());
+  const long long shape[] = {1, 3, 224, 224};
+  ASSERT_EQ(CochlApi_RunInference(apis[0], input.data(), shape, 4, before.data()), 1);
+  ASSERT_EQ(CochlApi_RunInference(apis[1], input.data(), shape, 4, after.data()), 1);
+  ASSERT_EQ(CochlApi_RunInference(apis[2], input.data(), shape, 4, after.data()), 1);
+
+  size_t resident_bytes = 0, resident_models = 0, evicted_models = 0;
+  unsigned long long evictions = 0, reloads = 0;
+  auto stats = [&]() {
+    return CochlApi_GetResidencyStats(&resident_bytes, &resident_models, &evicted_models,
+                                      &evictions, &reloads);
+  };
+  ASSERT_EQ(stats(), 1);
+  EXPECT_EQ(resident_bytes, 3000u);
+  unsigned long long evictions_before = evictions;
+
+  // Room for two: the first model was used least recently
+  CochlApi_SetMemoryBudget(2500);
+  ASSERT_EQ(stats(), 1);
+  EXPECT_EQ(resident_bytes, 2000u);
+  EXPECT_EQ(resident_models, 2u);
+  EXPECT_EQ(evicted_models, 1u);
+  EXPECT_EQ(evictions, evictions_before + 1);
+
+  // Calling it reloads it transparently and evicts the next least recently used one
+  ASSERT_EQ(CochlApi_RunInference(apis[0], input.data(), shape, 4, after.data()), 1);
+  EXPECT_EQ(after, before);
+  ASSERT_EQ(stats(), 1);
+  EXPECT_EQ(resident_bytes, 2000u);
+  EXPECT_EQ(evicted_models, 1u);
+  EXPECT_EQ(reloads, 1u);
+  EXPECT_EQ(cochl_api::runtime::ModelRegistry::instance().getNumModels(), 2u);
+
+  CochlApi_SetMemoryBudget(0);
+  for (void* api : apis) CochlApi_Destroy(api);
+  for (const auto& path : paths) std::remove(path.c_str());
+}
+#endif
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -21,11 +21,50 @@ class CochlApi {
 
   // Function pointers (public for direct access)
   void* (*create)(const char*);
+  void* (*createAutoTuned)(const char*);
+  void* (*createCascade)(const char* const*, const float*, size_t, int);
+  int (*runCascade)(void*, const float*, const long long*, size_t, float*, size_t*);
+  size_t (*getNumStages)(void*);
+  int (*getCascadeStats)(void*, size_t, unsigned long long*, unsigned long long*, double*);
   int (*runInference)(void*, const float*, const long long*, size_t, float*);
+  int (*runInferenceAsync)(void*, const float*, const long long*, size_t, float*,
+                           void (*)(int, void*), void*);
+  int (*runBatch)(void*, const float*, size_t, const long long*, size_t, float*);
+  int (*runInferenceTyped)(void*, const void*, int, const long long*, size_t, void*, int);
+  int (*getInputDataType)(void*, size_t);
+  int (*getPreferredLayout)(void*);
+  int (*bindBuffers)(void*, const void* const*, const int*, const long long* const*, const size_t*,
+                     size_t, void* const*, const int*, size_t);
+  int (*runBound)(void*);
+  void (*unbindBuffers)(void*);
+  int (*isZeroCopyBound)(void*);
+  int (*setInputLayout)(void*, int);
+  int (*runMulti)(void*, const float* const*, const long long* const*, const size_t*, size_t,
+                  float* const*, size_t);
+  size_t (*getNumInputs)(void*);
+  size_t (*getNumOutputs)(void*);
+  int (*getInputIndex)(void*, const char*);
+  int (*getOutputIndex)(void*, const char*);
+  size_t (*getOutputSizeAt)(void*, size_t);
+  int (*enableBatching)(void*, size_t, unsigned int);
+  int (*swapModel)(void*, const char*, const long long*, size_t);
+  int (*setMaxInstances)(void*, size_t);
+  int (*setCpuPartition)(void*, int, const int*, size_t);
+  int (*setCpuShare)(void*, size_t, size_t);
+  size_t (*getCpuPartition)(void*, int*, size_t);
+  int (*setThreadAffinity)(int, const int*, size_t);
+  void (*setWarmup)(size_t, unsigned int);
+  void (*setMemoryBudget)(size_t);
+  int (*getResidencyStats)(size_t*, size_t*, size_t*, unsigned long long*, unsigned long long*);
+  int (*getWarmupLatency)(void*, double*, double*);
+  int (*setResultCache)(void*, size_t);
+  int (*getResultCacheStats)(void*, unsigned long long*, unsigned long long*, size_t*);
+  size_t (*prepareShape)(void*, const long long*, size_t);
   size_t (*getInputSize)(void*);
   size_t (*getOutputSize)(void*);
   void (*destroy)(void*);
   int (*loadImage)(const char*, float*, size_t);
+  int (*loadImageLayout)(const char*, int, float*, size_t);
   void* (*loadClassNames)(const char*);
   const char* (*getClassName)(void*, int);
   void (*destroyClassMap)(void*);
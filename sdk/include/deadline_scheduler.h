@@ -0,0 +1,114 @@
+// Earliest-deadline-first scheduling of inference requests.
+// Requests that cannot finish in time are rejected when submitted, or dropped
+// before they start, instead of occupying the model and making the requests
+// behind them late as well.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cochl {
+
+// Outcome of a request with a deadline
+enum class DeadlineStatus {
+  ON_TIME = 0,  // output written before the deadline
+  LATE = 1,     // output written, but after the deadline
+  SHED = 2,     // not run: it could not have finished in time (output untouched)
+  FAILED = 3    // inference failed
+};
+
+// Counters of a DeadlineScheduler since it was created
+struct DeadlineStats {
+  uint64_t submitted = 0;
+  uint64_t on_time = 0;
+  uint64_t late = 0;       // completed after their deadline
+  uint64_t shed = 0;       // rejected on submission or dropped before running
+  uint64_t failed = 0;
+  size_t queued = 0;       // waiting now
+  double predicted_ms = 0.0;  // service time admission currently assumes per request
+};
+
+class DeadlineScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Runs one request; called concurrently from up to max_concurrent worker threads
+  using RunFunction =
+      std::function<bool(const float* input, const std::vector<int64_t>& input_shape, float* output)>;
+
+  // run: inference on the model
+  // max_concurrent: requests running at the same time (the model's concurrent instances)
+  // initial_ms: service time assumed until requests have been measured (e.g. warm latency)
+  DeadlineScheduler(RunFunction run, size_t max_concurrent, double initial_ms);
+
+  // Sheds the requests still queued and waits for the running ones
+  ~DeadlineScheduler();
+
+  // Queue a request to run before deadline, earliest deadline first
+  // input: copied before returning; output: must stay valid until the future is ready
+  // Returns SHED immediately if the queue ahead of it plus its own service time already
+  // passes the deadline
+  std::future<DeadlineStatus> submit(const float* input, const std::vector<int64_t>& input_shape,
+                                     float* output, Clock::time_point deadline);
+
+  DeadlineStats getStats() const;
+
+  DeadlineScheduler(const DeadlineScheduler&) = delete;
+  DeadlineScheduler& operator=(const DeadlineScheduler&) = delete;
+
+ private:
+  // Service times kept for the prediction
+  static constexpr size_t kLatencyWindow = 64;
+
+  struct Request {
+    std::vector<float> input;
+    std::vector<int64_t> input_shape;
+    float* output;
+    Clock::time_point deadline;
+    uint64_t sequence;  // keeps equal deadlines in submission order
+    std::shared_ptr<std::promise<DeadlineStatus>> done;
+  };
+
+  struct LaterDeadline {
+    bool operator()(const Request& a, const Request& b) const {
+      return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+    }
+  };
+
+  void workerLoop();
+
+  // 90th percentile of the recent service times; requires mutex_
+  double predictedMs() const;
+
+  // Wait before a request due at deadline could start, given the queued requests due
+  // no later and the running ones; requires mutex_
+  double waitMs(Clock::time_point deadline, double predicted_ms) const;
+
+  void recordLatency(double ms);
+
+  RunFunction run_;
+  size_t max_concurrent_;
+  double initial_ms_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Request> queue_;  // heap on LaterDeadline: the front is due first
+  size_t running_;
+  bool stopping_;
+  uint64_t sequence_;
+  std::vector<double> latencies_;  // ring of the last kLatencyWindow service times
+  size_t latency_next_;
+  DeadlineStats stats_;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace cochl
@@ -3,15 +3,84 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "api/cochl_api.h"
+#include "deadline_scheduler.h"
+#include "stream_session.h"
 
 namespace cochl {
 
+// Tensor element types (values match CochlDataType of the API)
+enum class DataType {
+  FLOAT32 = 0,
+  FLOAT16 = 1,  // IEEE 754 half, passed as uint16_t bits
+  INT8 = 2,
+  UINT8 = 3,
+  INT16 = 4
+};
+
+// Memory order of image tensors (values match CochlTensorLayout of the API)
+enum class TensorLayout {
+  NCHW = 0,  // {1, 3, 224, 224}
+  NHWC = 1   // {1, 224, 224, 3}
+};
+
+// Placement of worker threads (values match CochlAffinityPolicy of the API)
+enum class AffinityPolicy {
+  NONE = 0,               // leave placement to the OS scheduler
+  PERFORMANCE_CORES = 1,  // highest-capacity (big) cores only
+  PHYSICAL_CORES = 2,     // one thread per physical core
+  EXPLICIT = 3            // cpus given by the caller
+};
+
+// How a cascade stage reads its top-1 confidence (values match CochlConfidenceMode of the API)
+enum class ConfidenceMode {
+  SOFTMAX = 0,     // logits of exclusive classes
+  SIGMOID = 1,     // logits of independent labels
+  PROBABILITY = 2  // outputs already are probabilities
+};
+
+// One model of a cascade: its answer is final once its top-1 confidence reaches threshold
+struct CascadeStage {
+  std::string model_path;
+  float threshold = 0.5f;  // ignored for the last stage, which answers everything left
+};
+
+// Counters of one cascade stage
+struct CascadeStageStats {
+  uint64_t runs = 0;      // samples that reached the stage
+  uint64_t answered = 0;  // samples it answered without escalating
+  double mean_ms = 0.0;   // mean time per sample spent in it
+
+  double hitRate() const { return runs ? static_cast<double>(answered) / runs : 0.0; }
+};
+
+// Counters of the result cache
+struct ResultCacheStats {
+  uint64_t hits = 0;    // inputs answered from the cache
+  uint64_t misses = 0;  // inputs the model ran on
+  size_t bytes = 0;     // memory held now
+
+  double hitRate() const {
+    return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0;
+  }
+};
+
+// Memory accounting of the models loaded in the process
+struct ResidencyStats {
+  size_t resident_bytes = 0;  // models loaded now, at their file size
+  size_t resident_models = 0;
+  size_t evicted_models = 0;  // released by the budget, reloaded on their next call
+  uint64_t evictions = 0;
+  uint64_t reloads = 0;
+};
+
 class InferenceEngine {
  public:
   InferenceEngine();
@@ -24,21 +93,217 @@ class InferenceEngine {
   // Model format is auto-detected: .tflite -> TFLite, .pt/.pth -> LibTorch
   bool create(const std::string& model_path);
 
+  // Create API instance on the fastest backend and thread count for this host
+  // Exports of the same model for other backends next to it (model.tflite / model.pt / model.so)
+  // are benchmarked too; the decision is cached, so only the first run on a host is slow
+  bool createAutoTuned(const std::string& model_path);
+
+  // Create API instance on a cascade of models, cheapest first
+  // Each sample escalates to the next model only while the current one is less confident than
+  // its threshold, so easy inputs cost a small model and hard ones get the large one.
+  // All models must share input and output sizes. runInference() then runs the cascade;
+  // everything else addresses the first model
+  bool createCascade(const std::vector<CascadeStage>& stages,
+                     ConfidenceMode mode = ConfidenceMode::SOFTMAX);
+
+  // Run the cascade; stage receives the deepest stage that ran (0: the first answered all)
+  // Returns true on success, false on error or if the engine is not a cascade
+  bool runCascade(const float* input, const std::vector<int64_t>& input_shape, float* output,
+                  size_t* stage = nullptr);
+
+  // Number of cascade stages (1 for a single model)
+  size_t getNumStages() const;
+
+  // Samples seen, samples answered (hit rate) and time of one cascade stage
+  // Returns false if the engine is not a cascade or stage is out of range
+  bool getCascadeStats(size_t stage, CascadeStageStats& stats) const;
+
   // Run inference
-  // input: float array of input data (must be in NCHW format)
-  // input_shape: shape of input tensor in NCHW format (e.g., {1, 3, 224, 224})
+  // input: float array of input data (NCHW unless usePreferredLayout() was called)
+  // input_shape: shape of input tensor in that layout (e.g., {1, 3, 224, 224} for NCHW)
   // output: float array to store output (must be pre-allocated with getOutputSize())
   // Returns true on success, false on error
   bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                     float* output);
 
+  // Run inference on typed data, e.g. uint8 camera pixels or int16 PCM samples
+  // Data of the model's own type (getInputDataType()) goes in as-is, so quantized models skip
+  // the fp32 round trip; other types are converted by value
+  // output: getOutputSize() elements of output_type per sample
+  // Returns true on success, false on error
+  bool runInferenceTyped(const void* input, DataType input_type,
+                         const std::vector<int64_t>& input_shape, void* output,
+                         DataType output_type);
+
+  // Element type the model's first input computes with
+  DataType getInputDataType() const;
+
+  // Alignment in bytes of buffers bound with bindBuffers() (COCHL_TENSOR_ALIGNMENT of the API)
+  static constexpr size_t kTensorAlignment = 64;
+
+  // Bind caller-owned buffers once as the model's input and output storage
+  // runBound() then reads the current input contents and writes the output, with no copies
+  // at the API boundary if the buffers have the model's types, images are in
+  // getInputLayout() == the preferred layout, and both are aligned to kTensorAlignment bytes
+  // Buffers must stay valid until unbindBuffers() or the engine is destroyed
+  // Returns true on success, false on error
+  bool bindBuffers(const void* input, DataType input_type, const std::vector<int64_t>& input_shape,
+                   void* output, DataType output_type);
+  bool runBound();
+  void unbindBuffers();
+
+  // Whether the backend uses the bound buffers in place (false: copies on each run)
+  bool isZeroCopyBound() const;
+
+  // Run inference on the API executor without blocking the caller
+  // input: copied before returning, so the buffer can be reused for the next frame
+  // output: must stay valid until the future is ready
+  // Returns a future holding true on success, false on error
+  std::future<bool> runInferenceAsync(const float* input, const std::vector<int64_t>& input_shape,
+                                      float* output);
+
+  // Schedule runWithDeadline() requests earliest deadline first
+  // max_concurrent: requests run at the same time; match setMaxInstances() to use them all
+  // Requests are admitted against the 90th percentile of recent latencies (the warmup latency
+  // until there are some), so under overload the ones that cannot make it are shed up front
+  // instead of making every request late
+  // Returns true on success, false on error
+  bool enableDeadlineScheduling(size_t max_concurrent = 1);
+
+  // Run inference that is only useful before deadline (requires enableDeadlineScheduling())
+  // input: copied before returning; output: must stay valid until the future is ready
+  // Returns a future holding ON_TIME or LATE once the output is written, SHED if the request
+  // was not run because it could not finish in time, FAILED on error
+  std::future<DeadlineStatus> runWithDeadline(const float* input,
+                                              const std::vector<int64_t>& input_shape,
+                                              float* output,
+                                              std::chrono::steady_clock::time_point deadline);
+
+  // Submitted, on-time, late, shed and failed counts of runWithDeadline() requests
+  DeadlineStats getDeadlineStats() const;
+
+  // Start a delta-gated stream (one per camera or microphone): frames that barely differ from
+  // the last one the model ran on get its result again instead of another inference
+  // The session runs on this engine and must not outlive it
+  // Returns nullptr if no model is loaded
+  std::unique_ptr<StreamSession> createStreamSession(const StreamOptions& options = StreamOptions());
+
+  // Run inference on a batch of samples in one backend call
+  // inputs: batch_size samples stored back to back (each in NCHW format)
+  // sample_shape: shape of one sample with a leading batch dimension of 1 (e.g., {1, 3, 224, 224})
+  // outputs: float array to store outputs (must be pre-allocated with batch_size * getOutputSize())
+  // Returns true on success, false on error
+  bool runBatch(const float* inputs, size_t batch_size, const std::vector<int64_t>& sample_shape,
+                float* outputs);
+
+  // Run a model with several inputs and/or outputs (e.g. event logits plus embeddings) in one pass
+  // inputs/input_shapes: one entry per model input, in model order, sharing the batch dimension N
+  // outputs: one buffer per model output, in model order; output i holds N * getOutputSize(i) values
+  // Returns true on success, false on error
+  bool runMulti(const std::vector<const float*>& inputs,
+                const std::vector<std::vector<int64_t>>& input_shapes,
+                const std::vector<float*>& outputs);
+
+  // Coalesce concurrent runInference calls from several threads into batched backend calls
+  // max_batch_size: largest batch, 0 or 1 turns batching off
+  // max_delay: longest time a request waits for others to join its batch, from 0 to
+  //            UINT_MAX microseconds (about 71 minutes)
+  // Returns true on success, false on error
+  bool enableBatching(size_t max_batch_size, std::chrono::microseconds max_delay);
+
+  // Replace the loaded model without interrupting inference on other threads
+  // model_path: new model file; input and output sizes must match the current model
+  // warmup_shape: input shape for one warmup inference before the swap, empty to skip
+  // Returns true if the new model is being served, false if the current one was kept
+  bool swapModel(const std::string& model_path, const std::vector<int64_t>& warmup_shape = {});
+
+  // Limit the runtime instances that serve concurrent runInference calls
+  // max_instances: instance limit, 0 follows the process-wide thread budget
+  // Returns true on success, false on error
+  bool setMaxInstances(size_t max_instances);
+
+  // Confine this model to some cpus, so that hosting several models in one process does not
+  // let a burst on one raise the latency of the others
+  // cpus: logical cpu ids, empty to run on every cpu again
+  // Calling threads and the custom/TFLite workers stay on the cpus; LibTorch intra-op and TVM
+  // workers are process-wide and are not confined
+  // Returns true on success, false on error
+  bool setCpuPartition(const std::vector<int>& cpus);
+
+  // Confine this model to slice index of count disjoint slices of the cpus
+  // (e.g. 0, 1 and 2 of 3 for three models); whole cores and clusters stay in one slice
+  // Returns true on success, false on error
+  bool setCpuShare(size_t index, size_t count);
+
+  // cpus this model is confined to, empty if it runs on every cpu
+  std::vector<int> getCpuPartition() const;
+
+  // Place the worker threads of every engine in the process on some cpus (applies to thread
+  // pools created afterwards) and size the shared compute budget to them
+  // cpus: logical cpu ids, used with AffinityPolicy::EXPLICIT only
+  // Returns true on success, false on error
+  bool setThreadAffinity(AffinityPolicy policy, const std::vector<int>& cpus = {});
+
+  // Configure the warmup run when models are loaded (applies to create() calls made afterwards)
+  // max_runs: upper bound on warmup inferences, 0 turns warmup off
+  // budget: longest time spent warming one model
+  // Returns true on success, false on error
+  bool setWarmup(size_t max_runs, std::chrono::milliseconds budget);
+
+  // Bound the memory of all models loaded in the process (every engine, not just this one)
+  // max_bytes: budget at model file size, 0 for unlimited (the default)
+  // Above it the least recently used models are released; their next call reloads them from
+  // the model file (paying for the load again), so model files must stay in place
+  // Returns true on success, false on error
+  bool setMemoryBudget(size_t max_bytes);
+
+  // Models loaded and released under the memory budget, process-wide
+  bool getResidencyStats(ResidencyStats& stats) const;
+
+  // Latency of the first inference and of steady-state inference, measured by the warmup
+  // Returns false if the model was loaded with warmup off
+  bool getWarmupLatency(double& cold_ms, double& warm_ms) const;
+
+  // Return the stored output when runInference sees the same input again (same shape,
+  // byte-identical data), e.g. a fixed camera or silent audio; for deterministic models only
+  // max_bytes: memory for the cached inputs and outputs, 0 turns the cache off
+  // Returns true on success, false on error
+  bool setResultCache(size_t max_bytes);
+
+  // Hits, misses and memory of the result cache
+  bool getResultCacheStats(ResultCacheStats& stats) const;
+
+  // Prepare an input shape other than the model's default (e.g. a clip of another length)
+  // Returns the number of output values runInference writes for it, 0 if unsupported
+  size_t prepareShape(const std::vector<int64_t>& input_shape);
+
   // Get input tensor size
   size_t getInputSize() const;
 
   // Get output tensor size
   size_t getOutputSize() const;
 
-  // Load and preprocess image (returns preprocessed data in NCHW format)
+  // Number of model inputs and outputs (1 and 1 for single-tensor models)
+  size_t getNumInputs() const;
+  size_t getNumOutputs() const;
+
+  // Index of a named model input or output, -1 if there is none by that name
+  int getInputIndex(const std::string& name) const;
+  int getOutputIndex(const std::string& name) const;
+
+  // Per-sample size of output index, 0 if out of range
+  size_t getOutputSize(size_t index) const;
+
+  // Take images in the layout the backend computes in (NHWC for TFLite, NCHW for LibTorch)
+  // loadImage() then writes that layout and image inputs reach the backend without a transpose;
+  // input shapes passed to the run functions must follow it
+  // Returns the layout now in use
+  TensorLayout usePreferredLayout();
+
+  // Layout of image inputs and of loadImage() output (NCHW by default)
+  TensorLayout getInputLayout() const { return input_layout_; }
+
+  // Load and preprocess image (returns preprocessed data in getInputLayout())
   bool loadImage(const std::string& image_path, float* output_data, size_t output_size);
 
   // Load ImageNet class names
@@ -51,6 +316,13 @@ class InferenceEngine {
   api::CochlApi api_loader_;  // Dynamic library loader
   void* api_instance_;        // CochlApi instance
   void* class_map_;           // ImageNet class map
+  TensorLayout input_layout_;  // layout of image inputs
+
+  // Runs runWithDeadline() requests; destroyed before the API instance
+  std::unique_ptr<DeadlineScheduler> deadline_scheduler_;
+
+  // Shared path of create/createAutoTuned
+  bool createWith(void* (*factory)(const char*), const std::string& model_path);
 };
 
 }  // namespace cochl
@@ -0,0 +1,74 @@
+// Delta-gated inference over a stream of frames.
+// Consecutive camera frames or audio windows of a quiet scene barely differ;
+// a frame close enough to the last one the model ran on gets that result
+// again instead of another inference.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace cochl {
+
+// When a frame reuses the previous result
+struct StreamOptions {
+  // Largest mean absolute difference per input value, against the last frame the model ran on,
+  // at which the frame is skipped (0 skips exact repeats only)
+  float threshold = 0.01f;
+  // Run the model at least once every refresh_interval frames, 0 to rely on the threshold only
+  size_t refresh_interval = 30;
+};
+
+// Counters of a StreamSession since it was created
+struct StreamStats {
+  uint64_t frames = 0;     // frames passed to process()
+  uint64_t processed = 0;  // frames the model ran on
+  uint64_t skipped = 0;    // frames answered with the previous result
+  uint64_t forced = 0;     // processed only because refresh_interval was reached
+
+  double skipRate() const { return frames ? static_cast<double>(skipped) / frames : 0.0; }
+};
+
+class StreamSession {
+ public:
+  // Runs the model on one frame
+  using RunFunction =
+      std::function<bool(const float* input, const std::vector<int64_t>& input_shape, float* output)>;
+  // Number of output values for a frame shape, 0 if the model cannot take it
+  using OutputSizeFunction = std::function<size_t(const std::vector<int64_t>& input_shape)>;
+
+  StreamSession(RunFunction run, OutputSizeFunction output_size, const StreamOptions& options);
+
+  // Write the result for the next frame of the stream to output
+  // skipped: set to true if the previous result was reused, may be nullptr
+  // Returns true on success, false on error
+  // Not synchronized: one session per stream, fed from one thread at a time
+  bool process(const float* input, const std::vector<int64_t>& input_shape, float* output,
+               bool* skipped = nullptr);
+
+  // Run the model on the next frame whatever it looks like (e.g. after a scene cut)
+  void reset();
+
+  const StreamStats& getStats() const { return stats_; }
+  const StreamOptions& getOptions() const { return options_; }
+
+ private:
+  // Whether the mean absolute difference of a and b is at most threshold; stops reading as
+  // soon as the sum of the differences exceeds threshold * size
+  static bool withinThreshold(const float* a, const float* b, size_t size, float threshold);
+
+  RunFunction run_;
+  OutputSizeFunction output_size_;
+  StreamOptions options_;
+
+  // Last frame the model ran on and its result; empty until the first frame
+  std::vector<int64_t> reference_shape_;
+  std::vector<float> reference_;
+  std::vector<float> result_;
+  size_t since_refresh_;  // frames since the model last ran
+  StreamStats stats_;
+};
+
+}  // namespace cochl
@@ -10,11 +10,47 @@ namespace api {
 CochlApi::CochlApi()
     : lib_handle_(nullptr),
       create(nullptr),
+      createAutoTuned(nullptr),
+      createCascade(nullptr),
+      runCascade(nullptr),
+      getNumStages(nullptr),
+      getCascadeStats(nullptr),
       runInference(nullptr),
+      runInferenceAsync(nullptr),
+      runBatch(nullptr),
+      runInferenceTyped(nullptr),
+      getInputDataType(nullptr),
+      getPreferredLayout(nullptr),
+      bindBuffers(nullptr),
+      runBound(nullptr),
+      unbindBuffers(nullptr),
+      isZeroCopyBound(nullptr),
+      setInputLayout(nullptr),
+      runMulti(nullptr),
+      getNumInputs(nullptr),
+      getNumOutputs(nullptr),
+      getInputIndex(nullptr),
+      getOutputIndex(nullptr),
+      getOutputSizeAt(nullptr),
+      enableBatching(nullptr),
+      swapModel(nullptr),
+      setMaxInstances(nullptr),
+      setCpuPartition(nullptr),
+      setCpuShare(nullptr),
+      getCpuPartition(nullptr),
+      setThreadAffinity(nullptr),
+      setWarmup(nullptr),
+      setMemoryBudget(nullptr),
+      getResidencyStats(nullptr),
+      getWarmupLatency(nullptr),
+      setResultCache(nullptr),
+      getResultCacheStats(nullptr),
+      prepareShape(nullptr),
       getInputSize(nullptr),
       getOutputSize(nullptr),
       destroy(nullptr),
       loadImage(nullptr),
+      loadImageLayout(nullptr),
       loadClassNames(nullptr),
       getClassName(nullptr),
       destroyClassMap(nullptr) {}
@@ -56,11 +92,47 @@ bool CochlApi::load(const std::string& library_path) {
   // Load all function symbols
   bool success = true;
   success &= loadSymbol(create, "CochlApi_Create");
+  success &= loadSymbol(createAutoTuned, "CochlApi_CreateAutoTuned");
+  success &= loadSymbol(createCascade, "CochlApi_CreateCascade");
+  success &= loadSymbol(runCascade, "CochlApi_RunCascade");
+  success &= loadSymbol(getNumStages, "CochlApi_GetNumStages");
+  success &= loadSymbol(getCascadeStats, "CochlApi_GetCascadeStats");
   success &= loadSymbol(runInference, "CochlApi_RunInference");
+  success &= loadSymbol(runInferenceAsync, "CochlApi_RunInferenceAsync");
+  success &= loadSymbol(runBatch, "CochlApi_RunBatch");
+  success &= loadSymbol(runInferenceTyped, "CochlApi_RunInferenceTyped");
+  success &= loadSymbol(getInputDataType, "CochlApi_GetInputDataType");
+  success &= loadSymbol(getPreferredLayout, "CochlApi_GetPreferredLayout");
+  success &= loadSymbol(bindBuffers, "CochlApi_BindBuffers");
+  success &= loadSymbol(runBound, "CochlApi_RunBound");
+  success &= loadSymbol(unbindBuffers, "CochlApi_UnbindBuffers");
+  success &= loadSymbol(isZeroCopyBound, "CochlApi_IsZeroCopyBound");
+  success &= loadSymbol(setInputLayout, "CochlApi_SetInputLayout");
+  success &= loadSymbol(runMulti, "CochlApi_RunMulti");
+  success &= loadSymbol(getNumInputs, "CochlApi_GetNumInputs");
+  success &= loadSymbol(getNumOutputs, "CochlApi_GetNumOutputs");
+  success &= loadSymbol(getInputIndex, "CochlApi_GetInputIndex");
+  success &= loadSymbol(getOutputIndex, "CochlApi_GetOutputIndex");
+  success &= loadSymbol(getOutputSizeAt, "CochlApi_GetOutputSizeAt");
+  success &= loadSymbol(enableBatching, "CochlApi_EnableBatching");
+  success &= loadSymbol(swapModel, "CochlApi_SwapModel");
+  success &= loadSymbol(setMaxInstances, "CochlApi_SetMaxInstances");
+  success &= loadSymbol(setCpuPartition, "CochlApi_SetCpuPartition");
+  success &= loadSymbol(setCpuShare, "CochlApi_SetCpuShare");
+  success &= loadSymbol(getCpuPartition, "CochlApi_GetCpuPartition");
+  success &= loadSymbol(setThreadAffinity, "CochlApi_SetThreadAffinity");
+  success &= loadSymbol(setWarmup, "CochlApi_SetWarmup");
+  success &= loadSymbol(setMemoryBudget, "CochlApi_SetMemoryBudget");
+  success &= loadSymbol(getResidencyStats, "CochlApi_GetResidencyStats");
+  success &= loadSymbol(getWarmupLatency, "CochlApi_GetWarmupLatency");
+  success &= loadSymbol(setResultCache, "CochlApi_SetResultCache");
+  success &= loadSymbol(getResultCacheStats, "CochlApi_GetResultCacheStats");
+  success &= loadSymbol(prepareShape, "CochlApi_PrepareShape");
   success &= loadSymbol(getInputSize, "CochlApi_GetInputSize");
   success &= loadSymbol(getOutputSize, "CochlApi_GetOutputSize");
   success &= loadSymbol(destroy, "CochlApi_Destroy");
   success &= loadSymbol(loadImage, "CochlApi_LoadImage");
+  success &= loadSymbol(loadImageLayout, "CochlApi_LoadImageLayout");
   success &= loadSymbol(loadClassNames, "CochlApi_LoadClassNames");
   success &= loadSymbol(getClassName, "CochlApi_GetClassName");
   success &= loadSymbol(destroyClassMap, "CochlApi_DestroyClassMap");
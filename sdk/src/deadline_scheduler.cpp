@@ -0,0 +1,182 @@
+#include "deadline_scheduler.h"
+
+#include <algorithm>
+
+namespace cochl {
+
+namespace {
+
+std::future<DeadlineStatus> readyStatus(DeadlineStatus status) {
+  std::promise<DeadlineStatus> promise;
+  promise.set_value(status);
+  return promise.get_future();
+}
+
+}  // namespace
+
+DeadlineScheduler::DeadlineScheduler(RunFunction run, size_t max_concurrent, double initial_ms)
+    : run_(std::move(run)),
+      max_concurrent_(std::max<size_t>(1, max_concurrent)),
+      initial_ms_(std::max(0.0, initial_ms)),
+      running_(0),
+      stopping_(false),
+      sequence_(0),
+      latency_next_(0) {
+  latencies_.reserve(kLatencyWindow);
+  for (size_t i = 0; i < max_concurrent_; ++i) {
+    workers_.emplace_back(&DeadlineScheduler::workerLoop, this);
+  }
+}
+
+DeadlineScheduler::~DeadlineScheduler() {
+  std::vector<Request> abandoned;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    abandoned.swap(queue_);
+    stats_.shed += abandoned.size();
+  }
+  cv_.notify_all();
+
+  for (auto& request : abandoned) {
+    request.done->set_value(DeadlineStatus::SHED);
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::future<DeadlineStatus> DeadlineScheduler::submit(const float* input,
+                                                      const std::vector<int64_t>& input_shape,
+                                                      float* output, Clock::time_point deadline) {
+  size_t input_size = input_shape.empty() ? 0 : 1;
+  for (auto dim : input_shape) {
+    input_size *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ++stats_.submitted;
+
+  // Admission: reject now what would miss its deadline anyway, before it delays others
+  double predicted_ms = predictedMs();
+  auto finish = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                   std::chrono::duration<double, std::milli>(
+                                       waitMs(deadline, predicted_ms) + predicted_ms));
+  if (stopping_ || finish > deadline) {
+    ++stats_.shed;
+    return readyStatus(DeadlineStatus::SHED);
+  }
+
+  Request request;
+  request.input.assign(input, input + input_size);
+  request.input_shape = input_shape;
+  request.output = output;
+  request.deadline = deadline;
+  request.sequence = sequence_++;
+  request.done = std::make_shared<std::promise<DeadlineStatus>>();
+  std::future<DeadlineStatus> result = request.done->get_future();
+
+  queue_.push_back(std::move(request));
+  std::push_heap(queue_.begin(), queue_.end(), LaterDeadline());
+  lock.unlock();
+  cv_.notify_one();
+  return result;
+}
+
+DeadlineStats DeadlineScheduler::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DeadlineStats stats = stats_;
+  stats.queued = queue_.size();
+  stats.predicted_ms = predictedMs();
+  return stats;
+}
+
+void DeadlineScheduler::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+    if (stopping_) {
+      return;
+    }
+
+    std::pop_heap(queue_.begin(), queue_.end(), LaterDeadline());
+    Request request = std::move(queue_.back());
+    queue_.pop_back();
+
+    // Requests admitted earlier may have been pushed back by more urgent ones since
+    auto start = Clock::now();
+    auto finish = start + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double, std::milli>(predictedMs()));
+    if (finish > request.deadline) {
+      ++stats_.shed;
+      lock.unlock();
+      request.done->set_value(DeadlineStatus::SHED);
+      lock.lock();
+      continue;
+    }
+
+    ++running_;
+    lock.unlock();
+    bool success = run_(request.input.data(), request.input_shape, request.output);
+    auto end = Clock::now();
+    lock.lock();
+    --running_;
+
+    DeadlineStatus status;
+    if (!success) {
+      ++stats_.failed;
+      status = DeadlineStatus::FAILED;
+    } else {
+      recordLatency(std::chrono::duration<double, std::milli>(end - start).count());
+      if (end > request.deadline) {
+        ++stats_.late;
+        status = DeadlineStatus::LATE;
+      } else {
+        ++stats_.on_time;
+        status = DeadlineStatus::ON_TIME;
+      }
+    }
+
+    lock.unlock();
+    request.done->set_value(status);
+    lock.lock();
+  }
+}
+
+double DeadlineScheduler::predictedMs() const {
+  if (latencies_.empty()) {
+    return initial_ms_;
+  }
+
+  // A high percentile rather than the mean: admitting on the mean makes half the requests late
+  std::vector<double> sorted = latencies_;
+  size_t index = (sorted.size() * 9) / 10;
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  return sorted[index];
+}
+
+double DeadlineScheduler::waitMs(Clock::time_point deadline, double predicted_ms) const {
+  // Under EDF only the requests due no later than this one run before it
+  size_t ahead = running_;
+  for (const auto& queued : queue_) {
+    if (queued.deadline <= deadline) {
+      ++ahead;
+    }
+  }
+  if (ahead < max_concurrent_) {
+    return 0.0;
+  }
+  return static_cast<double>(ahead + 1 - max_concurrent_) * predicted_ms /
+         static_cast<double>(max_concurrent_);
+}
+
+void DeadlineScheduler::recordLatency(double ms) {
+  if (latencies_.size() < kLatencyWindow) {
+    latencies_.push_back(ms);
+  } else {
+    latencies_[latency_next_] = ms;
+  }
+  latency_next_ = (latency_next_ + 1) % kLatencyWindow;
+}
+
+}  // namespace cochl
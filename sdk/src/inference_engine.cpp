@@ -1,15 +1,40 @@
 #include "inference_engine.h"
 #include "error/sdk_error.h"
 
+#include <limits>
+
 #include <glog/logging.h>
 
 namespace cochl {
 
+namespace {
+
+// Completion of CochlApi_RunInferenceAsync; user_data owns the promise
+void onInferenceDone(int status, void* user_data) {
+  std::unique_ptr<std::promise<bool>> promise(static_cast<std::promise<bool>*>(user_data));
+  if (status == 0) {
+    error::printError(error::SdkError::INFERENCE_FAILED, "Async inference failed");
+  }
+  promise->set_value(status != 0);
+}
+
+std::future<bool> readyFuture(bool value) {
+  std::promise<bool> promise;
+  promise.set_value(value);
+  return promise.get_future();
+}
+
+}  // namespace
+
 InferenceEngine::InferenceEngine()
     : api_instance_(nullptr),
-      class_map_(nullptr) {}
+      class_map_(nullptr),
+      input_layout_(TensorLayout::NCHW) {}
 
 InferenceEngine::~InferenceEngine() {
+  // Shed queued deadline requests and finish the running ones while the model is loaded
+  deadline_scheduler_.reset();
+
   // Destroy class map
   if (class_map_ && api_loader_.destroyClassMap) {
     api_loader_.destroyClassMap(class_map_);
@@ -30,6 +55,14 @@ bool InferenceEngine::loadLib(const std::string& library_path) {
 }
 
 bool InferenceEngine::create(const std::string& model_path) {
+  return createWith(api_loader_.create, model_path);
+}
+
+bool InferenceEngine::createAutoTuned(const std::string& model_path) {
+  return createWith(api_loader_.createAutoTuned, model_path);
+}
+
+bool InferenceEngine::createWith(void* (*factory)(const char*), const std::string& model_path) {
   if (!api_loader_.isLoaded()) {
     error::printError(error::SdkError::API_NOT_INITIALIZED, "Library not loaded. Call loadLib() first");
     return false;
@@ -46,7 +79,7 @@ bool InferenceEngine::create(const std::string& model_path) {
   }
 
   // Create API instance
-  api_instance_ = api_loader_.create(model_path.c_str());
+  api_instance_ = factory(model_path.c_str());
   if (!api_instance_) {
     error::printError(error::SdkError::API_CREATE_FAILED, model_path);
     return false;
@@ -58,6 +91,103 @@ bool InferenceEngine::create(const std::string& model_path) {
   return true;
 }
 
+bool InferenceEngine::createCascade(const std::vector<CascadeStage>& stages, ConfidenceMode mode) {
+  if (!api_loader_.isLoaded()) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Library not loaded. Call loadLib() first");
+    return false;
+  }
+
+  if (api_instance_) {
+    error::printError(error::SdkError::API_ALREADY_CREATED);
+    return false;
+  }
+
+  if (stages.empty()) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Cascade without stages");
+    return false;
+  }
+
+  std::vector<const char*> paths;
+  std::vector<float> thresholds;
+  for (const auto& stage : stages) {
+    if (stage.model_path.empty()) {
+      error::printError(error::SdkError::EMPTY_PATH, "model_path");
+      return false;
+    }
+    paths.push_back(stage.model_path.c_str());
+    thresholds.push_back(stage.threshold);
+  }
+
+  api_instance_ = api_loader_.createCascade(paths.data(), thresholds.data(), stages.size(),
+                                            static_cast<int>(mode));
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_CREATE_FAILED, stages[0].model_path);
+    return false;
+  }
+
+  LOG(INFO) << "[InferenceEngine] Cascade of " << stages.size()
+            << " models created, first: " << stages[0].model_path;
+  LOG(INFO) << "[InferenceEngine] Input size: " << getInputSize();
+  LOG(INFO) << "[InferenceEngine] Output size: " << getOutputSize();
+  return true;
+}
+
+bool InferenceEngine::runCascade(const float* input, const std::vector<int64_t>& input_shape,
+                                 float* output, size_t* stage) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (!input) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!output) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (input_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return false;
+  }
+
+  if (api_loader_.runCascade(api_instance_, input,
+                             reinterpret_cast<const long long*>(input_shape.data()),
+                             input_shape.size(), output, stage) == 0) {
+    error::printError(error::SdkError::INFERENCE_FAILED, "Cascade inference failed");
+    return false;
+  }
+  return true;
+}
+
+size_t InferenceEngine::getNumStages() const {
+  if (!api_instance_) {
+    return 0;
+  }
+  return api_loader_.getNumStages(api_instance_);
+}
+
+bool InferenceEngine::getCascadeStats(size_t stage, CascadeStageStats& stats) const {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  unsigned long long runs = 0;
+  unsigned long long answered = 0;
+  double mean_ms = 0.0;
+  if (api_loader_.getCascadeStats(api_instance_, stage, &runs, &answered, &mean_ms) == 0) {
+    return false;
+  }
+  stats.runs = runs;
+  stats.answered = answered;
+  stats.mean_ms = mean_ms;
+  return true;
+}
+
 bool InferenceEngine::runInference(const float* input, const std::vector<int64_t>& input_shape,
                                     float* output) {
   if (!api_instance_) {
@@ -95,6 +225,528 @@ bool InferenceEngine::runInference(const float* input, const std::vector<int64_t
   return true;
 }
 
+std::future<bool> InferenceEngine::runInferenceAsync(const float* input,
+                                                     const std::vector<int64_t>& input_shape,
+                                                     float* output) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return readyFuture(false);
+  }
+
+  if (!input) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA);
+    return readyFuture(false);
+  }
+
+  if (!output) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return readyFuture(false);
+  }
+
+  if (input_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return readyFuture(false);
+  }
+
+  // Owned by onInferenceDone once queued; the callback may fire before this call returns
+  auto* promise = new std::promise<bool>();
+  std::future<bool> result = promise->get_future();
+
+  int queued = api_loader_.runInferenceAsync(api_instance_, input,
+                                             reinterpret_cast<const long long*>(input_shape.data()),
+                                             input_shape.size(), output, onInferenceDone, promise);
+  if (queued == 0) {
+    delete promise;
+    error::printError(error::SdkError::INFERENCE_FAILED, "Async inference was not queued");
+    return readyFuture(false);
+  }
+
+  return result;
+}
+
+bool InferenceEngine::enableDeadlineScheduling(size_t max_concurrent) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (max_concurrent == 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "max_concurrent is 0");
+    return false;
+  }
+
+  if (deadline_scheduler_) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Deadline scheduling already enabled");
+    return false;
+  }
+
+  // Steady-state latency from the load-time warmup predicts the first requests
+  double cold_ms = 0.0;
+  double warm_ms = 0.0;
+  if (!getWarmupLatency(cold_ms, warm_ms)) {
+    warm_ms = 0.0;
+  }
+
+  deadline_scheduler_ = std::make_unique<DeadlineScheduler>(
+      [this](const float* input, const std::vector<int64_t>& input_shape, float* output) {
+        return runInference(input, input_shape, output);
+      },
+      max_concurrent, warm_ms);
+
+  LOG(INFO) << "[InferenceEngine] Deadline scheduling enabled (" << max_concurrent
+            << " concurrent, initial estimate " << warm_ms << " ms)";
+  return true;
+}
+
+std::future<DeadlineStatus> InferenceEngine::runWithDeadline(
+    const float* input, const std::vector<int64_t>& input_shape, float* output,
+    std::chrono::steady_clock::time_point deadline) {
+  std::promise<DeadlineStatus> failed;
+  failed.set_value(DeadlineStatus::FAILED);
+
+  if (!deadline_scheduler_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED,
+                      "Call enableDeadlineScheduling() first");
+    return failed.get_future();
+  }
+
+  if (!input) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA);
+    return failed.get_future();
+  }
+
+  if (!output) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return failed.get_future();
+  }
+
+  if (input_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return failed.get_future();
+  }
+
+  return deadline_scheduler_->submit(input, input_shape, output, deadline);
+}
+
+std::unique_ptr<StreamSession> InferenceEngine::createStreamSession(const StreamOptions& options) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return nullptr;
+  }
+
+  return std::make_unique<StreamSession>(
+      [this](const float* input, const std::vector<int64_t>& input_shape, float* output) {
+        return runInference(input, input_shape, output);
+      },
+      [this](const std::vector<int64_t>& input_shape) { return prepareShape(input_shape); },
+      options);
+}
+
+DeadlineStats InferenceEngine::getDeadlineStats() const {
+  return deadline_scheduler_ ? deadline_scheduler_->getStats() : DeadlineStats();
+}
+
+bool InferenceEngine::runBatch(const float* inputs, size_t batch_size,
+                               const std::vector<int64_t>& sample_shape, float* outputs) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (!inputs) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!outputs) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (batch_size == 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Batch size is 0");
+    return false;
+  }
+
+  if (sample_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return false;
+  }
+
+  int result = api_loader_.runBatch(api_instance_, inputs, batch_size,
+                                    reinterpret_cast<const long long*>(sample_shape.data()),
+                                    sample_shape.size(), outputs);
+
+  if (result == 0) {
+    error::printError(error::SdkError::INFERENCE_FAILED, "Batch inference failed");
+    return false;
+  }
+
+  return true;
+}
+
+bool InferenceEngine::runInferenceTyped(const void* input, DataType input_type,
+                                        const std::vector<int64_t>& input_shape, void* output,
+                                        DataType output_type) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (!input) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!output) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (input_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return false;
+  }
+
+  int result = api_loader_.runInferenceTyped(
+      api_instance_, input, static_cast<int>(input_type),
+      reinterpret_cast<const long long*>(input_shape.data()), input_shape.size(), output,
+      static_cast<int>(output_type));
+
+  if (result == 0) {
+    error::printError(error::SdkError::INFERENCE_FAILED, "Typed inference failed");
+    return false;
+  }
+
+  return true;
+}
+
+bool InferenceEngine::bindBuffers(const void* input, DataType input_type,
+                                  const std::vector<int64_t>& input_shape, void* output,
+                                  DataType output_type) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (!input) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!output) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (input_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return false;
+  }
+
+  const long long* shape = reinterpret_cast<const long long*>(input_shape.data());
+  size_t shape_size = input_shape.size();
+  int input_dtype = static_cast<int>(input_type);
+  int output_dtype = static_cast<int>(output_type);
+  int result = api_loader_.bindBuffers(api_instance_, &input, &input_dtype, &shape, &shape_size, 1,
+                                       &output, &output_dtype, 1);
+  if (result == 0) {
+    error::printError(error::SdkError::INFERENCE_FAILED, "Binding buffers failed");
+    return false;
+  }
+
+  LOG(INFO) << "[InferenceEngine] Buffers bound" << (isZeroCopyBound() ? " in place" : " (copying)");
+  return true;
+}
+
+bool InferenceEngine::runBound() {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (api_loader_.runBound(api_instance_) == 0) {
+    error::printError(error::SdkError::INFERENCE_FAILED, "Inference on bound buffers failed");
+    return false;
+  }
+  return true;
+}
+
+void InferenceEngine::unbindBuffers() {
+  if (api_instance_) {
+    api_loader_.unbindBuffers(api_instance_);
+  }
+}
+
+bool InferenceEngine::isZeroCopyBound() const {
+  return api_instance_ && api_loader_.isZeroCopyBound(api_instance_) == 1;
+}
+
+DataType InferenceEngine::getInputDataType() const {
+  if (!api_instance_) {
+    return DataType::FLOAT32;
+  }
+  int dtype = api_loader_.getInputDataType(api_instance_, 0);
+  return dtype < 0 ? DataType::FLOAT32 : static_cast<DataType>(dtype);
+}
+
+bool InferenceEngine::runMulti(const std::vector<const float*>& inputs,
+                               const std::vector<std::vector<int64_t>>& input_shapes,
+                               const std::vector<float*>& outputs) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (inputs.empty() || inputs.size() != input_shapes.size()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "One shape per input required");
+    return false;
+  }
+
+  if (outputs.empty()) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  std::vector<const long long*> shapes;
+  std::vector<size_t> shape_sizes;
+  for (const auto& shape : input_shapes) {
+    if (shape.empty()) {
+      error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+      return false;
+    }
+    shapes.push_back(reinterpret_cast<const long long*>(shape.data()));
+    shape_sizes.push_back(shape.size());
+  }
+
+  int result = api_loader_.runMulti(api_instance_, inputs.data(), shapes.data(),
+                                    shape_sizes.data(), inputs.size(), outputs.data(),
+                                    outputs.size());
+
+  if (result == 0) {
+    error::printError(error::SdkError::INFERENCE_FAILED, "Multi-tensor inference failed");
+    return false;
+  }
+
+  return true;
+}
+
+bool InferenceEngine::enableBatching(size_t max_batch_size, std::chrono::microseconds max_delay) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (max_delay.count() < 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Negative batching delay");
+    return false;
+  }
+
+  // The C API takes the delay as unsigned int microseconds
+  if (max_delay.count() > std::numeric_limits<unsigned int>::max()) {
+    error::printError(error::SdkError::INVALID_PARAMETER,
+                      "Batching delay too long: " + std::to_string(max_delay.count()) + " us");
+    return false;
+  }
+
+  int result = api_loader_.enableBatching(api_instance_, max_batch_size,
+                                          static_cast<unsigned int>(max_delay.count()));
+  if (result == 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Failed to configure batching");
+    return false;
+  }
+
+  LOG(INFO) << "[InferenceEngine] Batching " << (max_batch_size > 1 ? "enabled" : "disabled");
+  return true;
+}
+
+bool InferenceEngine::swapModel(const std::string& model_path,
+                                const std::vector<int64_t>& warmup_shape) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (model_path.empty()) {
+    error::printError(error::SdkError::EMPTY_PATH, "model_path");
+    return false;
+  }
+
+  int result = api_loader_.swapModel(api_instance_, model_path.c_str(),
+                                     reinterpret_cast<const long long*>(warmup_shape.data()),
+                                     warmup_shape.size());
+  if (result == 0) {
+    error::printError(error::SdkError::API_CREATE_FAILED, "Model swap failed: " + model_path);
+    return false;
+  }
+
+  LOG(INFO) << "[InferenceEngine] Now serving model: " << model_path;
+  return true;
+}
+
+bool InferenceEngine::setMaxInstances(size_t max_instances) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (api_loader_.setMaxInstances(api_instance_, max_instances) == 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Failed to set instance limit");
+    return false;
+  }
+  return true;
+}
+
+bool InferenceEngine::setCpuPartition(const std::vector<int>& cpus) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  // COCHL_AFFINITY_EXPLICIT, or COCHL_AFFINITY_NONE to remove the partition
+  int policy = cpus.empty() ? 0 : 3;
+  if (api_loader_.setCpuPartition(api_instance_, policy, cpus.data(), cpus.size()) == 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Failed to set CPU partition");
+    return false;
+  }
+  return true;
+}
+
+bool InferenceEngine::setCpuShare(size_t index, size_t count) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  if (api_loader_.setCpuShare(api_instance_, index, count) == 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Failed to set CPU share");
+    return false;
+  }
+  return true;
+}
+
+std::vector<int> InferenceEngine::getCpuPartition() const {
+  if (!api_instance_) {
+    return {};
+  }
+
+  std::vector<int> cpus(api_loader_.getCpuPartition(api_instance_, nullptr, 0));
+  if (!cpus.empty()) {
+    cpus.resize(api_loader_.getCpuPartition(api_instance_, cpus.data(), cpus.size()));
+  }
+  return cpus;
+}
+
+bool InferenceEngine::setThreadAffinity(AffinityPolicy policy, const std::vector<int>& cpus) {
+  if (!api_loader_.isLoaded()) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Library not loaded. Call loadLib() first");
+    return false;
+  }
+
+  if (api_loader_.setThreadAffinity(static_cast<int>(policy), cpus.data(), cpus.size()) == 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Failed to set thread affinity");
+    return false;
+  }
+  return true;
+}
+
+bool InferenceEngine::setWarmup(size_t max_runs, std::chrono::milliseconds budget) {
+  if (!api_loader_.isLoaded()) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Library not loaded. Call loadLib() first");
+    return false;
+  }
+
+  if (budget.count() < 0) {
+    error::printError(error::SdkError::INVALID_PARAMETER, "Negative warmup budget");
+    return false;
+  }
+
+  api_loader_.setWarmup(max_runs, static_cast<unsigned int>(budget.count()));
+  return true;
+}
+
+bool InferenceEngine::setMemoryBudget(size_t max_bytes) {
+  if (!api_loader_.isLoaded()) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Library not loaded. Call loadLib() first");
+    return false;
+  }
+
+  api_loader_.setMemoryBudget(max_bytes);
+  return true;
+}
+
+bool InferenceEngine::getResidencyStats(ResidencyStats& stats) const {
+  if (!api_loader_.isLoaded()) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Library not loaded. Call loadLib() first");
+    return false;
+  }
+
+  unsigned long long evictions = 0;
+  unsigned long long reloads = 0;
+  if (api_loader_.getResidencyStats(&stats.resident_bytes, &stats.resident_models,
+                                    &stats.evicted_models, &evictions, &reloads) == 0) {
+    return false;
+  }
+  stats.evictions = evictions;
+  stats.reloads = reloads;
+  return true;
+}
+
+bool InferenceEngine::getWarmupLatency(double& cold_ms, double& warm_ms) const {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  return api_loader_.getWarmupLatency(api_instance_, &cold_ms, &warm_ms) != 0;
+}
+
+bool InferenceEngine::setResultCache(size_t max_bytes) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  return api_loader_.setResultCache(api_instance_, max_bytes) != 0;
+}
+
+bool InferenceEngine::getResultCacheStats(ResultCacheStats& stats) const {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return false;
+  }
+
+  unsigned long long hits = 0;
+  unsigned long long misses = 0;
+  size_t bytes = 0;
+  if (api_loader_.getResultCacheStats(api_instance_, &hits, &misses, &bytes) == 0) {
+    return false;
+  }
+  stats.hits = hits;
+  stats.misses = misses;
+  stats.bytes = bytes;
+  return true;
+}
+
+size_t InferenceEngine::prepareShape(const std::vector<int64_t>& input_shape) {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return 0;
+  }
+
+  if (input_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return 0;
+  }
+
+  size_t output_size = api_loader_.prepareShape(
+      api_instance_, reinterpret_cast<const long long*>(input_shape.data()), input_shape.size());
+  if (output_size == 0) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Model cannot take this input shape");
+  }
+  return output_size;
+}
+
 size_t InferenceEngine::getInputSize() const {
   if (!api_instance_) {
     return 0;
@@ -109,13 +761,62 @@ size_t InferenceEngine::getOutputSize() const {
   return api_loader_.getOutputSize(api_instance_);
 }
 
+size_t InferenceEngine::getNumInputs() const {
+  if (!api_instance_) {
+    return 0;
+  }
+  return api_loader_.getNumInputs(api_instance_);
+}
+
+size_t InferenceEngine::getNumOutputs() const {
+  if (!api_instance_) {
+    return 0;
+  }
+  return api_loader_.getNumOutputs(api_instance_);
+}
+
+int InferenceEngine::getInputIndex(const std::string& name) const {
+  if (!api_instance_) {
+    return -1;
+  }
+  return api_loader_.getInputIndex(api_instance_, name.c_str());
+}
+
+int InferenceEngine::getOutputIndex(const std::string& name) const {
+  if (!api_instance_) {
+    return -1;
+  }
+  return api_loader_.getOutputIndex(api_instance_, name.c_str());
+}
+
+size_t InferenceEngine::getOutputSize(size_t index) const {
+  if (!api_instance_) {
+    return 0;
+  }
+  return api_loader_.getOutputSizeAt(api_instance_, index);
+}
+
+TensorLayout InferenceEngine::usePreferredLayout() {
+  if (!api_instance_) {
+    error::printError(error::SdkError::API_NOT_INITIALIZED, "Model not loaded");
+    return input_layout_;
+  }
+
+  int layout = api_loader_.getPreferredLayout(api_instance_);
+  if (api_loader_.setInputLayout(api_instance_, layout) == 1) {
+    input_layout_ = static_cast<TensorLayout>(layout);
+  }
+  return input_layout_;
+}
+
 bool InferenceEngine::loadImage(const std::string& image_path, float* output_data, size_t output_size) {
   if (!api_loader_.isLoaded()) {
     error::printError(error::SdkError::API_NOT_INITIALIZED, "Library not loaded");
     return false;
   }
 
-  int result = api_loader_.loadImage(image_path.c_str(), output_data, output_size);
+  int result = api_loader_.loadImageLayout(image_path.c_str(), static_cast<int>(input_layout_),
+                                           output_data, output_size);
   if (result != 1) {
     error::printError(error::SdkError::IMAGE_LOAD_FAILED, image_path);
     return false;
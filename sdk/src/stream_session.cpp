@@ -0,0 +1,130 @@
+#include "stream_session.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "error/sdk_error.h"
+
+namespace cochl {
+
+StreamSession::StreamSession(RunFunction run, OutputSizeFunction output_size,
+                             const StreamOptions& options)
+    : run_(std::move(run)),
+      output_size_(std::move(output_size)),
+      options_(options),
+      since_refresh_(0) {
+  options_.threshold = std::max(0.0f, options_.threshold);
+}
+
+bool StreamSession::process(const float* input, const std::vector<int64_t>& input_shape,
+                            float* output, bool* skipped) {
+  if (skipped) {
+    *skipped = false;
+  }
+
+  if (!input) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA);
+    return false;
+  }
+
+  if (!output) {
+    error::printError(error::SdkError::INVALID_OUTPUT_DATA);
+    return false;
+  }
+
+  if (input_shape.empty()) {
+    error::printError(error::SdkError::INVALID_INPUT_DATA, "Input shape is empty");
+    return false;
+  }
+
+  ++stats_.frames;
+
+  bool comparable = !result_.empty() && input_shape == reference_shape_;
+  bool within = comparable && withinThreshold(input, reference_.data(), reference_.size(),
+                                              options_.threshold);
+  bool due = options_.refresh_interval > 0 && since_refresh_ + 1 >= options_.refresh_interval;
+
+  if (within && !due) {
+    std::copy(result_.begin(), result_.end(), output);
+    ++since_refresh_;
+    ++stats_.skipped;
+    if (skipped) {
+      *skipped = true;
+    }
+    return true;
+  }
+
+  if (!comparable) {
+    size_t output_size = output_size_(input_shape);
+    if (output_size == 0) {
+      error::printError(error::SdkError::INVALID_INPUT_DATA, "Unsupported input shape");
+      return false;
+    }
+
+    size_t input_size = 1;
+    for (auto dim : input_shape) {
+      input_size *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+    }
+    reference_shape_ = input_shape;
+    reference_.resize(input_size);
+    result_.resize(output_size);
+  }
+
+  if (!run_(input, input_shape, output)) {
+    // Keep comparing against the last good frame, but not with a result of another shape
+    if (!comparable) {
+      result_.clear();
+    }
+    return false;
+  }
+
+  std::copy(input, input + reference_.size(), reference_.begin());
+  std::copy(output, output + result_.size(), result_.begin());
+  since_refresh_ = 0;
+  ++stats_.processed;
+  if (within) {
+    ++stats_.forced;
+  }
+  return true;
+}
+
+void StreamSession::reset() {
+  result_.clear();
+  since_refresh_ = 0;
+}
+
+bool StreamSession::withinThreshold(const float* a, const float* b, size_t size,
+                                    float threshold) {
+  // Independent lanes let the compiler vectorize the sum without reassociating floats;
+  // blocks keep float partial sums exact enough and bound the work past a large change
+  constexpr size_t kLanes = 8;
+  constexpr size_t kBlock = 4096;
+
+  const double limit = static_cast<double>(threshold) * static_cast<double>(size);
+  double total = 0.0;
+  for (size_t begin = 0; begin < size; begin += kBlock) {
+    size_t end = std::min(size, begin + kBlock);
+    float lanes[kLanes] = {};
+    size_t i = begin;
+    for (; i + kLanes <= end; i += kLanes) {
+      for (size_t lane = 0; lane < kLanes; ++lane) {
+        lanes[lane] += std::fabs(a[i + lane] - b[i + lane]);
+      }
+    }
+    for (; i < end; ++i) {
+      lanes[0] += std::fabs(a[i] - b[i]);
+    }
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      total += lanes[lane];
+    }
+
+    // Negated so that NaN inputs count as changed
+    if (!(total <= limit)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace cochl
@@ -0,0 +1,187 @@
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "deadline_scheduler.h"
+
+using cochl::DeadlineScheduler;
+using cochl::DeadlineStats;
+using cochl::DeadlineStatus;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) {
+        std::cout << "  ✓ " << what << std::endl;
+    } else {
+        std::cout << "  ✗ " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Stands in for the model: input[0] is a request id, input[1] how long it runs in ms
+// (negative to fail). Request 0 holds its worker until open() so others can queue behind it.
+class FakeModel {
+public:
+    DeadlineScheduler::RunFunction runFunction() {
+        return [this](const float* input, const std::vector<int64_t>&, float* output) {
+            int id = static_cast<int>(input[0]);
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                order_.push_back(id);
+                if (id == 0) {
+                    started_ = true;
+                    cv_.notify_all();
+                    cv_.wait(lock, [this]() { return open_; });
+                }
+            }
+            if (input[1] < 0) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(input[1]));
+            output[0] = static_cast<float>(id);
+            return true;
+        };
+    }
+
+    void waitStarted() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return started_; });
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+    std::vector<int> order() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool started_ = false;
+    bool open_ = false;
+    std::vector<int> order_;
+};
+
+const std::vector<int64_t> kShape = {1, 2};
+
+DeadlineScheduler::Clock::time_point in(int ms) {
+    return DeadlineScheduler::Clock::now() + std::chrono::milliseconds(ms);
+}
+
+std::future<DeadlineStatus> submit(DeadlineScheduler& scheduler, int id, float run_ms,
+                                   DeadlineScheduler::Clock::time_point deadline, float* output) {
+    const float input[] = {static_cast<float>(id), run_ms};
+    return scheduler.submit(input, kShape, output, deadline);
+}
+
+void testEarliestDeadlineFirst() {
+    std::cout << "\n[Test 1] Earliest deadline first" << std::endl;
+    FakeModel model;
+    DeadlineScheduler scheduler(model.runFunction(), 1, 1.0);
+    std::vector<float> outputs(4);
+
+    auto blocker = submit(scheduler, 0, 0, in(10000), &outputs[0]);
+    model.waitStarted();
+    auto last = submit(scheduler, 1, 0, in(9000), &outputs[1]);
+    auto first = submit(scheduler, 2, 0, in(5000), &outputs[2]);
+    auto second = submit(scheduler, 3, 0, in(7000), &outputs[3]);
+    model.open();
+
+    bool all_on_time = blocker.get() == DeadlineStatus::ON_TIME &&
+                       last.get() == DeadlineStatus::ON_TIME &&
+                       first.get() == DeadlineStatus::ON_TIME &&
+                       second.get() == DeadlineStatus::ON_TIME;
+    check(all_on_time, "Every request finished on time");
+    check(model.order() == std::vector<int>({0, 2, 3, 1}), "Queued requests ran by deadline");
+    check(outputs == std::vector<float>({0, 1, 2, 3}), "Each output was written");
+}
+
+void testShedOnSubmit() {
+    std::cout << "\n[Test 2] Shed on submission" << std::endl;
+    FakeModel model;
+    model.open();
+    DeadlineScheduler scheduler(model.runFunction(), 1, 50.0);
+    float output = -1.0f;
+
+    // 50 ms of predicted service time cannot fit in 10 ms
+    auto shed = submit(scheduler, 1, 0, in(10), &output);
+    check(shed.wait_for(std::chrono::seconds(0)) == std::future_status::ready,
+          "Rejected before queueing");
+    check(shed.get() == DeadlineStatus::SHED, "Status is SHED");
+    check(output == -1.0f, "Output untouched");
+    check(model.order().empty(), "Model never ran");
+
+    DeadlineStats stats = scheduler.getStats();
+    check(stats.submitted == 1 && stats.shed == 1 && stats.queued == 0, "Counted as shed");
+}
+
+void testShedOnStart() {
+    std::cout << "\n[Test 3] Shed on start after more urgent requests" << std::endl;
+    FakeModel model;
+    DeadlineScheduler scheduler(model.runFunction(), 1, 1.0);
+    std::vector<float> outputs(3, -1.0f);
+
+    auto blocker = submit(scheduler, 0, 0, in(10000), &outputs[0]);
+    model.waitStarted();
+    // Admitted while the model looks fast; the more urgent request behind it then takes
+    // 200 ms, which both makes it late and raises the prediction past the first one's deadline
+    auto pushed_back = submit(scheduler, 1, 0, in(150), &outputs[1]);
+    auto urgent = submit(scheduler, 2, 200, in(50), &outputs[2]);
+    model.open();
+
+    check(blocker.get() == DeadlineStatus::ON_TIME, "Running request finished on time");
+    check(urgent.get() == DeadlineStatus::LATE, "Urgent request ran first and finished late");
+    check(pushed_back.get() == DeadlineStatus::SHED, "Pushed back request shed before running");
+    check(model.order() == std::vector<int>({0, 2}), "Shed request never reached the model");
+    check(outputs[1] == -1.0f, "Its output untouched");
+}
+
+void testAccounting() {
+    std::cout << "\n[Test 4] Outcome accounting" << std::endl;
+    FakeModel model;
+    model.open();
+    DeadlineScheduler scheduler(model.runFunction(), 2, 1.0);
+    std::vector<float> outputs(4);
+
+    auto on_time = submit(scheduler, 1, 0, in(10000), &outputs[0]);
+    auto late = submit(scheduler, 2, 100, in(20), &outputs[1]);
+    auto failed = submit(scheduler, 3, -1, in(10000), &outputs[2]);
+    check(on_time.get() == DeadlineStatus::ON_TIME, "ON_TIME before the deadline");
+    check(late.get() == DeadlineStatus::LATE, "LATE past the deadline");
+    check(failed.get() == DeadlineStatus::FAILED, "FAILED when the model fails");
+    auto shed = submit(scheduler, 4, 0, in(-1), &outputs[3]);
+    check(shed.get() == DeadlineStatus::SHED, "SHED past the deadline");
+
+    DeadlineStats stats = scheduler.getStats();
+    check(stats.submitted == 4 && stats.on_time == 1 && stats.late == 1 && stats.failed == 1 &&
+              stats.shed == 1 && stats.queued == 0,
+          "Each outcome counted once");
+    check(stats.predicted_ms >= 100.0, "Prediction follows measured service times");
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== DeadlineScheduler Test ===" << std::endl;
+
+    testEarliestDeadlineFirst();
+    testShedOnSubmit();
+    testShedOnStart();
+    testAccounting();
+
+    std::cout << "\n=== " << (failures ? "Some checks failed" : "All tests passed") << " ==="
+              << std::endl;
+    return failures ? 1 : 0;
+}
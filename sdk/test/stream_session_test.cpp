@@ -0,0 +1,167 @@
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "stream_session.h"
+
+using cochl::StreamOptions;
+using cochl::StreamSession;
+using cochl::StreamStats;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (condition) {
+        std::cout << "  ✓ " << what << std::endl;
+    } else {
+        std::cout << "  ✗ " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Stands in for the model: output[0] is the first input value, output[1] the number of runs
+class FakeModel {
+public:
+    StreamSession::RunFunction runFunction() {
+        return [this](const float* input, const std::vector<int64_t>&, float* output) {
+            ++runs;
+            output[0] = input[0];
+            output[1] = static_cast<float>(runs);
+            return true;
+        };
+    }
+
+    static StreamSession::OutputSizeFunction outputSizeFunction() {
+        return [](const std::vector<int64_t>&) { return size_t(2); };
+    }
+
+    int runs = 0;
+};
+
+const std::vector<int64_t> kShape = {1, 4};
+
+StreamOptions options(float threshold, size_t refresh_interval) {
+    StreamOptions options;
+    options.threshold = threshold;
+    options.refresh_interval = refresh_interval;
+    return options;
+}
+
+void testSkipWithinThreshold() {
+    std::cout << "\n[Test 1] Skip within threshold" << std::endl;
+    FakeModel model;
+    StreamSession session(model.runFunction(), FakeModel::outputSizeFunction(), options(0.1f, 0));
+    std::vector<float> output(2);
+    bool skipped = true;
+
+    std::vector<float> frame(4, 1.0f);
+    check(session.process(frame.data(), kShape, output.data(), &skipped) && !skipped,
+          "First frame runs");
+
+    // Mean absolute difference 0.05
+    std::vector<float> close = {1.2f, 1.0f, 1.0f, 1.0f};
+    output.assign(2, 0.0f);
+    check(session.process(close.data(), kShape, output.data(), &skipped) && skipped,
+          "Frame within the threshold skipped");
+    check(output == std::vector<float>({1.0f, 1.0f}), "Previous result reused");
+
+    // Mean absolute difference 0.5
+    std::vector<float> far(4, 1.5f);
+    check(session.process(far.data(), kShape, output.data(), &skipped) && !skipped,
+          "Frame past the threshold runs");
+    check(output == std::vector<float>({1.5f, 2.0f}), "New result written");
+
+    StreamStats stats = session.getStats();
+    check(stats.frames == 3 && stats.processed == 2 && stats.skipped == 1 && stats.forced == 0,
+          "Counted");
+}
+
+void testForcedRefresh() {
+    std::cout << "\n[Test 2] Forced refresh every refresh_interval" << std::endl;
+    FakeModel model;
+    StreamSession session(model.runFunction(), FakeModel::outputSizeFunction(), options(1.0f, 3));
+    std::vector<float> frame(4, 1.0f);
+    std::vector<float> output(2);
+
+    std::vector<int> ran;
+    for (int i = 0; i < 7; ++i) {
+        bool skipped = true;
+        session.process(frame.data(), kShape, output.data(), &skipped);
+        if (!skipped) {
+            ran.push_back(i);
+        }
+    }
+    check(ran == std::vector<int>({0, 3, 6}), "Identical frames run once every 3");
+    StreamStats stats = session.getStats();
+    check(stats.processed == 3 && stats.skipped == 4 && stats.forced == 2,
+          "Refreshes counted as forced");
+}
+
+void testShapeChange() {
+    std::cout << "\n[Test 3] Shape change forces a run" << std::endl;
+    FakeModel model;
+    StreamSession session(model.runFunction(), FakeModel::outputSizeFunction(), options(1.0f, 0));
+    std::vector<float> frame(4, 1.0f);
+    std::vector<float> output(2);
+    bool skipped = true;
+
+    session.process(frame.data(), kShape, output.data());
+    check(session.process(frame.data(), {2, 2}, output.data(), &skipped) && !skipped,
+          "Same values in another shape run");
+    check(session.process(frame.data(), {2, 2}, output.data(), &skipped) && skipped,
+          "Then compare against the new shape");
+    check(model.runs == 2, "Model ran twice");
+}
+
+void testReset() {
+    std::cout << "\n[Test 4] reset()" << std::endl;
+    FakeModel model;
+    StreamSession session(model.runFunction(), FakeModel::outputSizeFunction(), options(1.0f, 0));
+    std::vector<float> frame(4, 1.0f);
+    std::vector<float> output(2);
+    bool skipped = true;
+
+    session.process(frame.data(), kShape, output.data());
+    session.reset();
+    check(session.process(frame.data(), kShape, output.data(), &skipped) && !skipped,
+          "Identical frame runs after reset");
+    check(output[1] == 2.0f, "Result comes from the new run");
+    check(session.getStats().forced == 0, "Not counted as forced");
+    check(session.process(frame.data(), kShape, output.data(), &skipped) && skipped,
+          "Skipping resumes after it");
+}
+
+void testNaN() {
+    std::cout << "\n[Test 5] NaN treated as changed" << std::endl;
+    FakeModel model;
+    StreamSession session(model.runFunction(), FakeModel::outputSizeFunction(), options(1.0f, 0));
+    std::vector<float> frame(4, 1.0f);
+    std::vector<float> output(2);
+    bool skipped = true;
+
+    session.process(frame.data(), kShape, output.data());
+    frame[2] = std::numeric_limits<float>::quiet_NaN();
+    check(session.process(frame.data(), kShape, output.data(), &skipped) && !skipped,
+          "Frame with a NaN runs");
+    check(session.process(frame.data(), kShape, output.data(), &skipped) && !skipped,
+          "Even against a reference with the same NaN");
+    check(model.runs == 3, "Model ran on every frame");
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== StreamSession Test ===" << std::endl;
+
+    testSkipWithinThreshold();
+    testForcedRefresh();
+    testShapeChange();
+    testReset();
+    testNaN();
+
+    std::cout << "\n=== " << (failures ? "Some checks failed" : "All tests passed") << " ==="
+              << std::endl;
+    return failures ? 1 : 0;
+}
@@ -13,6 +13,57 @@ extern "C" {
  * Provides C interface that can be loaded dynamically by SDK.
  */
 
+/**
+ * @brief Worker thread placement policies (see CochlApi_SetThreadAffinity)
+ */
+typedef enum {
+  COCHL_AFFINITY_NONE = 0,               /**< Leave placement to the OS scheduler */
+  COCHL_AFFINITY_PERFORMANCE_CORES = 1,  /**< Highest-capacity (big) cores only */
+  COCHL_AFFINITY_PHYSICAL_CORES = 2,     /**< One thread per physical core */
+  COCHL_AFFINITY_EXPLICIT = 3            /**< Caller-provided cpu list */
+} CochlAffinityPolicy;
+
+/**
+ * @brief Tensor element types (see CochlApi_RunInferenceTyped)
+ */
+typedef enum {
+  COCHL_DTYPE_FLOAT32 = 0,  /**< 32-bit float */
+  COCHL_DTYPE_FLOAT16 = 1,  /**< IEEE 754 half, passed as uint16_t bits */
+  COCHL_DTYPE_INT8 = 2,     /**< Signed 8-bit, e.g. int8-quantized models */
+  COCHL_DTYPE_UINT8 = 3,    /**< Unsigned 8-bit, e.g. camera pixels */
+  COCHL_DTYPE_INT16 = 4     /**< Signed 16-bit, e.g. PCM samples */
+} CochlDataType;
+
+/**
+ * @brief Memory order of 4D image tensors (see CochlApi_GetPreferredLayout)
+ */
+typedef enum {
+  COCHL_LAYOUT_NCHW = 0,  /**< Channel planes, [N, C, H, W] */
+  COCHL_LAYOUT_NHWC = 1   /**< Interleaved channels, [N, H, W, C] */
+} CochlTensorLayout;
+
+/**
+ * @brief How a cascade stage reads its top-1 confidence (see CochlApi_CreateCascade)
+ */
+typedef enum {
+  COCHL_CONFIDENCE_SOFTMAX = 0,     /**< Logits of exclusive classes */
+  COCHL_CONFIDENCE_SIGMOID = 1,     /**< Logits of independent labels */
+  COCHL_CONFIDENCE_PROBABILITY = 2  /**< Outputs already are probabilities */
+} CochlConfidenceMode;
+
+/**
+ * @brief Alignment in bytes of buffers bound with CochlApi_BindBuffers
+ */
+#define COCHL_TENSOR_ALIGNMENT 64
+
+/**
+ * @brief Completion callback of CochlApi_RunInferenceAsync
+ * @param status 1 if inference succeeded, 0 otherwise
+ * @param user_data Pointer passed to CochlApi_RunInferenceAsync
+ * @note Called on the instance executor thread; keep it short
+ */
+typedef void (*CochlInferenceCallback)(int status, void* user_data);
+
 /**
  * @brief Create CochlApi instance
  * @param model_path Path to model file
@@ -20,11 +71,35 @@ extern "C" {
  */
 void* CochlApi_Create(const char* model_path);
 
+/**
+ * @brief Create CochlApi instance on the fastest backend and thread count for this host
+ * @param model_path Path to model file; exports of the same model for other backends next
+ *                   to it (same name, e.g. model.tflite / model.pt / model.so) are tried too
+ * @return Opaque pointer to CochlApi instance, NULL on failure
+ * @note Benchmarks on first use and caches the decision per host and model content
+ *       under $XDG_CACHE_HOME/cochl (or ~/.cache/cochl)
+ */
+void* CochlApi_CreateAutoTuned(const char* model_path);
+
+/**
+ * @brief Create a cascade of models, cheapest first
+ * @param model_paths Model file of each stage
+ * @param thresholds Top-1 confidence at which each stage answers (the last one is ignored)
+ * @param num_stages Number of stages
+ * @param confidence One of CochlConfidenceMode
+ * @return Opaque pointer to CochlApi instance, NULL on failure
+ * @note Each sample escalates to the next stage only while its confidence stays below the
+ *       threshold. All stages must share input and output sizes. CochlApi_RunInference runs
+ *       the cascade; the other functions address the first stage.
+ */
+void* CochlApi_CreateCascade(const char* const* model_paths, const float* thresholds,
+                             size_t num_stages, int confidence);
+
 /**
  * @brief Run inference
  * @param instance CochlApi instance
- * @param input Input data array (must be in NCHW format)
- * @param input_shape Shape of input tensor in NCHW format (e.g., [1, 3, 224, 224])
+ * @param input Input data array (NCHW unless set otherwise by CochlApi_SetInputLayout)
+ * @param input_shape Shape of input tensor in that layout (e.g., [1, 3, 224, 224])
  * @param shape_size Number of dimensions in input_shape
  * @param output Output data array (must be pre-allocated with CochlApi_GetOutputSize())
  * @return 1 if successful, 0 otherwise
@@ -33,6 +108,269 @@ int CochlApi_RunInference(void* instance, const float* input,
                           const long long* input_shape, size_t shape_size,
                           float* output);
 
+/**
+ * @brief Queue inference on the instance executor and return immediately
+ * @param instance CochlApi instance
+ * @param input Input data array (must be in NCHW format), copied before returning
+ * @param input_shape Shape of input tensor in NCHW format (e.g., [1, 3, 224, 224])
+ * @param shape_size Number of dimensions in input_shape
+ * @param output Output data array, must stay valid until callback is called
+ * @param callback Completion callback
+ * @param user_data Passed through to callback
+ * @return 1 if queued, 0 otherwise (callback is not called)
+ * @note Requests on one instance run in submission order; CochlApi_Destroy waits for pending ones
+ */
+int CochlApi_RunInferenceAsync(void* instance, const float* input,
+                               const long long* input_shape, size_t shape_size,
+                               float* output, CochlInferenceCallback callback, void* user_data);
+
+/**
+ * @brief Run inference on a batch of samples in one backend call
+ * @param instance CochlApi instance
+ * @param inputs Contiguous input data of batch_size samples (each in NCHW format)
+ * @param batch_size Number of samples
+ * @param sample_shape Shape of one sample with a leading batch dimension of 1 (e.g., [1, 3, 224, 224])
+ * @param shape_size Number of dimensions in sample_shape
+ * @param outputs Output data array (must be pre-allocated with batch_size * CochlApi_GetOutputSize())
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_RunBatch(void* instance, const float* inputs, size_t batch_size,
+                      const long long* sample_shape, size_t shape_size, float* outputs);
+
+/**
+ * @brief Run a model with several inputs and/or outputs (e.g. event logits plus embeddings)
+ * @param instance CochlApi instance
+ * @param inputs Data of each input, in model order (see CochlApi_GetInputIndex)
+ * @param input_shapes Shape of each input, all with the same leading batch dimension N
+ * @param shape_sizes Number of dimensions of each input shape
+ * @param num_inputs Number of inputs, must match CochlApi_GetNumInputs()
+ * @param outputs Buffer of each output, in model order; output i must hold
+ *                N * CochlApi_GetOutputSizeAt(instance, i) values
+ * @param num_outputs Number of outputs, must match CochlApi_GetNumOutputs()
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_RunMulti(void* instance, const float* const* inputs,
+                      const long long* const* input_shapes, const size_t* shape_sizes,
+                      size_t num_inputs, float* const* outputs, size_t num_outputs);
+
+/**
+ * @brief Run inference on typed data (e.g. uint8 pixels or int16 PCM)
+ * @param instance CochlApi instance
+ * @param input Input data of input_dtype (images in the CochlApi_SetInputLayout layout)
+ * @param input_dtype One of CochlDataType
+ * @param input_shape Shape of input tensor
+ * @param shape_size Number of dimensions in input_shape
+ * @param output Output buffer of output_dtype (CochlApi_GetOutputSize() elements per sample)
+ * @param output_dtype One of CochlDataType
+ * @return 1 if successful, 0 otherwise
+ * @note Data of the model's own type (CochlApi_GetInputDataType) is passed as-is, so a
+ *       quantized model takes raw uint8/int8 without an fp32 round trip; other types are
+ *       converted by value. Single-input, single-output models only; see CochlApi_RunMultiTyped.
+ */
+int CochlApi_RunInferenceTyped(void* instance, const void* input, int input_dtype,
+                               const long long* input_shape, size_t shape_size,
+                               void* output, int output_dtype);
+
+/**
+ * @brief CochlApi_RunMulti on typed data
+ * @param input_dtypes One CochlDataType per input
+ * @param output_dtypes One CochlDataType per output
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_RunMultiTyped(void* instance, const void* const* inputs, const int* input_dtypes,
+                           const long long* const* input_shapes, const size_t* shape_sizes,
+                           size_t num_inputs, void* const* outputs, const int* output_dtypes,
+                           size_t num_outputs);
+
+/**
+ * @brief Bind caller-owned buffers once as the model's input and output storage
+ * @param inputs/input_dtypes/input_shapes/shape_sizes/num_inputs One entry per model input
+ * @param outputs/output_dtypes/num_outputs One entry per model output
+ * @return 1 if successful, 0 otherwise
+ * @note CochlApi_RunBound then reads the current input contents and writes the outputs.
+ *       Buffers of the model's types (CochlApi_GetInputDataType), images in
+ *       CochlApi_GetPreferredLayout and COCHL_TENSOR_ALIGNMENT-aligned memory are used in
+ *       place (see CochlApi_IsZeroCopyBound); others are copied on each run. Buffers must stay
+ *       valid until CochlApi_UnbindBuffers, the next bind or CochlApi_Destroy.
+ */
+int CochlApi_BindBuffers(void* instance, const void* const* inputs, const int* input_dtypes,
+                         const long long* const* input_shapes, const size_t* shape_sizes,
+                         size_t num_inputs, void* const* outputs, const int* output_dtypes,
+                         size_t num_outputs);
+
+/**
+ * @brief Run inference on the bound buffers
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_RunBound(void* instance);
+
+/**
+ * @brief Release the bound buffers
+ */
+void CochlApi_UnbindBuffers(void* instance);
+
+/**
+ * @brief Whether the backend reads and writes the bound buffers in place
+ * @return 1 if in place, 0 if it copies (or nothing is bound)
+ */
+int CochlApi_IsZeroCopyBound(void* instance);
+
+/**
+ * @brief Run a cascade and report how deep it went
+ * @param stage Receives the deepest stage that ran (0 if the first answered every sample),
+ *              may be NULL
+ * @return 1 if successful, 0 otherwise (or if the instance is not a cascade)
+ */
+int CochlApi_RunCascade(void* instance, const float* input, const long long* input_shape,
+                        size_t shape_size, float* output, size_t* stage);
+
+/**
+ * @brief Number of cascade stages (1 for a single model)
+ */
+size_t CochlApi_GetNumStages(void* instance);
+
+/**
+ * @brief Counters of one cascade stage
+ * @param runs Samples that reached the stage
+ * @param answered Samples the stage answered; answered / runs is its hit rate
+ * @param mean_ms Mean time per sample spent in the stage
+ * @return 1 if successful, 0 if the instance is not a cascade or stage is out of range
+ */
+int CochlApi_GetCascadeStats(void* instance, size_t stage, unsigned long long* runs,
+                             unsigned long long* answered, double* mean_ms);
+
+/**
+ * @brief Element type a model input or output computes with
+ * @return One of CochlDataType, -1 if index is out of range
+ */
+int CochlApi_GetInputDataType(void* instance, size_t index);
+int CochlApi_GetOutputDataType(void* instance, size_t index);
+
+/**
+ * @brief Layout the backend computes images in (NHWC for TFLite, NCHW for LibTorch)
+ * @return One of CochlTensorLayout
+ * @note Preprocess into this layout (CochlApi_LoadImageLayout) and declare it with
+ *       CochlApi_SetInputLayout: images then reach the backend without a transpose
+ */
+int CochlApi_GetPreferredLayout(void* instance);
+
+/**
+ * @brief Layout of the 4D inputs passed to the run functions of this instance
+ * @param layout One of CochlTensorLayout (COCHL_LAYOUT_NCHW by default)
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_SetInputLayout(void* instance, int layout);
+
+/**
+ * @brief Number of model inputs and outputs (1 and 1 for single-tensor models)
+ */
+size_t CochlApi_GetNumInputs(void* instance);
+size_t CochlApi_GetNumOutputs(void* instance);
+
+/**
+ * @brief Index of a named model input or output
+ * @return Index in model order, -1 if the model has no tensor by that name
+ * @note Models without tensor names use input_<i> / output_<i>
+ */
+int CochlApi_GetInputIndex(void* instance, const char* name);
+int CochlApi_GetOutputIndex(void* instance, const char* name);
+
+/**
+ * @brief Name of a model input or output
+ * @param name Buffer receiving the NUL-terminated name (truncated to name_size)
+ * @return Length of the full name, 0 if index is out of range
+ */
+size_t CochlApi_GetInputName(void* instance, size_t index, char* name, size_t name_size);
+size_t CochlApi_GetOutputName(void* instance, size_t index, char* name, size_t name_size);
+
+/**
+ * @brief Per-sample shape of a model input (leading batch dimension of 1)
+ * @param shape Buffer receiving up to max_dims dimensions
+ * @return Number of dimensions of the input, 0 if index is out of range
+ */
+size_t CochlApi_GetInputShapeAt(void* instance, size_t index, long long* shape, size_t max_dims);
+
+/**
+ * @brief Per-sample size of a model output
+ * @return Number of values, 0 if index is out of range
+ */
+size_t CochlApi_GetOutputSizeAt(void* instance, size_t index);
+
+/**
+ * @brief Coalesce concurrent single-sample CochlApi_RunInference calls into batched backend calls
+ * @param instance CochlApi instance
+ * @param max_batch_size Largest batch to run, 0 or 1 to turn batching off
+ * @param max_delay_us Longest time a request waits for others to join its batch, in microseconds
+ * @return 1 if successful, 0 otherwise
+ * @note Callers still block until their own result is ready; only samples with a leading
+ *       batch dimension of 1 and the same shape are batched together
+ */
+int CochlApi_EnableBatching(void* instance, size_t max_batch_size, unsigned int max_delay_us);
+
+/**
+ * @brief Replace the served model without interrupting inference
+ * @param instance CochlApi instance
+ * @param model_path Path to the new model file (any supported format)
+ * @param warmup_shape Input shape for one warmup inference before the swap, NULL to skip
+ * @param shape_size Number of dimensions in warmup_shape
+ * @return 1 if the new model is being served, 0 if the current one was kept
+ * @note Blocks the calling thread while the new model loads; other threads keep running
+ *       inference on the current model. Input and output sizes must not change.
+ */
+int CochlApi_SwapModel(void* instance, const char* model_path,
+                       const long long* warmup_shape, size_t shape_size);
+
+/**
+ * @brief Limit the runtime instances that serve concurrent calls on one instance
+ * @param instance CochlApi instance
+ * @param max_instances Instance limit, 0 to follow the process-wide thread budget
+ * @return 1 if successful, 0 otherwise
+ * @note Instances are cloned on demand and share the loaded model weights;
+ *       ones left idle are released again
+ */
+int CochlApi_SetMaxInstances(void* instance, size_t max_instances);
+
+/**
+ * @brief Return the stored output when an instance is given an input it has seen before
+ * @param instance CochlApi instance
+ * @param max_bytes Memory for the cached inputs and outputs, 0 to turn the cache off
+ * @return 1 if successful, 0 otherwise
+ * @note Keyed by the shape and the exact input bytes (least recently used entries are
+ *       evicted). Only for deterministic models; emptied by CochlApi_SwapModel.
+ */
+int CochlApi_SetResultCache(void* instance, size_t max_bytes);
+
+/**
+ * @brief Counters of the result cache
+ * @param hits Inputs answered from the cache
+ * @param misses Inputs the model ran on; hits / (hits + misses) is the hit rate
+ * @param bytes Memory held now, may be NULL
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_GetResultCacheStats(void* instance, unsigned long long* hits,
+                                 unsigned long long* misses, size_t* bytes);
+
+/**
+ * @brief Get latency measured by the load-time warmup
+ * @param instance CochlApi instance
+ * @param cold_ms First inference after load, in milliseconds
+ * @param warm_ms Steady-state inference, in milliseconds
+ * @return 1 if successful, 0 if the model was loaded with warmup off
+ */
+int CochlApi_GetWarmupLatency(void* instance, double* cold_ms, double* warm_ms);
+
+/**
+ * @brief Prepare an input shape other than the model's default (e.g. a clip of another length)
+ * @param instance CochlApi instance
+ * @param input_shape Shape of the whole input, as passed to CochlApi_RunInference
+ * @param shape_size Number of dimensions in input_shape
+ * @return Number of output values CochlApi_RunInference writes for this shape,
+ *         0 if the model cannot take it
+ * @note Prepared shapes are cached per runtime instance, so switching between shapes
+ *       seen before costs nothing
+ */
+size_t CochlApi_PrepareShape(void* instance, const long long* input_shape, size_t shape_size);
+
 /**
  * @brief Get input size required by model
  * @param instance CochlApi instance
@@ -53,6 +391,87 @@ size_t CochlApi_GetOutputSize(void* instance);
  */
 void CochlApi_Destroy(void* instance);
 
+/**
+ * @brief Set process-wide worker placement for thread pools created afterwards
+ * @param policy One of CochlAffinityPolicy
+ * @param cpus Logical cpu ids (used with COCHL_AFFINITY_EXPLICIT, may be NULL otherwise)
+ * @param num_cpus Number of entries in cpus
+ * @return 1 if successful, 0 otherwise
+ * @note Also resizes the shared compute budget to the number of allowed cpus
+ */
+int CochlApi_SetThreadAffinity(int policy, const int* cpus, size_t num_cpus);
+
+/**
+ * @brief Confine an instance to a partition of the cpus
+ * @param policy One of CochlAffinityPolicy, COCHL_AFFINITY_NONE to remove the partition
+ * @param cpus Logical cpu ids (used with COCHL_AFFINITY_EXPLICIT, may be NULL otherwise)
+ * @param num_cpus Number of entries in cpus
+ * @return 1 if successful, 0 otherwise
+ * @note Calling threads and the backend workers that can be confined per instance (custom
+ *       pool, TFLite) run on the partition only; LibTorch intra-op and TVM workers are
+ *       process-wide and are not confined
+ */
+int CochlApi_SetCpuPartition(void* instance, int policy, const int* cpus, size_t num_cpus);
+
+/**
+ * @brief Confine an instance to one of count disjoint slices of the cpus
+ * @param index Slice of this instance, 0 <= index < count
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_SetCpuShare(void* instance, size_t index, size_t count);
+
+/**
+ * @brief cpus of the instance's partition
+ * @param cpus Receives up to max_cpus cpu ids, may be NULL
+ * @return Number of cpus in the partition, 0 if unconfined
+ */
+size_t CochlApi_GetCpuPartition(void* instance, int* cpus, size_t max_cpus);
+
+/**
+ * @brief Set the process-wide compute thread budget shared by all instances
+ * @param num_threads Number of threads, 0 to use all allowed cpus
+ * @note TFLite interpreters and the LibTorch intra-op pool are sized from this budget at load time
+ */
+void CochlApi_SetThreadBudget(size_t num_threads);
+
+/**
+ * @brief Get the process-wide compute thread budget
+ * @return Number of threads
+ */
+size_t CochlApi_GetThreadBudget(void);
+
+/**
+ * @brief Set the process-wide memory budget of loaded models
+ * @param max_bytes Budget, 0 for unlimited (the default)
+ * @note Models are accounted at their file size, once however many instances share them.
+ *       Above the budget the least recently used models are released; their next call
+ *       reloads them from the file (paying for the load and warmup), so files must stay in place.
+ *       Buffers bound with CochlApi_BindBuffers keep their model loaded.
+ */
+void CochlApi_SetMemoryBudget(size_t max_bytes);
+
+/**
+ * @brief Memory accounting of the loaded models
+ * @param resident_bytes Memory of the models loaded now
+ * @param resident_models Models loaded now
+ * @param evicted_models Models released by the budget, reloaded on their next call
+ * @param evictions Models released since the process started
+ * @param reloads Evicted models loaded again on demand
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_GetResidencyStats(size_t* resident_bytes, size_t* resident_models,
+                               size_t* evicted_models, unsigned long long* evictions,
+                               unsigned long long* reloads);
+
+/**
+ * @brief Configure the warmup run on every model loaded afterwards (process-wide)
+ * @param max_runs Upper bound on warmup inferences, 0 to turn load-time warmup off
+ * @param budget_ms Longest time spent warming one model, in milliseconds
+ * @note Warmup stops early once consecutive runs agree within 10%, so the first
+ *       request does not pay for lazy allocation, weight packing or JIT profiling
+ */
+void CochlApi_SetWarmup(size_t max_runs, unsigned int budget_ms);
+
 /**
  * @brief Load and preprocess image for ResNet50
  * @param image_path Path to image file
@@ -62,6 +481,14 @@ void CochlApi_Destroy(void* instance);
  */
 int CochlApi_LoadImage(const char* image_path, float* output_data, size_t output_size);
 
+/**
+ * @brief CochlApi_LoadImage writing the given layout directly
+ * @param layout One of CochlTensorLayout, usually CochlApi_GetPreferredLayout()
+ * @return 1 if successful, 0 otherwise
+ */
+int CochlApi_LoadImageLayout(const char* image_path, int layout, float* output_data,
+                             size_t output_size);
+
 /**
  * @brief Load ImageNet class names from JSON file
  * @param json_path Path to imagenet_class_index.json
@@ -0,0 +1,139 @@
+// CPU topology discovery for worker thread placement.
+// Reads /sys/devices/system/cpu so heterogeneous (big.LITTLE) cores,
+// SMT siblings and shared caches can be told apart.
+
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Description of a single logical CPU
+ */
+struct CpuCore {
+  int cpu_id;      // logical cpu number (cpuN)
+  int core_id;     // physical core id within the package
+  int package_id;  // physical package (socket) id
+  int cluster_id;  // cluster id (ARM), falls back to package id
+  int capacity;    // relative compute capacity, normalized to 1024 for the fastest core
+  int llc_id;      // lowest cpu id sharing the last-level cache, -1 if unknown
+};
+
+/**
+ * @brief Worker placement policy
+ */
+enum class AffinityPolicy {
+  NONE,               // leave placement to the OS scheduler
+  PERFORMANCE_CORES,  // only cores with the highest capacity (big cores)
+  PHYSICAL_CORES,     // one logical cpu per physical core, fastest cores first
+  EXPLICIT            // caller-provided cpu list
+};
+
+/**
+ * @brief Placement request for a set of worker threads
+ */
+struct ThreadAffinity {
+  AffinityPolicy policy = AffinityPolicy::NONE;
+  std::vector<int> cpus;  // used with AffinityPolicy::EXPLICIT
+};
+
+/**
+ * @brief Snapshot of the host CPU topology
+ */
+class CpuTopology {
+ public:
+  /**
+   * @brief Topology of the running host, detected once and cached
+   */
+  static const CpuTopology& get();
+
+  /**
+   * @brief Detect topology from a sysfs cpu directory
+   * @param sysfs_root Root directory (e.g., "/sys/devices/system/cpu")
+   * @return Detected topology; a flat topology of hardware_concurrency cpus if sysfs is missing
+   */
+  static CpuTopology detect(const std::string& sysfs_root = "/sys/devices/system/cpu");
+
+  const std::vector<CpuCore>& cores() const { return cores_; }
+
+  /**
+   * @brief true if cores report different capacities (big.LITTLE / DynamIQ)
+   */
+  bool isHeterogeneous() const;
+
+  /**
+   * @brief Logical cpus of the highest capacity class
+   */
+  std::vector<int> performanceCpus() const;
+
+  /**
+   * @brief One logical cpu per physical core, ordered by capacity (descending)
+   */
+  std::vector<int> physicalCoreCpus() const;
+
+  /**
+   * @brief Resolve a placement request into an ordered cpu list
+   * @param affinity Placement request
+   * @return cpus to pin workers to (round-robin), empty for AffinityPolicy::NONE or for an
+   *         EXPLICIT list without online cpus (logged as a warning; threads then stay unpinned)
+   */
+  std::vector<int> resolve(const ThreadAffinity& affinity) const;
+
+  /**
+   * @brief One of count disjoint slices of the cpus, for models sharing the host
+   * @param index Slice to return, 0 <= index < count
+   * @return cpus of the slice; SMT siblings and clusters stay in one slice where the core
+   *         count allows, slices share cpus only if there are fewer cpus than slices
+   */
+  std::vector<int> partition(size_t index, size_t count) const;
+
+  /**
+   * @brief Pin a thread to a single logical cpu
+   * @return true if successful, false if unsupported or rejected by the kernel
+   */
+  static bool pinThread(std::thread& thread, int cpu_id);
+
+ private:
+  std::vector<CpuCore> cores_;
+};
+
+/**
+ * @brief Confines the calling thread to a set of cpus for its lifetime
+ *
+ * Threads the calling thread creates meanwhile inherit the set, which is how
+ * backend-owned pools (TFLite) created during a confined call stay inside it.
+ * The previous set is restored on destruction.
+ */
+class ScopedAffinity {
+ public:
+  /**
+   * @param cpus cpus to run on, empty to leave the thread as it is
+   */
+  explicit ScopedAffinity(const std::vector<int>& cpus);
+  ~ScopedAffinity();
+
+  /**
+   * @brief true if the thread was confined (false for an empty set or if unsupported)
+   */
+  bool isApplied() const { return applied_; }
+
+  ScopedAffinity(const ScopedAffinity&) = delete;
+  ScopedAffinity& operator=(const ScopedAffinity&) = delete;
+
+ private:
+  bool applied_;
+  std::vector<int> previous_;
+};
+
+/**
+ * @brief Process-wide default placement used by thread pools created without an explicit one
+ */
+void setDefaultThreadAffinity(const ThreadAffinity& affinity);
+ThreadAffinity getDefaultThreadAffinity();
+
+}  // namespace runtime
+}  // namespace cochl_api
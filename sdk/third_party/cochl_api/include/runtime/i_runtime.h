@@ -3,13 +3,26 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "tensor_types.h"
+
 namespace cochl_api {
 namespace runtime {
 
-// Forward declaration
-enum class TensorLayout;
+/**
+ * @brief Name and per-sample shape of one model input or output
+ */
+struct TensorInfo {
+  std::string name;            // name in the model, or input_<i>/output_<i> if it has none
+  std::vector<int64_t> shape;  // leading batch dimension of 1
+  size_t size = 0;             // values per sample
+  DataType dtype = DataType::FLOAT32;  // element type the model computes with
+  float scale = 0.0f;                  // quantization scale, 0 if not quantized
+  int32_t zero_point = 0;              // quantization zero point
+};
 
 /**
  * @brief Base interface for all runtime backends
@@ -35,6 +48,152 @@ public:
   virtual bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                             float* output) = 0;
 
+  /**
+   * @brief Run inference on a batch of samples in a single backend call
+   * @param inputs Contiguous input data of batch_size samples (each laid out as in runInference)
+   * @param batch_size Number of samples
+   * @param sample_shape Shape of one sample with a leading batch dimension of 1
+   *                     (e.g., {1, 3, 224, 224} for NCHW)
+   * @param outputs Output data array (must be pre-allocated with batch_size * getOutputSize())
+   * @return true if successful, false otherwise
+   */
+  virtual bool runBatch(const float* inputs, size_t batch_size,
+                        const std::vector<int64_t>& sample_shape, float* outputs) = 0;
+
+  /**
+   * @brief Run inference on a model with several inputs and/or outputs
+   * @param inputs Data of each input, in the order of getInputInfo()
+   * @param input_shapes Shape of each input, with the same leading batch dimension N
+   * @param outputs Buffer of each output, in the order of getOutputInfo(); output i must hold
+   *                N * getOutputInfo()[i].size values
+   * @return true if successful, false otherwise
+   * @note Backends without multi-tensor support run single-input, single-output models
+   */
+  virtual bool runMulti(const std::vector<const float*>& inputs,
+                        const std::vector<std::vector<int64_t>>& input_shapes,
+                        const std::vector<float*>& outputs) {
+    if (inputs.size() != 1 || input_shapes.size() != 1 || outputs.size() != 1) {
+      return false;
+    }
+    return runInference(inputs[0], input_shapes[0], outputs[0]);
+  }
+
+  /**
+   * @brief Run inference on typed inputs and outputs (e.g. uint8 pixels, int16 PCM)
+   * @param inputs One per model input, in the order of getInputInfo()
+   * @param outputs One per model output, in the order of getOutputInfo(); output i must hold
+   *                N * getOutputInfo()[i].size elements of its dtype
+   * @return true if successful, false otherwise
+   * @note Data whose dtype matches the model tensor is passed as-is (already quantized with
+   *       the model's parameters); other dtypes are converted by value. 4D inputs may come in
+   *       either layout; handing them over in getInputLayout() saves a transpose. This default
+   *       widens everything to float, transposes 4D inputs to getInputLayout() and goes
+   *       through runMulti(); backends with typed tensors override it to skip the conversion.
+   */
+  virtual bool runTyped(const std::vector<InputTensor>& inputs,
+                        const std::vector<OutputTensor>& outputs);
+
+  /**
+   * @brief Bind caller-owned buffers as the storage of the model inputs and outputs
+   * @param inputs One per model input, in the order of getInputInfo(); 4D inputs in
+   *               getInputLayout(), all of the model's own dtype
+   * @param outputs One per model output; output i must hold N * getOutputInfo()[i].size
+   *                elements of its dtype
+   * @return false if the backend cannot use these buffers in place (callers then copy
+   *         through runTyped())
+   * @note Buffers must be aligned to kTensorAlignment and stay valid until unbindBuffers()
+   *       or the next bindBuffers(). setNumThreads() may drop the binding.
+   */
+  virtual bool bindBuffers(const std::vector<InputTensor>& inputs,
+                           const std::vector<OutputTensor>& outputs) {
+    (void)inputs;
+    (void)outputs;
+    return false;
+  }
+
+  /**
+   * @brief Run on the bound buffers: reads their current contents and writes the outputs
+   * @return false if nothing is bound or inference fails
+   */
+  virtual bool runBound() { return false; }
+
+  /**
+   * @brief Release the bound buffers
+   */
+  virtual void unbindBuffers() {}
+
+  /**
+   * @brief Create another instance sharing this one's loaded model
+   * @return New instance with its own execution state, nullptr if the backend cannot share
+   * @note Only reads state fixed by loadModel(), so it may run while this instance is in use
+   */
+  virtual std::unique_ptr<IRuntime> clone() const { return nullptr; }
+
+  /**
+   * @brief Set the number of threads this instance computes with
+   * @param num_threads Thread count, 0 to return to the default share of the ComputePool budget
+   * @return false if the backend does not support changing it
+   * @note Not safe while this instance is running inference
+   */
+  virtual bool setNumThreads(size_t num_threads) {
+    (void)num_threads;
+    return false;
+  }
+
+  /**
+   * @brief Confine the compute threads of this instance (and its clones) to a set of cpus
+   * @param cpus Logical cpus, empty to return to the process-wide ComputePool
+   * @return false if the backend's threads are process-wide and cannot be confined per instance
+   * @note Not safe while this instance is running inference
+   */
+  virtual bool setCpuSet(const std::vector<int>& cpus) {
+    (void)cpus;
+    return false;
+  }
+
+  /**
+   * @brief Prepare execution for an input shape and report the output it produces
+   * @param input_shape Shape of the whole input, as passed to runInference()
+   * @return Number of output values runInference() writes for this shape, 0 if unsupported
+   * @note Backends with dynamic shapes keep a plan per shape, so a prepared shape costs
+   *       nothing to reuse
+   */
+  virtual size_t prepareShape(const std::vector<int64_t>& input_shape) {
+    if (input_shape.empty() || input_shape[0] <= 0) {
+      return 0;
+    }
+    return getOutputSize() * static_cast<size_t>(input_shape[0]);
+  }
+
+  /**
+   * @brief Input shape of one sample as passed to runInference()
+   * @return Shape with a leading batch dimension of 1, empty if the backend cannot tell
+   */
+  virtual std::vector<int64_t> getInputShape() const { return {}; }
+
+  /**
+   * @brief Layout the backend computes 4D inputs in
+   * @note Preprocessing that writes this layout directly (see CochlApi::loadImage()) and
+   *       passes it to runTyped() saves the transpose of every input
+   */
+  virtual TensorLayout getInputLayout() const { return TensorLayout::NCHW; }
+
+  /**
+   * @brief Inputs of the model, in the order runMulti() takes them
+   * @note The first input is the one runInference() feeds
+   */
+  virtual std::vector<TensorInfo> getInputInfo() const {
+    return {{"input_0", getInputShape(), getInputSize()}};
+  }
+
+  /**
+   * @brief Outputs of the model, in the order runMulti() writes them
+   * @note The first output is the one runInference() returns
+   */
+  virtual std::vector<TensorInfo> getOutputInfo() const {
+    return {{"output_0", {1, static_cast<int64_t>(getOutputSize())}, getOutputSize()}};
+  }
+
   /**
    * @brief Get runtime type name
    * @note  use later
@@ -0,0 +1,147 @@
+// Elastic pool of runtime instances for one loaded model.
+// Instances are cloned from a copy of the loaded one that is never leased,
+// and share its immutable model state; callers lease an instance for the
+// duration of one call.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "i_runtime.h"
+#include "warmup.h"
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief Per-model pool of IRuntime instances for concurrent callers
+ *
+ * Grows by cloning when every instance is leased (up to the instance limit)
+ * and shrinks again by dropping instances that stayed idle longer than the
+ * idle timeout. Backends that cannot clone run with a single instance, and
+ * concurrent callers queue for it. Model metadata is snapshotted at load, so
+ * reading it never touches an instance another caller is running.
+ */
+class RuntimeInstancePool {
+ public:
+  /**
+   * @brief Exclusive use of one instance, returned to the pool on destruction
+   */
+  class Lease {
+   public:
+    Lease(Lease&& other) noexcept;
+    Lease& operator=(Lease&&) = delete;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    ~Lease();
+
+    IRuntime* operator->() const { return runtime_.get(); }
+    IRuntime& operator*() const { return *runtime_; }
+
+   private:
+    friend class RuntimeInstancePool;
+    Lease(RuntimeInstancePool* pool, std::unique_ptr<IRuntime> runtime);
+
+    RuntimeInstancePool* pool_;
+    std::unique_ptr<IRuntime> runtime_;
+  };
+
+  /**
+   * @param primary Loaded runtime; the first instance leased, cloned once more as the clone source
+   * @param max_instances Instance limit, 0 to use the ComputePool thread budget
+   */
+  explicit RuntimeInstancePool(std::unique_ptr<IRuntime> primary, size_t max_instances = 0);
+
+  /**
+   * @brief Lease an idle instance, cloning a new one or waiting if none is free
+   */
+  Lease acquire();
+
+  /**
+   * @brief Change the instance limit
+   * @param max_instances Instance limit, 0 to use the ComputePool thread budget
+   * @note Idle instances above the new limit are dropped immediately, leased ones on return
+   */
+  void setMaxInstances(size_t max_instances);
+  size_t getMaxInstances() const;
+
+  /**
+   * @brief Idle time after which an instance is dropped, down to one
+   */
+  void setIdleTimeout(std::chrono::milliseconds idle_timeout);
+
+  /**
+   * @brief Number of live instances (idle and leased)
+   */
+  size_t getNumInstances() const;
+
+  /**
+   * @brief New instance outside the pool, e.g. bound to caller buffers
+   * @return nullptr if the backend cannot clone
+   * @note Safe while instances are leased: the clone source never is
+   */
+  std::unique_ptr<IRuntime> clone() const;
+
+  // Model metadata, snapshotted at load time
+  const char* getRuntimeType() const { return runtime_type_.c_str(); }
+  size_t getInputSize() const { return input_size_; }
+  size_t getOutputSize() const { return output_size_; }
+  TensorLayout getInputLayout() const { return input_layout_; }
+  const std::vector<TensorInfo>& getInputInfo() const { return input_info_; }
+  const std::vector<TensorInfo>& getOutputInfo() const { return output_info_; }
+
+  /**
+   * @brief Warmup of the primary instance at load time
+   * @note Set by the loader before the pool is shared
+   */
+  void setWarmupStats(const WarmupStats& stats) { warmup_stats_ = stats; }
+  const WarmupStats& getWarmupStats() const { return warmup_stats_; }
+
+  RuntimeInstancePool(const RuntimeInstancePool&) = delete;
+  RuntimeInstancePool& operator=(const RuntimeInstancePool&) = delete;
+
+ private:
+  struct IdleInstance {
+    std::unique_ptr<IRuntime> runtime;
+    std::chrono::steady_clock::time_point since;
+  };
+
+  void release(std::unique_ptr<IRuntime> runtime);
+
+  /**
+   * @brief Move instances past the idle timeout or above the limit out of idle_ (caller holds mutex_)
+   * @return Instances to destroy after the lock is released
+   */
+  std::vector<std::unique_ptr<IRuntime>> trimLocked(std::chrono::steady_clock::time_point now);
+
+  const std::string runtime_type_;
+  const size_t input_size_;
+  const size_t output_size_;
+  const TensorLayout input_layout_;
+  const std::vector<TensorInfo> input_info_;
+  const std::vector<TensorInfo> output_info_;
+
+  // Never leased, so cloning it cannot race a call; null if the backend cannot clone
+  std::unique_ptr<const IRuntime> source_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable available_;
+
+  // Most recently returned instance last, so the warmest one is leased first
+  std::vector<IdleInstance> idle_;
+  size_t num_instances_;
+  size_t max_instances_;
+  bool cloneable_;
+  std::chrono::milliseconds idle_timeout_;
+
+  WarmupStats warmup_stats_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -1,10 +1,20 @@
 #ifndef RUNTIME_MANAGER_H
 #define RUNTIME_MANAGER_H
 
+#include "auto_tuner.h"
+#include "cpu_topology.h"
 #include "i_runtime.h"
+#include "instance_pool.h"
+#include "model_residency.h"
+#include "result_cache.h"
+#include "tensor_binding.h"
+#include "warmup.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace cochl_api {
 namespace runtime {
@@ -30,9 +40,26 @@ public:
    * @brief Create runtime manager and load model
    * @param model_path Path to model file
    * @return Unique pointer to RuntimeManager, nullptr on failure
+   * @note A file that is already loaded in the process with the same backend and thread count
+   *       is shared, not loaded again. Above the ModelResidency budget the model may be released
+   *       while idle; the next call then reloads it from model_path, so the file must stay in
+   *       place.
    */
   static std::unique_ptr<RuntimeManager> create(const std::string& model_path);
 
+  /**
+   * @brief Create runtime manager on the fastest backend and thread count for this host
+   * @param model_path Path to model file; the same model exported for other compiled
+   *                   backends next to it (same name, e.g. model.tflite / model.pt / model.so)
+   *                   is benchmarked as well
+   * @param options Benchmark settings
+   * @return Unique pointer to RuntimeManager, nullptr on failure
+   * @note The decision is cached per host and model content, so only the first call
+   *       on a host pays for benchmarking. Falls back to create() if nothing can be benchmarked.
+   */
+  static std::unique_ptr<RuntimeManager> createAutoTuned(
+      const std::string& model_path, const TuningOptions& options = TuningOptions());
+
   ~RuntimeManager();
 
   /**
@@ -40,15 +67,145 @@ public:
    * @param input Input data array (must be in NCHW format)
    * @param input_shape Shape of input tensor (e.g., {1, 3, 224, 224} for NCHW)
    * @param output Output data array (must be pre-allocated with getOutputSize())
+   * @note With the result cache on, an input seen before returns the stored output
    */
   bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                     float* output) const;
 
+  /**
+   * @brief Run inference on a batch of samples in one backend call
+   * @param inputs Contiguous input data of batch_size samples
+   * @param batch_size Number of samples
+   * @param sample_shape Shape of one sample with a leading batch dimension of 1
+   * @param outputs Output data array (must be pre-allocated with batch_size * getOutputSize())
+   */
+  bool runBatch(const float* inputs, size_t batch_size, const std::vector<int64_t>& sample_shape,
+                float* outputs) const;
+
+  /**
+   * @brief Run inference on a model with several inputs and/or outputs
+   * @param inputs Data of each input, in the order of getInputInfo()
+   * @param input_shapes Shape of each input, with the same leading batch dimension N
+   * @param outputs Buffer of each output, in the order of getOutputInfo(); output i must hold
+   *                N * getOutputInfo()[i].size values
+   */
+  bool runMulti(const std::vector<const float*>& inputs,
+                const std::vector<std::vector<int64_t>>& input_shapes,
+                const std::vector<float*>& outputs) const;
+
+  /**
+   * @brief Run inference on typed inputs and outputs (e.g. uint8 pixels, int16 PCM)
+   * @param inputs One per model input, in the order of getInputInfo()
+   * @param outputs One per model output; output i must hold N * getOutputInfo()[i].size elements
+   */
+  bool runTyped(const std::vector<InputTensor>& inputs,
+                const std::vector<OutputTensor>& outputs) const;
+
+  /**
+   * @brief Bind caller-owned buffers as the model's input and output storage
+   * @param inputs One per model input, in the order of getInputInfo()
+   * @param outputs One per model output; output i must hold N * getOutputInfo()[i].size elements
+   * @return Binding to run, nullptr if nothing is loaded
+   * @note The binding follows swapModel() and evictions, binding the buffers again on its
+   *       next run; it fails to run once the manager is destroyed
+   */
+  std::shared_ptr<TensorBinding> bindBuffers(const std::vector<InputTensor>& inputs,
+                                             const std::vector<OutputTensor>& outputs) const;
+
+  /**
+   * @brief Replace the served model without interrupting inference
+   * @param model_path Path to the new model file (any supported format)
+   * @param warmup_shape Input shape for a warmup inference before the swap, empty to skip
+   * @return true if the new model is being served, false if the current one was kept
+   * @note The new model must have the same inputs and outputs, with the same sizes. Calls already running
+   *       finish on the old model, which is released once the last of them returns.
+   */
+  bool swapModel(const std::string& model_path, const std::vector<int64_t>& warmup_shape);
+
+  /**
+   * @brief Limit the number of runtime instances serving concurrent calls
+   * @param max_instances Instance limit, 0 to follow the ComputePool thread budget
+   * @note Applies to every manager sharing this model through the ModelRegistry
+   */
+  void setMaxInstances(size_t max_instances);
+
+  /**
+   * @brief Current instance limit, the ComputePool thread budget if none was set
+   */
+  size_t getMaxInstances() const;
+
+  /**
+   * @brief Number of live runtime instances
+   */
+  size_t getNumInstances() const;
+
+  /**
+   * @brief Confine this manager's inference to a partition of the cpus
+   * @param affinity cpus to run on (EXPLICIT cpus, CpuTopology::partition() for a share, or a
+   *                 policy such as PERFORMANCE_CORES); AffinityPolicy::NONE removes the partition
+   * @return false if nothing is loaded or the affinity resolves to no online cpu
+   * @note Calls run confined to the partition: the calling thread while it computes, and the
+   *       backend workers where the backend can confine them per instance (custom pool,
+   *       TFLite). LibTorch intra-op and TVM workers are process-wide and are not confined.
+   *       Other managers of the same model keep running unconfined.
+   */
+  bool setCpuPartition(const ThreadAffinity& affinity);
+
+  /**
+   * @brief cpus of the partition, empty if unconfined
+   */
+  std::vector<int> getCpuPartition() const;
+
+  /**
+   * @brief Cache the results of runInference() by input content
+   * @param max_bytes Memory for the cached inputs and outputs, 0 turns the cache off
+   * @note Only for deterministic models: a repeated input returns the first output.
+   *       Emptied by swapModel(); runBatch(), runMulti() and runTyped() are not cached.
+   */
+  void setResultCache(size_t max_bytes);
+
+  /**
+   * @brief Hits, misses and memory of the result cache, zeros if it is off
+   */
+  ResultCacheStats getResultCacheStats() const;
+
+  /**
+   * @brief Warmup run on models loaded from now on (process-wide)
+   * @param options Stop conditions, max_runs = 0 turns load-time warmup off
+   */
+  static void setWarmupOptions(const WarmupOptions& options);
+  static WarmupOptions getWarmupOptions();
+
+  /**
+   * @brief Cold and warm latency measured when the served model was loaded
+   */
+  WarmupStats getWarmupStats() const;
+
   /**
    * @brief Get inference engine type
    */
   InferenceEngine getInferenceEngineType() const { return runtime_type_; }
 
+  /**
+   * @brief Prepare an input shape other than the default one
+   * @param input_shape Shape of the whole input, as passed to runInference()
+   * @return Number of output values runInference() writes for this shape, 0 if unsupported
+   * @note Backends keep a plan per shape on each instance; instances other than the one
+   *       prepared here build theirs on first use
+   */
+  size_t prepareShape(const std::vector<int64_t>& input_shape) const;
+
+  /**
+   * @brief Names and per-sample shapes of the model inputs and outputs
+   */
+  std::vector<TensorInfo> getInputInfo() const;
+  std::vector<TensorInfo> getOutputInfo() const;
+
+  /**
+   * @brief Layout the backend computes 4D inputs in (see IRuntime::getInputLayout())
+   */
+  TensorLayout getInputLayout() const;
+
   /**
    * @brief Get input size
    */
@@ -69,17 +226,116 @@ private:
    */
   static InferenceEngine detectInferenceEngine(const std::string& model_path);
 
+  /**
+   * @brief Load model_path with the given backend, sharing it if it is already loaded with the
+   *        same backend and thread count
+   * @param num_threads Thread count for the runtime, 0 for the backend default
+   */
+  static std::unique_ptr<RuntimeManager> createWithEngine(const std::string& model_path,
+                                                          InferenceEngine type,
+                                                          size_t num_threads);
+
+  /**
+   * @brief Compiled backends able to run model_path or a sibling export of it
+   * @param types Backend of each returned candidate
+   */
+  static std::vector<AutoTuner::Candidate> tuningCandidates(const std::string& model_path,
+                                                            std::vector<InferenceEngine>& types);
+
+  /**
+   * @brief Instantiate the backend for type (built in, or from its plugin library)
+   * @return New runtime, nullptr if the backend is unavailable
+   */
+  static std::unique_ptr<IRuntime> newRuntime(InferenceEngine type);
+
   /**
    * @brief Load model using appropriate runtime
    * @param model_path Path to model file
    * @param type Runtime type to use
-   * @return true if successful, false otherwise
+   * @param num_threads Thread count for the runtime, 0 for the backend default
+   * @return Instance pool holding the loaded runtime, nullptr on failure
+   */
+  static std::shared_ptr<RuntimeInstancePool> loadModel(const std::string& model_path,
+                                                        InferenceEngine type,
+                                                        size_t num_threads = 0);
+
+  /**
+   * @brief Instances confined to the cpus of a partition
+   */
+  struct Partition {
+    std::vector<int> cpus;
+    std::shared_ptr<RuntimeInstancePool> source;     // shared model they were cloned from
+    std::shared_ptr<RuntimeInstancePool> instances;  // null if the backend cannot confine them
+  };
+
+  /**
+   * @brief Clone source into instances confined to cpus
    */
-  bool loadModel(const std::string& model_path, InferenceEngine type);
+  static std::shared_ptr<const Partition> makePartition(
+      const std::vector<int>& cpus, std::shared_ptr<RuntimeInstancePool> source);
 
-  std::unique_ptr<IRuntime> runtime_;  //runtime instance
-  InferenceEngine runtime_type_;
+  /**
+   * @brief Snapshot of the served model; keeps it alive while the caller uses it
+   * @note The partition's own instances while they belong to the served model
+   */
+  std::shared_ptr<RuntimeInstancePool> currentInstances() const;
+
+  /**
+   * @brief Shared instances of the served model, reloaded if they were evicted
+   * @note Marks the model used for ModelResidency
+   */
+  std::shared_ptr<RuntimeInstancePool> residentInstances() const;
+
+  /**
+   * @brief Load the served model again after ModelResidency evicted it
+   * @return nullptr if the file can no longer be loaded
+   */
+  std::shared_ptr<RuntimeInstancePool> reload() const;
+
+  /**
+   * @brief Account the served model to ModelResidency, replacing the previous registration
+   * @param key ModelRegistry key of the model
+   */
+  void admitResidency(const std::string& key, const std::string& model_path) const;
+
+  /**
+   * @brief Release the served model (ModelResidency evictor); the next call reloads it
+   */
+  void evict() const;
+
+  /**
+   * @brief cpus a call confines the calling thread to, empty if unconfined
+   */
+  std::vector<int> partitionCpus() const;
+
+  /**
+   * @brief Make live bindings drop their instance of the model served until now
+   */
+  void invalidateBindings() const;
+
+  // Leased per call by concurrent callers; shared with other managers of the same model file.
+  // Accessed only through std::atomic_load/atomic_store so swapModel() can replace it live.
+  // Null while evicted; reloaded by the next call.
+  mutable std::shared_ptr<RuntimeInstancePool> instances_;
+  // Set by setCpuPartition(); same access rules as instances_. Keeps only the cpus while evicted.
+  mutable std::shared_ptr<const Partition> partition_;
+  // Set by setResultCache(); same access rules as instances_
+  std::shared_ptr<ResultCache> result_cache_;
+  std::atomic<InferenceEngine> runtime_type_;
   bool initialized_;
+
+  // What reload() loads; guarded by load_mutex_, which also serializes reloads
+  mutable std::mutex load_mutex_;
+  std::string model_path_;
+  size_t num_threads_;
+
+  // Bindings made by bindBuffers(), told when the served model changes
+  mutable std::mutex bindings_mutex_;
+  mutable std::vector<std::weak_ptr<TensorBinding>> bindings_;
+
+  // Registration with ModelResidency; same access rules as instances_. Declared last so it is
+  // removed (and can no longer evict) before the rest of the manager is destroyed.
+  mutable std::shared_ptr<ModelResidency::Ticket> residency_;
 };
 
 }  // namespace runtime
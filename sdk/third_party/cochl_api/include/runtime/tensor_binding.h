@@ -0,0 +1,99 @@
+// Caller-owned buffers bound once as a model's input and output storage.
+// Steady-state inference on a binding reads and writes those buffers in place
+// where the backend allows it, instead of copying at the API boundary.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "i_runtime.h"
+#include "instance_pool.h"
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief A set of bound buffers with the runtime instance that serves them
+ *
+ * Holds a dedicated clone of the model's runtime, so the binding neither
+ * occupies a pooled instance nor is disturbed by other callers. Backends
+ * that cannot bind the buffers (or cannot clone) fall back to a copying
+ * runTyped() on a pooled instance, with the same results.
+ *
+ * The binding follows the model its source serves: when the model is swapped
+ * or evicted it drops its clone (see invalidate()), and the next run binds the
+ * buffers again on the model served then.
+ */
+class TensorBinding {
+ public:
+  /**
+   * @brief Where the binding finds the model to run
+   */
+  struct Source {
+    // Pool of the model served now (reloaded if evicted), nullptr if there is none
+    std::function<std::shared_ptr<RuntimeInstancePool>()> instances;
+    // cpus the bound instance is created on, empty for any
+    std::function<std::vector<int>()> cpus;
+  };
+
+  /**
+   * @param source Model to run; must stay callable until detach()
+   * @param inputs One per model input (see IRuntime::bindBuffers())
+   * @param outputs One per model output
+   */
+  TensorBinding(Source source, std::vector<InputTensor> inputs, std::vector<OutputTensor> outputs);
+
+  /**
+   * @brief Run on the current contents of the bound buffers
+   * @return false on failure, or if the source is gone
+   */
+  bool run();
+
+  /**
+   * @brief true if the backend reads the buffers in place
+   */
+  bool isZeroCopy() const { return std::atomic_load(&runtime_) != nullptr; }
+
+  /**
+   * @brief Release the bound instance because the model changed; the next run binds again
+   * @note Never blocks: a run in flight finishes on the old instance
+   */
+  void invalidate();
+
+  /**
+   * @brief Release the bound instance for good: the source is going away
+   */
+  void detach();
+
+  TensorBinding(const TensorBinding&) = delete;
+  TensorBinding& operator=(const TensorBinding&) = delete;
+
+ private:
+  /**
+   * @brief Bind the buffers on a clone of the primary of instances (caller holds mutex_)
+   */
+  void bind(const std::shared_ptr<RuntimeInstancePool>& instances);
+
+  std::shared_ptr<const Source> source_;  // null once detached; std::atomic_load/atomic_store
+  std::vector<InputTensor> inputs_;
+  std::vector<OutputTensor> outputs_;
+
+  // Clone holding the binding, null when running through the copying fallback or after
+  // invalidate(); std::atomic_load/atomic_store
+  std::shared_ptr<IRuntime> runtime_;
+
+  // Pool bound on (guarded by mutex_); a weak reference so the binding does not keep a
+  // swapped or evicted model loaded
+  std::weak_ptr<RuntimeInstancePool> bound_instances_;
+  std::atomic<bool> stale_;
+
+  // The buffers are one set: concurrent runs would overwrite each other's outputs
+  std::mutex mutex_;
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
@@ -2,6 +2,7 @@
 #define TORCH_RUNTIME_H
 
 #include "i_runtime.h"
+#include "plan_cache.h"
 
 #ifdef USE_LIBTORCH
 #include <memory>
@@ -24,21 +25,94 @@ public:
   bool loadModel(const char* model_path) override;
   bool runInference(const float* input, const std::vector<int64_t>& input_shape,
                     float* output) override;
+  bool runBatch(const float* inputs, size_t batch_size,
+                const std::vector<int64_t>& sample_shape, float* outputs) override;
+  bool runMulti(const std::vector<const float*>& inputs,
+                const std::vector<std::vector<int64_t>>& input_shapes,
+                const std::vector<float*>& outputs) override;
+
+  /**
+   * @brief Convert typed inputs into the model's float tensors with ATen (no host-side copy)
+   *        and outputs to the requested type
+   */
+  bool runTyped(const std::vector<InputTensor>& inputs,
+                const std::vector<OutputTensor>& outputs) override;
+
+  /**
+   * @brief Wrap the input buffers as tensors without cloning them (NHWC images as a permuted
+   *        view); runBound() writes outputs straight into the output buffers
+   * @note TorchScript allocates its own results, so each output is still copied once
+   */
+  bool bindBuffers(const std::vector<InputTensor>& inputs,
+                   const std::vector<OutputTensor>& outputs) override;
+  bool runBound() override;
+  void unbindBuffers() override;
+  std::unique_ptr<IRuntime> clone() const override;
   const char* getRuntimeType() const override { return "LibTorch"; }
   size_t getInputSize() const override;
   size_t getOutputSize() const override;
+  std::vector<int64_t> getInputShape() const override;
+  std::vector<TensorInfo> getInputInfo() const override { return input_info_; }
+  std::vector<TensorInfo> getOutputInfo() const override { return output_info_; }
+
+  /**
+   * @brief Allocate the input tensor for input_shape and learn its output size with one forward()
+   */
+  size_t prepareShape(const std::vector<int64_t>& input_shape) override;
+
+  /**
+   * @brief Only 0 (the ComputePool share) is accepted
+   * @return false for any explicit count: the LibTorch intra-op pool is process-wide, so a
+   *         count tuned for one instance would apply to all
+   */
+  bool setNumThreads(size_t num_threads) override;
 
 private:
-  std::unique_ptr<torch::jit::Module> module_;
+  // Shared by clones: forward() on a TorchScript module in eval mode does not mutate it
+  std::shared_ptr<torch::jit::Module> module_;
   bool initialized_;
 
-  // Cached shape information
-  std::vector<int64_t> input_shape_;
+  // Default shapes and names of every input and output (forward() accepts any shape the
+  // model does); outputs are a tensor, a tuple or list of tensors, or a dict of named tensors
+  std::vector<TensorInfo> input_info_;
+  std::vector<TensorInfo> output_info_;
+
+  // Cached sizes of the first input and output (per sample, default shape)
   size_t input_size_;
   size_t output_size_;
 
-  // Helper to infer shapes from model
+  /**
+   * @brief Preallocated input tensors and known output sizes for one set of input shapes
+   */
+  struct Plan {
+    std::vector<torch::Tensor> inputs;
+    std::vector<size_t> output_sizes;  // values of each output for the whole input, empty until
+                                       // the first forward()
+  };
+  PlanCache<Plan> plans_;
+
+  /**
+   * @brief Tensors over the caller buffers of bindBuffers()
+   */
+  struct Binding {
+    std::vector<torch::Tensor> inputs;   // views of the input buffers
+    std::vector<torch::Tensor> outputs;  // flat views of the output buffers
+  };
+  std::unique_ptr<Binding> bound_;
+
+  // Helper to infer the default shapes from the model
   bool inferShapes();
+
+  // Cached plan for input_shapes, allocating its input tensors on first use
+  Plan& getPlan(const std::vector<std::vector<int64_t>>& input_shapes);
+
+  // Shared path of runInference/runBatch/runTyped: NCHW inputs with a leading batch dimension
+  // outputs receive the first outputs.size() model outputs
+  bool forward(const std::vector<InputTensor>& inputs, const std::vector<OutputTensor>& outputs);
+
+  // Size LibTorch intra-op threads from their share of the process-wide ComputePool budget,
+  // following rebalances; called before every forward()
+  static void configureThreads();
 };
 
 }  // namespace runtime
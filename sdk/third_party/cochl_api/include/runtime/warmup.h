@@ -0,0 +1,50 @@
+// Load-time warmup of a runtime instance.
+// Runs synthetic inputs until latency stops changing, so lazy allocation,
+// weight packing and JIT profiling happen before the first real request.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "i_runtime.h"
+
+namespace cochl_api {
+namespace runtime {
+
+/**
+ * @brief When to consider a runtime warm
+ */
+struct WarmupOptions {
+  size_t max_runs = 30;                    // upper bound on warmup inferences, 0 turns warmup off
+  size_t window = 3;                       // consecutive runs that must agree
+  double tolerance = 0.1;                  // allowed spread within the window, relative to its median
+  std::chrono::milliseconds budget{2000};  // stop after this long even if latency is still moving
+};
+
+/**
+ * @brief Outcome of a warmup
+ */
+struct WarmupStats {
+  size_t runs = 0;       // inferences executed, 0 if warmup was off or not possible
+  double cold_ms = 0.0;  // latency of the first inference
+  double warm_ms = 0.0;  // median latency of the final window
+  bool steady = false;   // latency settled within tolerance before max_runs/budget ran out
+};
+
+/**
+ * @brief Drives a runtime to steady-state latency on synthetic input
+ */
+class Warmup {
+ public:
+  /**
+   * @brief Run inferences on inputs of the runtime.getInputInfo() shapes until latency is steady
+   * @param runtime Loaded runtime, used exclusively for the duration of the call
+   * @param options Stop conditions
+   * @return Cold and warm latency; runs is 0 if the backend does not report its input shapes
+   */
+  static WarmupStats run(IRuntime& runtime, const WarmupOptions& options);
+};
+
+}  // namespace runtime
+}  // namespace cochl_api
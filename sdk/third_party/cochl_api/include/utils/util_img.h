@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "runtime/tensor_types.h"
 #include "stb_image.h"
 
 namespace cochl_api {
@@ -22,11 +23,16 @@ constexpr float IMAGENET_STD[3] = {0.229f, 0.224f, 0.225f};
  * - Loads image using stb_image (supports PNG, JPG, BMP, etc.)
  * - Resizes to 224x224 using simple bilinear interpolation
  * - Normalizes with ImageNet mean and std
+ * - Writes the requested layout directly, so the backend's own layout
+ *   (CochlApi::getPreferredLayout) needs no transpose afterwards
  *
  * @param image_path Path to the image file
+ * @param layout NHWC (interleaved, [224, 224, 3]) or NCHW (planar, [3, 224, 224])
  * @return Preprocessed image as float vector (224*224*3), empty if failed
  */
-inline std::vector<float> LoadAndPreprocessImage(const std::string& image_path) {
+inline std::vector<float> LoadAndPreprocessImage(
+    const std::string& image_path,
+    runtime::TensorLayout layout = runtime::TensorLayout::NHWC) {
   int width, height, channels;
   unsigned char* img = stbi_load(image_path.c_str(), &width, &height, &channels, 3);
 
@@ -39,34 +45,31 @@ inline std::vector<float> LoadAndPreprocessImage(const std::string& image_path)
   std::cout << "[ImageLoader] Loaded image: " << image_path
             << " [" << width << "x" << height << "x3]" << std::endl;
 
-  // Resize to 224x224 (simple nearest neighbor)
+  // Resize to 224x224 (simple nearest neighbor), normalize and lay out in one pass
   const int target_size = 224;
-  std::vector<float> resized(target_size * target_size * 3);
+  const int plane = target_size * target_size;
+  const bool planar = layout == runtime::TensorLayout::NCHW;
+  std::vector<float> resized(plane * 3);
 
   for (int y = 0; y < target_size; ++y) {
     for (int x = 0; x < target_size; ++x) {
       int src_x = std::min(x * width / target_size, width - 1);
       int src_y = std::min(y * height / target_size, height - 1);
+      int pixel = y * target_size + x;
 
       for (int c = 0; c < 3; ++c) {
         int src_idx = (src_y * width + src_x) * 3 + c;
-        int dst_idx = (y * target_size + x) * 3 + c;
-        resized[dst_idx] = static_cast<float>(img[src_idx]) / 255.0f;
+        int dst_idx = planar ? c * plane + pixel : pixel * 3 + c;
+        float value = static_cast<float>(img[src_idx]) / 255.0f;
+        resized[dst_idx] = (value - IMAGENET_MEAN[c]) / IMAGENET_STD[c];
       }
     }
   }
 
   stbi_image_free(img);
 
-  // Apply ImageNet normalization
-  for (int i = 0; i < target_size * target_size; ++i) {
-    for (int c = 0; c < 3; ++c) {
-      int idx = i * 3 + c;
-      resized[idx] = (resized[idx] - IMAGENET_MEAN[c]) / IMAGENET_STD[c];
-    }
-  }
-
-  std::cout << "[ImageLoader] Preprocessed to 224x224 with ImageNet normalization" << std::endl;
+  std::cout << "[ImageLoader] Preprocessed to 224x224 with ImageNet normalization ("
+            << runtime::tensorLayoutName(layout) << ")" << std::endl;
   return resized;
 }
 